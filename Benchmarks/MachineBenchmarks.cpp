@@ -0,0 +1,147 @@
+/**
+ * @file MachineBenchmarks.cpp
+ * @author Frederick Fan
+ *
+ * Benchmarks for the machine library
+ */
+
+#include "pch.h"
+#include <benchmark/benchmark.h>
+
+#include <Machine.h>
+#include <Machine1Factory.h>
+#include <Machine2Factory.h>
+#include <Polygon.h>
+#include <DisplayList.h>
+#include <SoftwareRenderer.h>
+
+/// Frame rate the machines are updated at
+const double FrameRate = 30;
+
+/// Number of frames to run each machine
+const int MachineFrames = 300;
+
+/**
+ * Create a machine by number
+ * @param number Machine number 1 or 2
+ * @return Machine object
+ */
+static std::shared_ptr<Machine> CreateMachine(int number)
+{
+    if (number == 2)
+    {
+        Machine2Factory factory(L".");
+        return factory.Create();
+    }
+
+    Machine1Factory factory(L".");
+    return factory.Create();
+}
+
+/**
+ * Machine::Update for the first MachineFrames frames of a machine.
+ * The machine is reset outside of the timing for each run.
+ * @param state Benchmark state, range(0) is the machine number
+ */
+static void BM_MachineUpdate(benchmark::State& state)
+{
+    auto machine = CreateMachine((int)state.range(0));
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        machine->Reset();
+        state.ResumeTiming();
+
+        for (int frame = 0; frame < MachineFrames; frame++)
+        {
+            machine->Update(1.0 / FrameRate);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * MachineFrames);
+}
+BENCHMARK(BM_MachineUpdate)->Arg(1)->Arg(2)->Unit(benchmark::kMillisecond);
+
+/**
+ * cse335::Polygon::DrawPolygon for a polygon filled with a color
+ * @param state Benchmark state
+ */
+static void BM_PolygonDrawColor(benchmark::State& state)
+{
+    wxBitmap bitmap(1000, 1000);
+    wxMemoryDC dc(bitmap);
+    auto graphics = std::shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create(dc));
+
+    cse335::Polygon polygon;
+    polygon.Rectangle(-50, 0, 100, 20);
+    polygon.SetColor(*wxRED);
+
+    double rotation = 0;
+    for (auto _ : state)
+    {
+        polygon.DrawPolygon(graphics, 500, 500, rotation);
+        rotation += 0.01;
+    }
+}
+BENCHMARK(BM_PolygonDrawColor);
+
+/**
+ * cse335::Polygon::DrawPolygon for a polygon filled with an image
+ * @param state Benchmark state
+ */
+static void BM_PolygonDrawImage(benchmark::State& state)
+{
+    wxBitmap bitmap(1000, 1000);
+    wxMemoryDC dc(bitmap);
+    auto graphics = std::shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create(dc));
+
+    cse335::Polygon polygon;
+    polygon.BottomCenteredRectangle(75, 50);
+    polygon.SetImage(L"./images/hamster-cage.png");
+
+    double rotation = 0;
+    for (auto _ : state)
+    {
+        polygon.DrawPolygon(graphics, 500, 500, rotation);
+        rotation += 0.01;
+    }
+}
+BENCHMARK(BM_PolygonDrawImage);
+
+/**
+ * Recording a frame of a machine into a display list and drawing it
+ * with the software renderer at 1280x720, with no GUI involved.
+ * @param state Benchmark state, range(0) is the machine number
+ */
+static void BM_MachineRenderSoftware(benchmark::State& state)
+{
+    auto machine = CreateMachine((int)state.range(0));
+    machine->Reset();
+    for (int frame = 0; frame < MachineFrames; frame++)
+    {
+        machine->Update(1.0 / FrameRate);
+    }
+
+    auto list = std::make_shared<DisplayList>();
+    SoftwareRenderer renderer(1280, 720);
+
+    // Machine coordinates are centimeters with Y up
+    DisplayList::Matrix transform;
+    transform.a = 1.5;
+    transform.d = -1.5;
+    transform.tx = 640;
+    transform.ty = 650;
+    renderer.SetTransform(transform);
+
+    for (auto _ : state)
+    {
+        list->Clear();
+        machine->Record(list);
+        renderer.Clear(*wxWHITE);
+        renderer.Render(*list);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MachineRenderSoftware)->Arg(1)->Arg(2)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,97 @@
+/**
+ * @file PictureBenchmarks.cpp
+ * @author Frederick Fan
+ *
+ * Benchmarks for the animation library
+ */
+
+#include "pch.h"
+#include <benchmark/benchmark.h>
+
+#include <Picture.h>
+#include <PictureFactory.h>
+#include <Timeline.h>
+#include <AnimChannelAngle.h>
+
+/// Number of keyframes in each generated channel
+const int ChannelKeyframes = 10;
+
+/// Frames between keyframes in generated channels
+const int KeyframeSpacing = 30;
+
+/**
+ * Picture::Draw on the Harold and Sparty scene
+ * @param state Benchmark state
+ */
+static void BM_PictureDraw(benchmark::State& state)
+{
+    PictureFactory factory;
+    auto picture = factory.Create(L".");
+    picture->SetAnimationTime(0);
+
+    wxBitmap bitmap(1500, 800);
+    wxMemoryDC dc(bitmap);
+    auto graphics = std::shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create(dc));
+
+    for (auto _ : state)
+    {
+        picture->Draw(graphics);
+    }
+}
+BENCHMARK(BM_PictureDraw)->Unit(benchmark::kMillisecond);
+
+/**
+ * Timeline::SetCurrentTime with many keyframed channels,
+ * stepping forward a frame at a time like playback
+ * @param state Benchmark state, range(0) is the number of channels
+ */
+static void BM_TimelineSetCurrentTime(benchmark::State& state)
+{
+    Timeline timeline;
+    timeline.SetNumFrames(ChannelKeyframes * KeyframeSpacing);
+
+    std::vector<std::unique_ptr<AnimChannelAngle>> channels;
+    for (int i = 0; i < state.range(0); i++)
+    {
+        auto channel = std::make_unique<AnimChannelAngle>();
+        channel->SetName(L"channel" + std::to_wstring(i));
+        timeline.AddChannel(channel.get());
+        channels.push_back(std::move(channel));
+    }
+
+    for (int k = 0; k < ChannelKeyframes; k++)
+    {
+        timeline.SetCurrentTime((double)(k * KeyframeSpacing) / timeline.GetFrameRate());
+        for (auto &channel : channels)
+        {
+            channel->SetKeyframe(k * 0.1);
+        }
+    }
+
+    int frame = 0;
+    for (auto _ : state)
+    {
+        timeline.SetCurrentTime((double)frame / timeline.GetFrameRate());
+        frame = (frame + 1) % timeline.GetNumFrames();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TimelineSetCurrentTime)->Arg(1000)->Arg(5000);
+
+/**
+ * Picture::Load of FinalMov.anim
+ * @param state Benchmark state
+ */
+static void BM_PictureLoad(benchmark::State& state)
+{
+    PictureFactory factory;
+    auto picture = factory.Create(L".");
+    wxString filename = wxString(CANADIANEXPERIENCE_SOURCE_DIR) + L"/FinalMov.anim";
+
+    for (auto _ : state)
+    {
+        picture->Load(filename);
+    }
+}
+BENCHMARK(BM_PictureLoad)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,35 @@
+/**
+ * @file benchmark_main.cpp
+ * @author Frederick Fan
+ *
+ * Main entry point for the benchmarks
+ */
+
+#include "pch.h"
+#include <benchmark/benchmark.h>
+#include <wx/filefn.h>
+
+/**
+ * Main entry point for the benchmarks.
+ *
+ * Like the tests, this runs from the build directory so
+ * the resources copied there can be found.
+ * @param argc Number of arguments
+ * @param argv Arguments
+ * @return 0 if successful
+ */
+int main(int argc, char** argv)
+{
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+
+    wxSetWorkingDirectory(L"..");
+    wxInitAllImageHandlers();
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
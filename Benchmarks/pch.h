@@ -0,0 +1,20 @@
+/**
+ * @file pch.h
+ * @author Frederick Fan
+ */
+
+#ifndef BENCHMARKS_PCH_H
+#define BENCHMARKS_PCH_H
+
+#include <wx/wxprec.h>
+#ifndef WX_PRECOMP
+#include <wx/wx.h>
+#endif
+
+#include <wx/xml/xml.h>
+#include <wx/graphics.h>
+
+// Must match MachineLib/pch.h
+#define POLYGON_DEFAULT_INVERTEDY
+
+#endif //BENCHMARKS_PCH_H
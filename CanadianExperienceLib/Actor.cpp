@@ -29,6 +29,7 @@ Actor::Actor(const std::wstring &name) : mName(name)
 void Actor::SetRoot(std::shared_ptr<Drawable> root)
 {
    mRoot = root;
+   mTreeChanged = true;
 }
 
 /**
@@ -44,8 +45,7 @@ void Actor::Draw(std::shared_ptr<wxGraphicsContext> graphics)
     // This takes care of determining the absolute placement
     // of all of the child drawables. We have to determine this
     // in tree order, which may not be the order we draw.
-    if (mRoot != nullptr)
-        mRoot->Place(mPosition, 0);
+    Place();
 
     for (auto drawable : mDrawablesInOrder)
     {
@@ -54,6 +54,84 @@ void Actor::Draw(std::shared_ptr<wxGraphicsContext> graphics)
 }
 
 
+/**
+ * Determine the placement of the drawables in the drawing.
+ *
+ * Each drawable keeps its placement from the last time it was placed.
+ * Only drawables that have moved since then, and the drawables under
+ * them, are placed again, so an actor that is standing still costs
+ * one pass over a flag for each drawable.
+ */
+void Actor::Place()
+{
+    if (mRoot == nullptr)
+    {
+        return;
+    }
+
+    if (mTreeChanged)
+    {
+        BuildTree();
+    }
+
+    bool moved = mTreeChanged || !(mPosition == mPlacedPosition);
+    mTreeChanged = false;
+    mPlacedPosition = mPosition;
+
+    for (size_t i = 0; i < mTree.size(); i++)
+    {
+        auto drawable = mTree[i];
+        int parent = mTreeParents[i];
+
+        // A drawable is placed if it moved or its parent was placed
+        bool place = drawable->IsDirty() || (parent < 0 ? moved : mTreePlaced[parent] != 0);
+        mTreePlaced[i] = place;
+        if (place)
+        {
+            if (parent < 0)
+            {
+                drawable->PlaceAt(mPosition, 0, 1, 0);
+            }
+            else
+            {
+                drawable->PlaceUnder(*mTree[parent]);
+            }
+
+            if (mPicture != nullptr)
+            {
+                mPicture->DrawableMoved(drawable);
+            }
+        }
+    }
+}
+
+
+/**
+ * Build the tree order arrays from the drawables under the root
+ */
+void Actor::BuildTree()
+{
+    mTree.clear();
+    mTreeParents.clear();
+
+    mTree.push_back(mRoot.get());
+    mTreeParents.push_back(-1);
+
+    // Each drawable is visited after its parent, so
+    // its children are added after it
+    for (size_t i = 0; i < mTree.size(); i++)
+    {
+        for (auto &child : mTree[i]->GetChildren())
+        {
+            mTree.push_back(child.get());
+            mTreeParents.push_back((int)i);
+        }
+    }
+
+    mTreePlaced.assign(mTree.size(), 0);
+}
+
+
 /**
 * Test to see if a mouse click is on this actor.
 * @param pos Mouse position on drawing
@@ -86,6 +164,11 @@ void Actor::AddDrawable(std::shared_ptr<Drawable> drawable)
 {
     mDrawablesInOrder.push_back(drawable);
     drawable->SetActor(this);
+
+    if (mPicture != nullptr)
+    {
+        mPicture->DrawableAdded(this, drawable);
+    }
 }
 
 
@@ -141,4 +224,25 @@ void Actor::GetKeyframe()
     {
         drawable->GetKeyframe();
     }
-}
\ No newline at end of file
+}
+
+/**
+ * Copy the pose of another actor with the same drawables.
+ *
+ * The actor position and the position and rotation of each
+ * drawable are copied. Drawables are matched by their order.
+ * @param other Actor to copy the pose of
+ */
+void Actor::CopyPose(const Actor &other)
+{
+    mPosition = other.mPosition;
+    mEnabled = other.mEnabled;
+
+    for (size_t i = 0; i < mDrawablesInOrder.size() && i < other.mDrawablesInOrder.size(); i++)
+    {
+        auto &drawable = mDrawablesInOrder[i];
+        auto &source = other.mDrawablesInOrder[i];
+        drawable->SetPosition(source->GetPosition());
+        drawable->SetRotation(source->GetRotation());
+    }
+}
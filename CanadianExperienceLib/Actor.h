@@ -45,6 +45,23 @@ private:
     /// The actor position channel
     AnimChannelPoint mChannel;
 
+    /// The drawables under the root in tree order, each after its parent
+    std::vector<Drawable *> mTree;
+
+    /// The index in mTree of the parent of each drawable, -1 for the root
+    std::vector<int> mTreeParents;
+
+    /// Whether each drawable in mTree was placed in the last call to Place
+    std::vector<char> mTreePlaced;
+
+    /// Does mTree need to be built again?
+    bool mTreeChanged = true;
+
+    /// The actor position the root was last placed at
+    wxPoint mPlacedPosition;
+
+    void BuildTree();
+
 public:
     virtual ~Actor() {}
 
@@ -60,6 +77,13 @@ public:
 
     void SetRoot(std::shared_ptr<Drawable> root);
     void Draw(std::shared_ptr<wxGraphicsContext> graphics);
+    void Place();
+
+    /**
+     * Get the drawables in drawing order
+     * @return Drawables, the last one drawn on top
+     */
+    const std::vector<std::shared_ptr<Drawable>> &GetDrawables() const { return mDrawablesInOrder; }
     std::shared_ptr<Drawable> HitTest(wxPoint pos);
     void AddDrawable(std::shared_ptr<Drawable> drawable);
 
@@ -108,6 +132,12 @@ public:
 
     void SetPicture(Picture *picture);
 
+    /**
+     * Indicate a drawable has been added to the tree under the
+     * root, so the tree order has to be found again
+     */
+    void TreeChanged() { mTreeChanged = true; }
+
     /**
      * Get the picture this actor is for
      * @return The picture object
@@ -117,6 +147,8 @@ public:
     void SetKeyframe();
     void GetKeyframe();
 
+    void CopyPose(const Actor &other);
+
     /**
      * The position animation channel
      * @return Pointer to animation channel
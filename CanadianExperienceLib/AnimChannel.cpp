@@ -8,16 +8,23 @@
 
 #include "Timeline.h"
 
+#include <algorithm>
+
 
 /**
- * Determine how we should insert a keyframe into our keyframe list.
- * @param keyframe The keyframe to insert
+ * Determine how we should insert a keyframe for the
+ * current frame into our keyframe list.
+ *
+ * The derived class then puts the keyframe value at the
+ * returned index of its own array.
+ * @param added Set true if a keyframe was added at the index,
+ * false if the keyframe at the index is replaced
+ * @return Index of the keyframe for the current frame
  */
-void AnimChannel::InsertKeyframe(std::shared_ptr<Keyframe> keyframe)
+int AnimChannel::InsertKeyframe(bool &added)
 {
-    // Get the current frame and tell it to the keyframe we are setting.
+    // Get the current frame, which is the frame of the keyframe we are setting.
     int currFrame = mTimeline->GetCurrentFrame();
-    keyframe->SetFrame(currFrame);
 
     // The possible options for keyframe insertion
     enum class Action { Append, Replace, Insert } action;
@@ -34,7 +41,7 @@ void AnimChannel::InsertKeyframe(std::shared_ptr<Keyframe> keyframe)
     {
         // We know mKeyframe1 is valid
         // So, we are after it.
-        int frame1 = mKeyframes[mKeyframe1]->GetFrame();
+        int frame1 = mFrames[mKeyframe1];
 
         if (mKeyframe2 < 0)
         {
@@ -59,26 +66,100 @@ void AnimChannel::InsertKeyframe(std::shared_ptr<Keyframe> keyframe)
     {
     case Action::Append:
         // Add to end and the keyframe to the left becomes the new keyframe
-        mKeyframes.push_back(keyframe);
-        mKeyframe1 = (int)mKeyframes.size() - 1;
+        mFrames.push_back(currFrame);
+        mKeyframe1 = (int)mFrames.size() - 1;
+        added = true;
         break;
 
     case Action::Replace:
         // Replace the current keyframe
-        mKeyframes[mKeyframe1] = keyframe;
+        added = false;
         break;
 
     case Action::Insert:
         // Insert after mKeyframe1
         // and mKeyframe1 becomes this new insertion (frame we are on)
-        mKeyframes.insert(mKeyframes.begin() + (mKeyframe1 + 1), keyframe);
+        mFrames.insert(mFrames.begin() + (mKeyframe1 + 1), currFrame);
         mKeyframe1++;
+        added = true;
         break;
     }
 
+    return mKeyframe1;
 }
 
 
+/**
+ * Insert a keyframe at a given frame, independent of the current time.
+ *
+ * This is the path for loading. Keyframes that arrive in frame order
+ * are appended, so loading a channel is linear in its keyframes. The
+ * current keyframe indices are reset, and the next Locate finds them.
+ * @param frame Frame number of the keyframe
+ * @param added Set true if a keyframe was added at the index,
+ * false if the keyframe at the index is replaced
+ * @return Index of the keyframe for the frame
+ */
+int AnimChannel::InsertKeyframe(int frame, bool &added)
+{
+    int index;
+    if (mFrames.empty() || mFrames.back() < frame)
+    {
+        // In order, so append
+        index = (int)mFrames.size();
+        mFrames.push_back(frame);
+        added = true;
+    }
+    else
+    {
+        auto loc = std::lower_bound(mFrames.begin(), mFrames.end(), frame);
+        index = (int)(loc - mFrames.begin());
+        added = *loc != frame;
+        if (added)
+        {
+            mFrames.insert(loc, frame);
+        }
+    }
+
+    // Before all of the keyframes, until we are located again
+    mKeyframe1 = -1;
+    mKeyframe2 = 0;
+    mFrom = -1;
+    mTo = -1;
+
+    return index;
+}
+
+
+/**
+ * Replace all of the keyframe frame numbers at once.
+ *
+ * The derived class replaces the values to match. The current
+ * keyframe indices are reset, and the next Locate finds them.
+ * @param frames Frame numbers of the keyframes, in increasing order
+ */
+void AnimChannel::SetKeyframeFrames(std::vector<int> frames)
+{
+    mFrames = std::move(frames);
+
+    mKeyframe1 = -1;
+    mKeyframe2 = mFrames.empty() ? -1 : 0;
+    mFrom = -1;
+    mTo = -1;
+}
+
+
+/**
+ * Ensure the keyframe indices are valid for the current time
+ * and compute the channel value.
+ * @param currFrame The frame we are on.
+ */
+void AnimChannel::SetFrame(int currFrame)
+{
+    Locate(currFrame);
+    Evaluate();
+}
+
 /**
  * Ensure the keyframe indices are valid for the current time.
  *
@@ -88,21 +169,33 @@ void AnimChannel::InsertKeyframe(std::shared_ptr<Keyframe> keyframe)
  * time. Note that the time may be before or after the first or last
  * item in the list.  We indicate that with values of -1 for the
  * indices.
+ *
+ * This also sets the keyframes and T value to tween with, but does
+ * not compute the value. The timeline locates every channel and then
+ * evaluates all of the channels of each type together.
  * @param currFrame The frame we are on.
  */
-void AnimChannel::SetFrame(int currFrame)
+void AnimChannel::Locate(int currFrame)
 {
+    // Playback moves at most one keyframe per frame, which the
+    // loops below handle in a step. Anything further away is a
+    // random seek, so binary search for the keyframes instead.
+    if (!IsNearFrame(currFrame))
+    {
+        Seek(currFrame);
+    }
+
     // Should we move forward in time?
-    while (mKeyframe2 >= 0 && mKeyframes[mKeyframe2]->GetFrame() <= currFrame)
+    while (mKeyframe2 >= 0 && mFrames[mKeyframe2] <= currFrame)
     {
         mKeyframe1 = mKeyframe2;
         mKeyframe2++;
-        if (mKeyframe2 >= (int)mKeyframes.size())
+        if (mKeyframe2 >= (int)mFrames.size())
             mKeyframe2 = -1;
     }
 
     // Should we move backwards in time?
-    while (mKeyframe1 >= 0 && mKeyframes[mKeyframe1]->GetFrame() > currFrame)
+    while (mKeyframe1 >= 0 && mFrames[mKeyframe1] > currFrame)
     {
         mKeyframe2 = mKeyframe1;
         mKeyframe1--;
@@ -117,28 +210,63 @@ void AnimChannel::SetFrame(int currFrame)
     {
         // Between two keyframes
         // So we have to tween
-        mKeyframes[mKeyframe1]->UseAs1();
-        mKeyframes[mKeyframe2]->UseAs2();
+        mFrom = mKeyframe1;
+        mTo = mKeyframe2;
 
         // Compute the t value
         double frameRate = GetTimeline()->GetFrameRate();
-        double time1 = mKeyframes[mKeyframe1]->GetFrame() / frameRate;
-        double time2 = mKeyframes[mKeyframe2]->GetFrame() / frameRate;
-        double t = (GetTimeline()->GetCurrentTime() - time1) / (time2 - time1);
-
-        // And tween
-        Tween(t);
+        double time1 = mFrames[mKeyframe1] / frameRate;
+        double time2 = mFrames[mKeyframe2] / frameRate;
+        mT = (GetTimeline()->GetCurrentTime() - time1) / (time2 - time1);
     }
-    else if (mKeyframe1 >= 0)
+    else
     {
-        // We are only using keyframe 1
-        mKeyframes[mKeyframe1]->UseOnly();
+        // We are only using one keyframe, if any. Tweening
+        // a keyframe with itself gives its value exactly.
+        mFrom = mKeyframe1 >= 0 ? mKeyframe1 : mKeyframe2;
+        mTo = mFrom;
+        mT = 0;
     }
-    else if (mKeyframe2 >= 0)
+}
+
+/**
+ * Is a frame close enough to the current keyframes that
+ * stepping to it takes at most one keyframe?
+ * @param currFrame The frame to test
+ * @return true if the frame is in the current interval or one next to it
+ */
+bool AnimChannel::IsNearFrame(int currFrame)
+{
+    int size = (int)mFrames.size();
+
+    // Past the keyframe after the next one?
+    if (mKeyframe2 >= 0 && mKeyframe2 + 1 < size && mFrames[mKeyframe2 + 1] <= currFrame)
     {
-        // We are only using keyframe 2
-        mKeyframes[mKeyframe2]->UseOnly();
+        return false;
     }
+
+    // Before the keyframe before the previous one?
+    if (mKeyframe1 > 0 && mFrames[mKeyframe1 - 1] > currFrame)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Set the keyframe indices for a frame with a binary search
+ * over the keyframe frame numbers.
+ * @param currFrame The frame we are on.
+ */
+void AnimChannel::Seek(int currFrame)
+{
+    // First keyframe after the current frame
+    auto next = std::upper_bound(mFrames.begin(), mFrames.end(), currFrame);
+
+    int index = (int)(next - mFrames.begin());
+    mKeyframe1 = index - 1;
+    mKeyframe2 = index < (int)mFrames.size() ? index : -1;
 }
 
 /**
@@ -152,7 +280,7 @@ void AnimChannel::ClearKeyframe()
 
     // We know mKeyframe1 is valid
     // Determine the frame number for the first keyframe
-    int frame1 = mKeyframes[mKeyframe1]->GetFrame();
+    int frame1 = mFrames[mKeyframe1];
 
     // What is the current frame?
     int currFrame = GetTimeline()->GetCurrentFrame();
@@ -162,7 +290,8 @@ void AnimChannel::ClearKeyframe()
     if (frame1 != currFrame)
         return;
 
-    mKeyframes.erase(mKeyframes.begin() + mKeyframe1);
+    mFrames.erase(mFrames.begin() + mKeyframe1);
+    RemoveKeyframe(mKeyframe1);
 
     // The current frame becomes the previous frame
     // or -1 if we are on frame 0
@@ -171,6 +300,10 @@ void AnimChannel::ClearKeyframe()
     // If the next frame is valid, it will be decreased by 1
     if (mKeyframe2 >= 0)
         mKeyframe2--;
+
+    // Nothing to tween until we are located again
+    mFrom = -1;
+    mTo = -1;
 }
 
 
@@ -185,26 +318,14 @@ wxXmlNode* AnimChannel::XmlSave(wxXmlNode* node)
 
     itemNode->AddAttribute(L"name", mName);
 
-    for (auto keyframe : mKeyframes)
+    for (int i = 0; i < (int)mFrames.size(); i++)
     {
-        keyframe->XmlSave(itemNode);
-    }
+        auto keyframeNode = new wxXmlNode(wxXML_ELEMENT_NODE, L"keyframe");
+        itemNode->AddChild(keyframeNode);
 
-    return itemNode;
-}
-
-
-/**
- * Save this keyframe to an XML node
- * @param node The node we are going to be a child of
- * @return Allocated XML node
- */
-wxXmlNode* AnimChannel::Keyframe::XmlSave(wxXmlNode* node)
-{
-    auto itemNode = new wxXmlNode(wxXML_ELEMENT_NODE, L"keyframe");
-    node->AddChild(itemNode);
-
-    itemNode->AddAttribute(L"frame", wxString::Format(wxT("%i"), mFrame));
+        keyframeNode->AddAttribute(L"frame", wxString::Format(wxT("%i"), mFrames[i]));
+        XmlSaveKeyframe(keyframeNode, i);
+    }
 
     return itemNode;
 }
@@ -226,24 +347,37 @@ void AnimChannel::XmlLoad(wxXmlNode* node)
         auto name = child->GetName();
         if(name == L"keyframe")
         {
-            int frame = wxAtoi(child->GetAttribute(L"frame", L"0"));
-
-            // Pretend we are at that time
-            GetTimeline()->SetCurrentTime(double(frame) / double(GetTimeline()->GetFrameRate()));
-
-            // Have the derived class set the keyframe
-            XmlLoadKeyframe(child);
+            XmlKeyframe(child);
         }
     }
 }
 
 
+/**
+ * Handle the "keyframe" XML tag.
+ *
+ * This only needs the keyframe node itself, not the
+ * document it is in, so keyframes can be loaded as they
+ * are read from a stream.
+ * @param node Node that is the keyframe tag.
+ */
+void AnimChannel::XmlKeyframe(wxXmlNode* node)
+{
+    int frame = wxAtoi(node->GetAttribute(L"frame", L"0"));
+
+    // Have the derived class add the keyframe at that frame
+    XmlLoadKeyframe(node, frame);
+}
+
+
 /**
  * Clear all keyframes for this channel.
  */
 void AnimChannel::Clear()
 {
-    mKeyframes.clear();
+    mFrames.clear();
     mKeyframe1 = -1;
     mKeyframe2 = -1;
+    mFrom = -1;
+    mTo = -1;
 }
\ No newline at end of file
@@ -14,6 +14,10 @@ class Timeline;
 
 /**
  * Base class for an animation channel
+ *
+ * The frame numbers of the keyframes are kept here in one
+ * array, in increasing order. Each derived class keeps the
+ * keyframe values in an array of its own type, in the same order.
  */
 class AnimChannel {
 private:
@@ -29,58 +33,37 @@ private:
     /// The timeline object
     Timeline *mTimeline = nullptr;
 
+    /// The frame number of each keyframe
+    std::vector<int> mFrames;
+
+    bool IsNearFrame(int currFrame);
+    void Seek(int currFrame);
+
 protected:
     /// Default constructor
     AnimChannel() {}
-    
-    /// Class that represents a keyframe
-    class Keyframe
-    {
-    public:
-        /** Default constructor disabled */
-        Keyframe() = delete;
-        /** Copy constructor disabled */
-        Keyframe(const Keyframe &) = delete;
-        /** Assignment operator disabled */
-        void operator=(const Keyframe &) = delete;
-
-        /**
-         * Get the frame for this keyframe
-         * @return The keyframe frame number
-         */
-        int GetFrame() const { return mFrame; }
-
-        /**
-         * Set the frame for this keyframe
-         * @param f The new frame number to set
-         */
-        void SetFrame(int f) { mFrame = f; }
-
-        /// Indicates this keyframe is used as Keyframe1
-        virtual void UseAs1() = 0;
-
-        /// Indicates this keyframe is used as Keyframe2
-        virtual void UseAs2() = 0;
-
-        /// Indicates this is the only keyframe
-        virtual void UseOnly() = 0;
-
-        virtual wxXmlNode* XmlSave(wxXmlNode* node);
-
-    private:
-        /// The channel this keyframe is associated with
-        AnimChannel *mChannel;
-
-        int mFrame; ///< The frame number for the keyframe
-
-    protected:
-        /**
-         * Constructor
-         * @param channel Channel we are associated with
-         */
-        Keyframe(AnimChannel *channel) : mChannel(channel) {}
-
-    };
+
+    /// Keyframe to tween from for the current frame, -1 if there are no keyframes
+    int mFrom = -1;
+
+    /// Keyframe to tween to for the current frame. The same as
+    /// mFrom when we are before the first or after the last keyframe
+    int mTo = -1;
+
+    /// The T value to tween with (0 to 1)
+    double mT = 0;
+
+    int InsertKeyframe(bool &added);
+
+    int InsertKeyframe(int frame, bool &added);
+
+    void SetKeyframeFrames(std::vector<int> frames);
+
+    /**
+     * Remove the value for a keyframe that has been deleted
+     * @param index Index of the keyframe
+     */
+    virtual void RemoveKeyframe(int index) = 0;
 
 public:
     /// Destructor
@@ -115,6 +98,14 @@ public:
 
     void SetFrame(int currFrame);
 
+    void Locate(int currFrame);
+
+    /**
+     * Compute the channel value for the keyframes and
+     * T value found by the last call to Locate
+     */
+    virtual void Evaluate() = 0;
+
     /**
      * Is the channel valid, meaning has keyframes?
      * @return true if the channel is valid.
@@ -122,28 +113,37 @@ public:
     bool IsValid() { return mKeyframe1 >= 0 || mKeyframe2 >= 0; }
     void ClearKeyframe();
 
+    /**
+     * Get the number of keyframes in the channel
+     * @return Number of keyframes
+     */
+    int GetKeyframeCount() const { return (int)mFrames.size(); }
+
+    /**
+     * Get the frame numbers of the keyframes
+     * @return Frame numbers in increasing order
+     */
+    const std::vector<int> &GetKeyframeFrames() const { return mFrames; }
+
     virtual void Clear();
     virtual wxXmlNode* XmlSave(wxXmlNode* node);
     virtual void XmlLoad(wxXmlNode* node);
-
-private:
-    /// The collection of keyframes for this channel
-    std::vector<std::shared_ptr<Keyframe>> mKeyframes;
+    void XmlKeyframe(wxXmlNode* node);
 
 protected:
-    void InsertKeyframe(std::shared_ptr<Keyframe> keyframe);
-
     /**
      * Channel type specific loading and keyframe creation
      * @param node Node to load from
+     * @param frame Frame number of the keyframe
      */
-    virtual void XmlLoadKeyframe(wxXmlNode* node) = 0;
+    virtual void XmlLoadKeyframe(wxXmlNode* node, int frame) = 0;
 
     /**
-     * Tween between two keyframes
-     * @param t The T value (0 to 1)
-     * */
-    virtual void Tween(double t) = 0;
+     * Channel type specific saving of a keyframe value
+     * @param node The keyframe node to add the value to
+     * @param index Index of the keyframe
+     */
+    virtual void XmlSaveKeyframe(wxXmlNode* node, int index) = 0;
 };
 
 #endif //CANADIANEXPERIENCE_ANIMCHANNEL_H
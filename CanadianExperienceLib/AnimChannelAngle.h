@@ -17,58 +17,13 @@ class AnimChannelAngle : public AnimChannel {
 private:
     double mAngle = 0;  ///< The computed animation angle
 
-protected:
-    /// A keyframe for an angle channel
-    class KeyframeAngle : public Keyframe
-    {
-    public:
-        /**
-         * Constructor
-         * @param channel The channel we are for
-         * @param angle The angle for the keyframe
-         */
-        KeyframeAngle(AnimChannelAngle *channel, double angle) :
-            Keyframe(channel), mChannel(channel), mAngle(angle) {}
-
-        /** Default constructor disabled */
-        KeyframeAngle() = delete;
-        /** Copy constructor disabled */
-        KeyframeAngle(const KeyframeAngle &) = delete;
-        /** Assignment operator disabled */
-        void operator=(const KeyframeAngle &) = delete;
-
-        /**
-         * Get the angle at this keyframe
-         * @return Angle in radians
-         */
-        double GetAngle() { return mAngle; }
-
-        /// Use this keyframe as keyframe 1
-        void UseAs1() override { mChannel->mKeyframe1 = this; }
-
-        /// Use this keyframe as keyfraem 2
-        void UseAs2() override { mChannel->mKeyframe2 = this; }
-
-        /// Use this keyframe as the angle
-        void UseOnly() override { mChannel->mAngle = mAngle; }
-
-    private:
-        double mAngle;  ///< The angle for this keyframe
-
-        /// The channel this keyframe is associated with
-        AnimChannelAngle *mChannel;
-
-        wxXmlNode* XmlSave(wxXmlNode* node) override;
-    };
+    /// The angle for each keyframe, in keyframe order
+    std::vector<double> mAngles;
 
 protected:
-    void XmlLoadKeyframe(wxXmlNode* node) override;
-
-    /// The first angle keyframe
-    KeyframeAngle *mKeyframe1 = nullptr;
-
-    /// The second angle keyframe
-    KeyframeAngle *mKeyframe2 = nullptr;
+    void XmlLoadKeyframe(wxXmlNode* node, int frame) override;
+    void XmlSaveKeyframe(wxXmlNode* node, int index) override;
+    void RemoveKeyframe(int index) override;
 
 public:
     AnimChannelAngle() {}
@@ -80,7 +35,19 @@ public:
     double GetAngle() { return mAngle; }
 
     void SetKeyframe(double angle);
-    void Tween(double t) override;
+    void AddKeyframe(int frame, double angle);
+    void SetKeyframes(std::vector<int> frames, std::vector<double> angles);
+
+    /**
+     * Get the angles of the keyframes
+     * @return The angle of each keyframe, in keyframe order
+     */
+    const std::vector<double> &GetKeyframeAngles() const { return mAngles; }
+
+    void Evaluate() override;
+    void Clear() override;
+
+    static void EvaluateAll(const std::vector<AnimChannelAngle*> &channels);
 };
 
 #endif //CANADIANEXPERIENCE_ANIMCHANNELANGLE_H
@@ -18,6 +18,9 @@ private:
     /// The point we compute
     wxPoint mPoint = wxPoint(0, 0);
 
+    /// The point for each keyframe, in keyframe order
+    std::vector<wxPoint> mPoints;
+
 public:
     AnimChannelPoint() = default;
 
@@ -27,60 +30,25 @@ public:
      */
     wxPoint GetPoint() { return mPoint; }
 
-    /// A keyframe for a point channel
-    class KeyframePoint : public Keyframe
-    {
-    private:
-        /// The keyframe point
-        wxPoint mPoint = wxPoint(0, 0);
-
-        /// The channel this keyframe is associated with
-        AnimChannelPoint *mChannel;
-
-    public:
-        /**
-         * Constructor
-         * @param channel The channel we are for
-         * @param point The animation position for the keyframe
-         */
-        KeyframePoint(AnimChannelPoint *channel, wxPoint point) :
-                Keyframe(channel), mChannel(channel), mPoint(point) {}
-
-        /** Default constructor disabled */
-        KeyframePoint() = delete;
-        /** Copy constructor disabled */
-        KeyframePoint(const KeyframePoint &) = delete;
-        /** Assignment operator disabled */
-        void operator=(const KeyframePoint &) = delete;
-
-        /// The keyframe point
-        /// @return The keyframe point
-        wxPoint GetPoint() { return mPoint; }
-
-        /** Use this keyframe as keyframe 1 */
-        void UseAs1() override { mChannel->mKeyframe1 = this; }
-
-        /** Use this keyframe as keyfraem 2 */
-        void UseAs2() override { mChannel->mKeyframe2 = this; }
-
-        /** Use this keyframe as the angle */
-        void UseOnly() override { mChannel->mPoint = mPoint; }
-
-        wxXmlNode* XmlSave(wxXmlNode* node) override;
-    };
-
     void SetKeyframe(wxPoint point);
-    void Tween(double t) override;
+    void AddKeyframe(int frame, wxPoint point);
+    void SetKeyframes(std::vector<int> frames, std::vector<wxPoint> points);
 
-private:
-    /// The first angle keyframe
-    KeyframePoint *mKeyframe1 = nullptr;
+    /**
+     * Get the points of the keyframes
+     * @return The point of each keyframe, in keyframe order
+     */
+    const std::vector<wxPoint> &GetKeyframePoints() const { return mPoints; }
+
+    void Evaluate() override;
+    void Clear() override;
 
-    /// The second angle keyframe
-    KeyframePoint *mKeyframe2 = nullptr;
+    static void EvaluateAll(const std::vector<AnimChannelPoint*> &channels);
 
 protected:
-    void XmlLoadKeyframe(wxXmlNode* node) override;
+    void XmlLoadKeyframe(wxXmlNode* node, int frame) override;
+    void XmlSaveKeyframe(wxXmlNode* node, int index) override;
+    void RemoveKeyframe(int index) override;
 };
 
 #endif //CANADIANEXPERIENCE_ANIMCHANNELPOINT_H
@@ -0,0 +1,539 @@
+/**
+ * @file AnimFile.cpp
+ * @author Frederick Fan
+ */
+
+#include "pch.h"
+#include "AnimFile.h"
+#include "MappedFile.h"
+#include "Timeline.h"
+#include "AnimChannelAngle.h"
+#include "AnimChannelPoint.h"
+
+#include <wx/filename.h>
+
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+
+// The tables are read and written as the bytes of the structures
+// below, which only gives the little-endian layout on little-endian hosts
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "AnimFile reads and writes little-endian data in place"
+#endif
+
+/// Filename extension of the binary format
+const wchar_t *AnimFile::Extension = L"banim";
+
+/// The bytes every binary animation file starts with
+const char Magic[8] = {'C', 'E', 'A', 'N', 'I', 'M', 'B', '\n'};
+
+/// Channel table type of an angle channel
+const uint32_t AngleChannelType = 1;
+
+/// Channel table type of a point channel
+const uint32_t PointChannelType = 2;
+
+/// The file header
+struct AnimFileHeader
+{
+    char mMagic[8];             ///< Always Magic
+    uint32_t mVersion;          ///< Format version
+    int32_t mNumFrames;         ///< Number of frames in the timeline
+    int32_t mFrameRate;         ///< Timeline frame rate
+    uint32_t mStringCount;      ///< Entries in the string table
+    uint32_t mAttributeCount;   ///< Entries in the attribute table
+    uint32_t mChannelCount;     ///< Entries in the channel table
+};
+
+/// An entry in the string table
+struct AnimFileString
+{
+    uint64_t mOffset;           ///< Where the UTF-8 bytes are in the file
+    uint32_t mLength;           ///< Number of bytes
+    uint32_t mReserved;         ///< Always zero
+};
+
+/// An entry in the attribute table
+struct AnimFileAttribute
+{
+    uint32_t mName;             ///< String table index of the name
+    int32_t mValue;             ///< The value
+};
+
+/// An entry in the channel table
+struct AnimFileChannel
+{
+    uint32_t mName;             ///< String table index of the name
+    uint32_t mType;             ///< AngleChannelType or PointChannelType
+    uint32_t mCount;            ///< Number of keyframes
+    uint32_t mReserved;         ///< Always zero
+    uint64_t mOffset;           ///< Where the keyframes are in the file
+};
+
+// The structures are the file layout, with no padding the compiler chooses
+static_assert(sizeof(AnimFileHeader) == 32, "AnimFileHeader must match the file layout");
+static_assert(sizeof(AnimFileString) == 16, "AnimFileString must match the file layout");
+static_assert(sizeof(AnimFileAttribute) == 8, "AnimFileAttribute must match the file layout");
+static_assert(sizeof(AnimFileChannel) == 24, "AnimFileChannel must match the file layout");
+
+/**
+ * Append a value to a buffer as its bytes
+ * @param buffer Buffer to append to
+ * @param value Value to append
+ */
+template<class T>
+static void Append(std::vector<unsigned char> &buffer, const T &value)
+{
+    auto bytes = (const unsigned char *)&value;
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+/**
+ * Pad a buffer with zeros to a multiple of 8 bytes
+ * @param buffer Buffer to pad
+ */
+static void Pad(std::vector<unsigned char> &buffer)
+{
+    buffer.resize((buffer.size() + 7) / 8 * 8);
+}
+
+/**
+ * Read a value from its bytes, which need not be aligned
+ * @param data Where the value is
+ * @return The value
+ */
+template<class T>
+static T Extract(const unsigned char *data)
+{
+    T value;
+    memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+/**
+ * Get the size of the frame numbers of a channel in the file
+ * @param count Number of keyframes
+ * @return Size in bytes, including the padding after them
+ */
+static uint64_t FramesSize(uint64_t count)
+{
+    return (count * sizeof(int32_t) + 7) / 8 * 8;
+}
+
+/**
+ * Get the size of the keyframes of a channel in the file
+ * @param type Channel type
+ * @param count Number of keyframes
+ * @return Size in bytes of the frame numbers and values
+ */
+static uint64_t KeyframesSize(uint32_t type, uint64_t count)
+{
+    uint64_t values = type == AngleChannelType ? count * sizeof(uint64_t) : count * 2 * sizeof(int32_t);
+    return FramesSize(count) + values;
+}
+
+/**
+ * Append the frame numbers of a channel, each the difference
+ * from the one before. The differences wrap around rather than
+ * overflow, so any frame numbers can be stored.
+ * @param buffer Buffer to append to
+ * @param frames Frame numbers to append
+ */
+static void AppendFrames(std::vector<unsigned char> &buffer, const std::vector<int> &frames)
+{
+    uint32_t previous = 0;
+    for (auto frame : frames)
+    {
+        Append(buffer, (uint32_t)frame - previous);
+        previous = (uint32_t)frame;
+    }
+
+    Pad(buffer);
+}
+
+/**
+ * Decode the frame numbers of a channel
+ * @param data Where the frame numbers start
+ * @param count Number of frame numbers
+ * @param frames Receives the frame numbers
+ * @return false if the frame numbers are not in increasing order
+ */
+static bool ExtractFrames(const unsigned char *data, uint32_t count, std::vector<int> &frames)
+{
+    frames.resize(count);
+
+    uint32_t frame = 0;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        frame += Extract<uint32_t>(data + i * sizeof(uint32_t));
+        frames[i] = (int)frame;
+        if (i > 0 && frames[i] <= frames[i - 1])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Is this filename one the binary format is saved to?
+ * @param filename Filename to test
+ * @return true if the filename has the binary format extension
+ */
+bool AnimFile::IsBinaryFilename(const wxString &filename)
+{
+    return wxFileName(filename).GetExt().IsSameAs(Extension, false);
+}
+
+/**
+ * Is this file in the binary format? This looks at the contents, not the name.
+ * @param filename File to test
+ * @return true if the file starts the way a binary animation file does
+ */
+bool AnimFile::IsAnimFile(const wxString &filename)
+{
+    std::ifstream file(filename.fn_str(), std::ios::in | std::ios::binary);
+
+    char magic[sizeof(Magic)];
+    file.read(magic, sizeof(magic));
+    return file && memcmp(magic, Magic, sizeof(Magic)) == 0;
+}
+
+/**
+ * Save an animation to a file in the binary format
+ * @param filename File to save to
+ * @param timeline Timeline with the animation
+ * @param attributes Attributes to save with the animation
+ * @return true if the file was written
+ */
+bool AnimFile::Save(const wxString &filename, const Timeline &timeline, const Attributes &attributes)
+{
+    auto buffer = Write(timeline, attributes);
+
+    std::ofstream file(filename.fn_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    file.write((const char *)buffer.data(), buffer.size());
+    return !file.fail();
+}
+
+/**
+ * Load an animation from a file in the binary format
+ * @param filename File to load from
+ * @param timeline Timeline to load the animation into
+ * @param attributes Receives the attributes saved with the animation
+ * @return true if the file was loaded, false if it could not
+ * be read or is not a valid file, in which case nothing is changed
+ */
+bool AnimFile::Load(const wxString &filename, Timeline &timeline, Attributes &attributes)
+{
+    MappedFile file(filename);
+    if (!file.IsOpen())
+    {
+        return false;
+    }
+
+    return Read(file.GetData(), file.GetSize(), timeline, attributes);
+}
+
+/**
+ * Write an animation in the binary format
+ * @param timeline Timeline with the animation
+ * @param attributes Attributes to save with the animation
+ * @return The contents of the file
+ */
+std::vector<unsigned char> AnimFile::Write(const Timeline &timeline, const Attributes &attributes)
+{
+    //
+    // The string table, with each name in it once
+    //
+    std::vector<std::string> strings;
+    std::unordered_map<std::string, uint32_t> interned;
+    auto intern = [&strings, &interned](const std::wstring &name) {
+        auto utf8 = wxString(name).ToUTF8();
+        std::string str(utf8.data(), utf8.length());
+
+        auto found = interned.emplace(str, (uint32_t)strings.size());
+        if (found.second)
+        {
+            strings.push_back(str);
+        }
+
+        return found.first->second;
+    };
+
+    std::vector<AnimFileAttribute> attributeTable;
+    for (auto &attribute : attributes)
+    {
+        attributeTable.push_back({intern(attribute.first), attribute.second});
+    }
+
+    //
+    // The keyframes, with offsets from the start of the
+    // keyframe data until we know where that is
+    //
+    std::vector<AnimFileChannel> channelTable;
+    std::vector<unsigned char> keyframes;
+
+    for (auto channel : timeline.GetAngleChannels())
+    {
+        auto &frames = channel->GetKeyframeFrames();
+        channelTable.push_back({intern(channel->GetName()), AngleChannelType,
+                                (uint32_t)frames.size(), 0, keyframes.size()});
+
+        AppendFrames(keyframes, frames);
+
+        uint64_t previous = 0;
+        for (auto angle : channel->GetKeyframeAngles())
+        {
+            uint64_t bits;
+            memcpy(&bits, &angle, sizeof(bits));
+            Append(keyframes, bits ^ previous);
+            previous = bits;
+        }
+    }
+
+    for (auto channel : timeline.GetPointChannels())
+    {
+        auto &frames = channel->GetKeyframeFrames();
+        channelTable.push_back({intern(channel->GetName()), PointChannelType,
+                                (uint32_t)frames.size(), 0, keyframes.size()});
+
+        AppendFrames(keyframes, frames);
+
+        wxPoint previous(0, 0);
+        for (auto point : channel->GetKeyframePoints())
+        {
+            Append(keyframes, (uint32_t)point.x - (uint32_t)previous.x);
+            Append(keyframes, (uint32_t)point.y - (uint32_t)previous.y);
+            previous = point;
+        }
+        Pad(keyframes);
+    }
+
+    //
+    // Lay out the file
+    //
+    uint64_t stringsOffset = sizeof(AnimFileHeader) + strings.size() * sizeof(AnimFileString) +
+            attributeTable.size() * sizeof(AnimFileAttribute) + channelTable.size() * sizeof(AnimFileChannel);
+
+    std::vector<AnimFileString> stringTable;
+    uint64_t offset = stringsOffset;
+    for (auto &str : strings)
+    {
+        stringTable.push_back({offset, (uint32_t)str.size(), 0});
+        offset += str.size();
+    }
+
+    uint64_t keyframesOffset = (offset + 7) / 8 * 8;
+    for (auto &entry : channelTable)
+    {
+        entry.mOffset += keyframesOffset;
+    }
+
+    AnimFileHeader header;
+    memcpy(header.mMagic, Magic, sizeof(Magic));
+    header.mVersion = Version;
+    header.mNumFrames = timeline.GetNumFrames();
+    header.mFrameRate = timeline.GetFrameRate();
+    header.mStringCount = (uint32_t)stringTable.size();
+    header.mAttributeCount = (uint32_t)attributeTable.size();
+    header.mChannelCount = (uint32_t)channelTable.size();
+
+    std::vector<unsigned char> buffer;
+    buffer.reserve(keyframesOffset + keyframes.size());
+
+    Append(buffer, header);
+    for (auto &entry : stringTable)
+    {
+        Append(buffer, entry);
+    }
+
+    for (auto &entry : attributeTable)
+    {
+        Append(buffer, entry);
+    }
+
+    for (auto &entry : channelTable)
+    {
+        Append(buffer, entry);
+    }
+
+    for (auto &str : strings)
+    {
+        buffer.insert(buffer.end(), str.begin(), str.end());
+    }
+
+    Pad(buffer);
+    buffer.insert(buffer.end(), keyframes.begin(), keyframes.end());
+
+    return buffer;
+}
+
+/**
+ * Read an animation in the binary format.
+ *
+ * Channels are matched to the channels of the timeline by name
+ * and type. Channels the timeline does not have are ignored, as
+ * they are when loading XML.
+ * @param data The contents of the file
+ * @param size Size of the contents in bytes
+ * @param timeline Timeline to load the animation into
+ * @param attributes Receives the attributes saved with the animation
+ * @return true if the animation was loaded, false if it is not
+ * valid, in which case nothing is changed
+ */
+bool AnimFile::Read(const unsigned char *data, size_t size, Timeline &timeline, Attributes &attributes)
+{
+    if (size < sizeof(AnimFileHeader))
+    {
+        return false;
+    }
+
+    auto header = Extract<AnimFileHeader>(data);
+    if (memcmp(header.mMagic, Magic, sizeof(Magic)) != 0 || header.mVersion == 0 || header.mVersion > Version)
+    {
+        return false;
+    }
+
+    // Channels divide by the frame rate to find the frame for a time
+    if (header.mFrameRate <= 0)
+    {
+        return false;
+    }
+
+    uint64_t stringTableOffset = sizeof(AnimFileHeader);
+    uint64_t attributeTableOffset = stringTableOffset + (uint64_t)header.mStringCount * sizeof(AnimFileString);
+    uint64_t channelTableOffset = attributeTableOffset + (uint64_t)header.mAttributeCount * sizeof(AnimFileAttribute);
+    uint64_t tablesEnd = channelTableOffset + (uint64_t)header.mChannelCount * sizeof(AnimFileChannel);
+    if (tablesEnd > size)
+    {
+        return false;
+    }
+
+    std::vector<std::wstring> strings;
+    for (uint32_t i = 0; i < header.mStringCount; i++)
+    {
+        auto entry = Extract<AnimFileString>(data + stringTableOffset + i * sizeof(AnimFileString));
+        if (entry.mOffset > size || entry.mLength > size - entry.mOffset)
+        {
+            return false;
+        }
+
+        strings.push_back(wxString::FromUTF8((const char *)data + entry.mOffset, entry.mLength).ToStdWstring());
+    }
+
+    Attributes loaded;
+    for (uint32_t i = 0; i < header.mAttributeCount; i++)
+    {
+        auto entry = Extract<AnimFileAttribute>(data + attributeTableOffset + i * sizeof(AnimFileAttribute));
+        if (entry.mName >= strings.size())
+        {
+            return false;
+        }
+
+        loaded[strings[entry.mName]] = entry.mValue;
+    }
+
+    //
+    // Decode every channel before changing anything,
+    // so a bad file leaves the timeline as it was
+    //
+    struct Decoded
+    {
+        AnimChannelAngle *mAngleChannel = nullptr;
+        AnimChannelPoint *mPointChannel = nullptr;
+        std::vector<int> mFrames;
+        std::vector<double> mAngles;
+        std::vector<wxPoint> mPoints;
+    };
+
+    std::vector<Decoded> channels;
+    for (uint32_t i = 0; i < header.mChannelCount; i++)
+    {
+        auto entry = Extract<AnimFileChannel>(data + channelTableOffset + i * sizeof(AnimFileChannel));
+        if (entry.mName >= strings.size() || (entry.mType != AngleChannelType && entry.mType != PointChannelType))
+        {
+            return false;
+        }
+
+        if (entry.mOffset > size || KeyframesSize(entry.mType, entry.mCount) > size - entry.mOffset)
+        {
+            return false;
+        }
+
+        Decoded decoded;
+        auto channel = timeline.FindChannel(strings[entry.mName]);
+        if (entry.mType == AngleChannelType)
+        {
+            decoded.mAngleChannel = dynamic_cast<AnimChannelAngle *>(channel);
+        }
+        else
+        {
+            decoded.mPointChannel = dynamic_cast<AnimChannelPoint *>(channel);
+        }
+
+        if (decoded.mAngleChannel == nullptr && decoded.mPointChannel == nullptr)
+        {
+            // Not a channel we have
+            continue;
+        }
+
+        auto keyframes = data + entry.mOffset;
+        if (!ExtractFrames(keyframes, entry.mCount, decoded.mFrames))
+        {
+            return false;
+        }
+
+        auto values = keyframes + FramesSize(entry.mCount);
+
+        if (decoded.mAngleChannel != nullptr)
+        {
+            decoded.mAngles.resize(entry.mCount);
+
+            uint64_t bits = 0;
+            for (uint32_t k = 0; k < entry.mCount; k++)
+            {
+                bits ^= Extract<uint64_t>(values + k * sizeof(uint64_t));
+                memcpy(&decoded.mAngles[k], &bits, sizeof(bits));
+            }
+        }
+        else
+        {
+            decoded.mPoints.resize(entry.mCount);
+
+            uint32_t x = 0, y = 0;
+            for (uint32_t k = 0; k < entry.mCount; k++)
+            {
+                x += Extract<uint32_t>(values + k * 2 * sizeof(uint32_t));
+                y += Extract<uint32_t>(values + (k * 2 + 1) * sizeof(uint32_t));
+                decoded.mPoints[k] = wxPoint((int)x, (int)y);
+            }
+        }
+
+        channels.push_back(std::move(decoded));
+    }
+
+    //
+    // Everything is valid, so replace the animation
+    //
+    timeline.Clear();
+    timeline.SetNumFrames(header.mNumFrames);
+    timeline.SetFrameRate(header.mFrameRate);
+
+    for (auto &decoded : channels)
+    {
+        if (decoded.mAngleChannel != nullptr)
+        {
+            decoded.mAngleChannel->SetKeyframes(std::move(decoded.mFrames), std::move(decoded.mAngles));
+        }
+        else
+        {
+            decoded.mPointChannel->SetKeyframes(std::move(decoded.mFrames), std::move(decoded.mPoints));
+        }
+    }
+
+    timeline.SetCurrentTime(timeline.GetCurrentTime());
+    attributes = std::move(loaded);
+    return true;
+}
@@ -0,0 +1,68 @@
+/**
+ * @file AnimFile.h
+ * @author Frederick Fan
+ *
+ * Binary animation file format
+ */
+
+#ifndef CANADIANEXPERIENCE_CANADIANEXPERIENCELIB_ANIMFILE_H
+#define CANADIANEXPERIENCE_CANADIANEXPERIENCELIB_ANIMFILE_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+class Timeline;
+
+/**
+ * Binary animation file format.
+ *
+ * This holds the same animation as the XML .anim files, but is
+ * written and read without any parsing or formatting of text. The file is:
+ *
+ * - A header with the version, the timeline settings and the
+ *   sizes of the tables that follow.
+ * - The string table. Every channel and attribute name is stored
+ *   once, as UTF-8, and referred to by its index in the table.
+ * - The attribute table of named integer values, the same values
+ *   the XML form keeps as attributes of the root node.
+ * - The channel table, with the name, type and keyframe count of
+ *   each channel and where its keyframes are in the file.
+ * - The keyframes of each channel. The frame numbers are stored as
+ *   the difference from the frame before, points as the difference
+ *   from the point before, and angles as their bits exclusive-ored
+ *   with the bits of the angle before, so nothing is lost.
+ *
+ * Everything is little-endian, and the tables are read and written
+ * as the bytes of structures, so this only builds for little-endian
+ * hosts. The frame rate must be positive. Loading maps the file into memory and
+ * decodes each channel straight into the channel's keyframe arrays.
+ */
+class AnimFile
+{
+public:
+    /// Named integer values saved with the animation
+    typedef std::map<std::wstring, int> Attributes;
+
+    /// Version of the format written by Save. Load reads
+    /// this version and any before it.
+    static const uint32_t Version = 1;
+
+    /// Filename extension of the binary format
+    static const wchar_t *Extension;
+
+    static bool IsBinaryFilename(const wxString &filename);
+
+    static bool IsAnimFile(const wxString &filename);
+
+    static bool Save(const wxString &filename, const Timeline &timeline, const Attributes &attributes);
+
+    static bool Load(const wxString &filename, Timeline &timeline, Attributes &attributes);
+
+    static std::vector<unsigned char> Write(const Timeline &timeline, const Attributes &attributes);
+
+    static bool Read(const unsigned char *data, size_t size, Timeline &timeline, Attributes &attributes);
+};
+
+#endif //CANADIANEXPERIENCE_CANADIANEXPERIENCELIB_ANIMFILE_H
@@ -8,6 +8,8 @@
 #include "Actor.h"
 #include "Timeline.h"
 
+#include <climits>
+
 /**
  * Constructor
  * \param name The drawable name
@@ -56,29 +58,48 @@ void Drawable::SetKeyframe()
 void Drawable::GetKeyframe()
 {
     if (mChannel.IsValid())
-        mRotation = mChannel.GetAngle();
+        SetRotation(mChannel.GetAngle());
 }
 
 
 /**
- * Place this drawable relative to its parent
- *
- * This works hierarchically from top item down.
+ * Place this drawable, but not its children
  * @param offset Parent offset
  * @param rotate Parent rotation
+ * @param cosR Cosine of the parent rotation
+ * @param sinR Sine of the parent rotation
  */
-void Drawable::Place(wxPoint offset, double rotate)
+void Drawable::PlaceAt(wxPoint offset, double rotate, double cosR, double sinR)
 {
     // Combine the transformation we are given with the transformation
     // for this object.
-    mPlacedPosition = offset + RotatePoint(mPosition, rotate);
+    mPlacedPosition = offset + RotatePoint(mPosition, cosR, sinR);
     mPlacedR = mRotation + rotate;
 
-    // Update our children
-    for (auto drawable : mChildren)
+    // Most parts are not rotated relative to their parent
+    if (mRotation == 0)
+    {
+        mPlacedCos = cosR;
+        mPlacedSin = sinR;
+    }
+    else
     {
-        drawable->Place(mPlacedPosition, mPlacedR);
+        mPlacedCos = cos(mPlacedR);
+        mPlacedSin = sin(mPlacedR);
     }
+
+    mDirty = false;
+}
+
+
+/**
+ * Place this drawable relative to a parent that
+ * has already been placed, but not its children
+ * @param parent The parent drawable
+ */
+void Drawable::PlaceUnder(const Drawable &parent)
+{
+    PlaceAt(parent.mPlacedPosition, parent.mPlacedR, parent.mPlacedCos, parent.mPlacedSin);
 }
 
 
@@ -91,6 +112,18 @@ void Drawable::AddChild(std::shared_ptr<Drawable> child)
     mChildren.push_back(child);
     child->mParent = this;
     child->SetParent(this);
+    child->mDirty = true;
+
+    // The actor places its drawables in tree order,
+    // which has to include the new one
+    for (auto drawable = this; drawable != nullptr; drawable = drawable->mParent)
+    {
+        if (drawable->mActor != nullptr)
+        {
+            drawable->mActor->TreeChanged();
+            break;
+        }
+    }
 }
 
 
@@ -104,11 +137,11 @@ void Drawable::Move(wxPoint delta)
 {
     if (mParent != nullptr)
     {
-        mPosition = mPosition + RotatePoint(delta, -mParent->mPlacedR);
+        SetPosition(mPosition + RotatePoint(delta, -mParent->mPlacedR));
     }
     else
     {
-        mPosition = mPosition + delta;
+        SetPosition(mPosition + delta);
     }
 }
 
@@ -120,9 +153,74 @@ void Drawable::Move(wxPoint delta)
  */
 wxPoint Drawable::RotatePoint(wxPoint point, double angle)
 {
-    double cosA = cos(angle);
-    double sinA = sin(angle);
+    return RotatePoint(point, cos(angle), sin(angle));
+}
+
 
+/** Rotate a point by an angle given by its cosine and sine.
+ * @param point The point to rotate
+ * @param cosA Cosine of the angle
+ * @param sinA Sine of the angle
+ * @return Rotated point
+ */
+wxPoint Drawable::RotatePoint(wxPoint point, double cosA, double sinA)
+{
     return wxPoint(int(cosA * point.x + sinA * point.y),
             int(-sinA * point.x + cosA * point.y));
-}
\ No newline at end of file
+}
+
+
+/** Transform a point relative to this drawable
+ * to a point in the drawing.
+ * @param point The point relative to this drawable
+ * @return The point in the drawing, as of when we were last placed
+ */
+wxPoint Drawable::PlacePoint(wxPoint point)
+{
+    return RotatePoint(point, mPlacedCos, mPlacedSin) + mPlacedPosition;
+}
+
+
+/** Transform a rectangle relative to this drawable to
+ * the rectangle in the drawing that contains it.
+ *
+ * The rectangle is a little larger than it needs to be, so it
+ * also contains the points PlacePoint rounds to.
+ * @param left Left edge relative to this drawable
+ * @param top Top edge relative to this drawable
+ * @param right Right edge relative to this drawable
+ * @param bottom Bottom edge relative to this drawable
+ * @return Rectangle in the drawing, as of when we were last placed
+ */
+wxRect Drawable::PlaceBounds(double left, double top, double right, double bottom)
+{
+    double minX = 0, minY = 0, maxX = 0, maxY = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        double x = i & 1 ? right : left;
+        double y = i & 2 ? bottom : top;
+        double placedX = mPlacedCos * x + mPlacedSin * y;
+        double placedY = -mPlacedSin * x + mPlacedCos * y;
+        if (i == 0 || placedX < minX) { minX = placedX; }
+        if (i == 0 || placedX > maxX) { maxX = placedX; }
+        if (i == 0 || placedY < minY) { minY = placedY; }
+        if (i == 0 || placedY > maxY) { maxY = placedY; }
+    }
+
+    return wxRect(wxPoint(mPlacedPosition.x + (int)floor(minX) - 1, mPlacedPosition.y + (int)floor(minY) - 1),
+                  wxPoint(mPlacedPosition.x + (int)ceil(maxX) + 1, mPlacedPosition.y + (int)ceil(maxY) + 1));
+}
+
+
+/**
+ * Get a rectangle in the drawing that contains every point
+ * HitTest could return true for, as of when we were last placed.
+ *
+ * We don't know what a derived class draws, so by default
+ * the rectangle contains everything.
+ * @return Rectangle in the drawing, empty if HitTest is never true
+ */
+wxRect Drawable::GetPlacedBounds()
+{
+    return wxRect(INT_MIN / 2, INT_MIN / 2, INT_MAX, INT_MAX);
+}
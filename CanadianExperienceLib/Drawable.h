@@ -42,9 +42,21 @@ private:
     /// The animation channel for animating the angle of this drawable
     AnimChannelAngle mChannel;
 
+    /// Cosine of mPlacedR
+    double mPlacedCos = 1;
+
+    /// Sine of mPlacedR
+    double mPlacedSin = 0;
+
+    /// Has the position or rotation changed since we were placed?
+    bool mDirty = true;
+
 protected:
     Drawable(const std::wstring &name);
     wxPoint RotatePoint(wxPoint point, double angle);
+    wxPoint RotatePoint(wxPoint point, double cosA, double sinA);
+    wxPoint PlacePoint(wxPoint point);
+    wxRect PlaceBounds(double left, double top, double right, double bottom);
 
 
     /// The actual postion in the drawing
@@ -71,10 +83,38 @@ public:
      */
     virtual void Draw(std::shared_ptr<wxGraphicsContext> graphics) = 0;
 
-    void Place(wxPoint offset, double rotate);
+    void PlaceAt(wxPoint offset, double rotate, double cosR, double sinR);
+    void PlaceUnder(const Drawable &parent);
+
+    /**
+     * Has the position or rotation of this drawable changed
+     * since it was last placed? Its children then need placing too.
+     * @return true if it needs placing
+     */
+    bool IsDirty() const { return mDirty; }
+
+    /**
+     * Get the position of this drawable in the drawing, as of
+     * when it was last placed
+     * @return Placed position
+     */
+    wxPoint GetPlacedPosition() const { return mPlacedPosition; }
+
+    /**
+     * Get the rotation of this drawable in the drawing, as of
+     * when it was last placed
+     * @return Placed rotation in radians
+     */
+    double GetPlacedRotation() const { return mPlacedR; }
 
     void AddChild(std::shared_ptr<Drawable> child);
 
+    /**
+     * Get the child drawables
+     * @return Children in the order they were added
+     */
+    const std::vector<std::shared_ptr<Drawable>> &GetChildren() const { return mChildren; }
+
     /**
      * Test to see if we have been clicked on by the mouse
      * @param pos Position to test
@@ -82,6 +122,8 @@ public:
      */
     virtual bool HitTest(wxPoint pos) = 0;
 
+    virtual wxRect GetPlacedBounds();
+
     /**
      * Is this a movable drawable?
      * @return true if movable
@@ -94,7 +136,14 @@ public:
      * Set the drawable position
      * @param pos The new drawable position
      */
-    void SetPosition(wxPoint pos) { mPosition = pos; }
+    void SetPosition(wxPoint pos)
+    {
+        if (!(pos == mPosition))
+        {
+            mPosition = pos;
+            mDirty = true;
+        }
+    }
 
     /**
      * Get the drawable position
@@ -106,7 +155,14 @@ public:
      * Set the rotation angle in radians
     * @param r The new rotation angle in radians
      */
-    void SetRotation(double r) { mRotation = r; }
+    void SetRotation(double r)
+    {
+        if (r != mRotation)
+        {
+            mRotation = r;
+            mDirty = true;
+        }
+    }
 
     /**
      * Get the rotation angle in radians
@@ -141,6 +197,12 @@ public:
      * @return Pointer to animation channel
      */
     AnimChannelAngle *GetAngleChannel() { return &mChannel; }
+
+    /**
+     * Get the actor using this drawable
+     * @return Actor pointer, or nullptr if there is none yet
+     */
+    Actor *GetActor() { return mActor; }
 };
 
 #endif //CANADIANEXPERIENCE_DRAWABLE_H
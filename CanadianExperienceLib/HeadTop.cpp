@@ -189,5 +189,5 @@ wxPoint HeadTop::TransformPoint(wxPoint p)
     p = p - GetCenter();
 
     // Rotate as needed and offset
-    return RotatePoint(p, mPlacedR) + mPlacedPosition;
+    return PlacePoint(p);
 }
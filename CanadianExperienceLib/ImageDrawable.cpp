@@ -5,6 +5,7 @@
 
 #include "pch.h"
 #include "ImageDrawable.h"
+#include <ImageCache.h>
 
 
 /** Constructor
@@ -13,7 +14,7 @@
 ImageDrawable::ImageDrawable(const std::wstring &name, const std::wstring &filename) :
         Drawable(name)
 {
-    mImage = std::make_unique<wxImage>(filename, wxBITMAP_TYPE_ANY);
+    mImage = ImageCache::Load(filename);
 }
 
 
@@ -23,16 +24,23 @@ ImageDrawable::ImageDrawable(const std::wstring &name, const std::wstring &filen
  */
 void ImageDrawable::Draw(std::shared_ptr<wxGraphicsContext> graphics)
 {
+    if(mImage == nullptr)
+    {
+        return;
+    }
+
     if(mBitmap.IsNull())
     {
-        mBitmap = graphics->CreateBitmapFromImage(*mImage);
+        mBitmap = mImage->GetBitmap(graphics);
     }
 
+    auto &image = mImage->GetImage();
+
     graphics->PushState();
     graphics->Translate(mPlacedPosition.x, mPlacedPosition.y);
     graphics->Rotate(-mPlacedR);
     graphics->DrawBitmap(mBitmap, -mCenter.x, -mCenter.y,
-            mImage->GetWidth(), mImage->GetHeight());
+            image.GetWidth(), image.GetHeight());
 
     graphics->PopState();
 }
@@ -45,6 +53,11 @@ void ImageDrawable::Draw(std::shared_ptr<wxGraphicsContext> graphics)
  */
 bool ImageDrawable::HitTest(wxPoint pos)
 {
+    if(mImage == nullptr)
+    {
+        return false;
+    }
+
     double x = pos.x;
     double y = pos.y;
 
@@ -73,8 +86,9 @@ bool ImageDrawable::HitTest(wxPoint pos)
 //    wxDouble y = pos.y;
 //    mat.TransformPoint(&x, &y);
 
-    double wid = mImage->GetWidth();
-    double hit = mImage->GetHeight();
+    auto &mask = mImage->GetMask();
+    double wid = mask.GetWidth();
+    double hit = mask.GetHeight();
 
     // Test to see if x, y are in the image
     if (x < 0 || y < 0 || x >= wid || y >= hit)
@@ -83,8 +97,31 @@ bool ImageDrawable::HitTest(wxPoint pos)
         return false;
     }
 
-    // Test to see if x, y are in the drawn part of the image
-    // If the location is transparent, we are not in the drawn
-    // part of the image
-    return !mImage->IsTransparent((int)x, (int)y);
-}
\ No newline at end of file
+    // Test to see if x, y are in the drawn part of the image.
+    // The mask was made from the image when it was loaded and
+    // has a bit set for each pixel that is not transparent.
+    return mask.IsOpaque((int)x, (int)y);
+}
+
+
+/**
+ * Get a rectangle in the drawing that contains the drawn part of the image
+ * @return Rectangle in the drawing, as of when we were last placed
+ */
+wxRect ImageDrawable::GetPlacedBounds()
+{
+    if(mImage == nullptr)
+    {
+        return wxRect();
+    }
+
+    // Only the drawn part of the image can be hit
+    auto opaque = mImage->GetMask().GetOpaqueBounds();
+    if(opaque.IsEmpty())
+    {
+        return wxRect();
+    }
+
+    return PlaceBounds(opaque.GetLeft() - mCenter.x, opaque.GetTop() - mCenter.y,
+            opaque.GetRight() + 1 - mCenter.x, opaque.GetBottom() + 1 - mCenter.y);
+}
@@ -10,14 +10,17 @@
 
 #include "Drawable.h"
 
+class SharedImage;
+
 
 /**
  * A drawable that displays an image
  */
 class ImageDrawable : public Drawable {
 private:
-    /// The underlying image we are drawing
-    std::unique_ptr<wxImage> mImage;
+    /// The underlying image we are drawing, shared
+    /// with every other user of the same image file
+    std::shared_ptr<SharedImage> mImage;
 
     /// The graphics bitmap we will use
     wxGraphicsBitmap mBitmap;
@@ -45,6 +48,8 @@ public:
     void Draw(std::shared_ptr<wxGraphicsContext> graphics) override;
 
     bool HitTest(wxPoint pos) override;
+
+    wxRect GetPlacedBounds() override;
 };
 
 #endif //CANADIANEXPERIENCE_IMAGEDRAWABLE_H
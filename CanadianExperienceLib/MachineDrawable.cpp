@@ -6,6 +6,8 @@
 #include "pch.h"
 #include "MachineDrawable.h"
 #include "Timeline.h"
+#include <MachineSystemActual.h>
+#include <MachineCheckpoint.h>
 
 /**
  * Constructor
@@ -23,11 +25,19 @@ MachineDrawable::MachineDrawable(const std::wstring &filename, const std::wstrin
 }
 
 /**
- * Draw the machine
- * @param graphics context that is being drawn on
+ * Advance the machine to the frame for the current timeline time.
+ *
+ * This does not draw anything, so it is safe to call for different
+ * machines at the same time from different threads. Calling it again
+ * for the same timeline frame does nothing.
  */
-void MachineDrawable::Draw(std::shared_ptr<wxGraphicsContext> graphics)
+void MachineDrawable::UpdateMachine()
 {
+    if (mTimeline == nullptr)
+    {
+        return;
+    }
+
     if (mTimeline->GetCurrentFrame() >= mStartFrame)
     {
         mFrame = mTimeline->GetCurrentFrame()-mStartFrame;
@@ -37,6 +47,16 @@ void MachineDrawable::Draw(std::shared_ptr<wxGraphicsContext> graphics)
         mFrame = 0;
     }
     mMachineSystem->SetMachineFrame(mFrame);
+}
+
+/**
+ * Draw the machine
+ * @param graphics context that is being drawn on
+ */
+void MachineDrawable::Draw(std::shared_ptr<wxGraphicsContext> graphics)
+{
+    // Usually already done by Picture::UpdateMachines
+    UpdateMachine();
 
     double scale = 0.5f;
     graphics->PushState();
@@ -86,3 +106,59 @@ void MachineDrawable::SetTimeline(Timeline *timeline)
 
 
 
+
+
+/**
+ * Get the machine system as the actual machine system
+ * @return Actual machine system or nullptr if this is the standin
+ */
+MachineSystemActual *MachineDrawable::GetActualSystem()
+{
+    return dynamic_cast<MachineSystemActual*>(mMachineSystem.get());
+}
+
+/**
+ * Create a checkpoint of the machine at its current frame
+ * @return Checkpoint or nullptr if the machine can't be checkpointed
+ */
+std::shared_ptr<MachineCheckpoint> MachineDrawable::CreateCheckpoint()
+{
+    auto system = GetActualSystem();
+    if (system == nullptr)
+    {
+        return nullptr;
+    }
+
+    return system->CreateCheckpoint();
+}
+
+/**
+ * Restore the machine to a checkpoint made by another
+ * drawable for the same machine
+ * @param checkpoint Checkpoint to restore, nullptr does nothing
+ */
+void MachineDrawable::RestoreCheckpoint(std::shared_ptr<MachineCheckpoint> checkpoint)
+{
+    auto system = GetActualSystem();
+    if (system == nullptr || checkpoint == nullptr)
+    {
+        return;
+    }
+
+    system->RestoreCheckpoint(*checkpoint);
+    mFrame = checkpoint->GetFrame();
+}
+
+/**
+ * Set how far ahead of the current frame the machine is
+ * simulated in the background
+ * @param frames Number of frames, 0 to turn background simulation off
+ */
+void MachineDrawable::SetLookahead(int frames)
+{
+    auto system = GetActualSystem();
+    if (system != nullptr)
+    {
+        system->SetLookahead(frames);
+    }
+}
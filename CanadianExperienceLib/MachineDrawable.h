@@ -12,6 +12,8 @@
 #include <machine-api.h>
 
 class MainFrame;
+class MachineCheckpoint;
+class MachineSystemActual;
 
 /** Adapter class for the machine */
 class MachineDrawable : public Drawable
@@ -31,6 +33,8 @@ private:
     ///The frame at which we want the machine to start moving
     int mStartFrame = 0;
 
+    MachineSystemActual *GetActualSystem();
+
 public:
 
 
@@ -47,8 +51,17 @@ public:
 
     void Draw(std::shared_ptr<wxGraphicsContext> graphics) override;
 
+    void UpdateMachine();
+
     bool HitTest(wxPoint pos) override;
 
+    /**
+     * Get a rectangle containing everything we can be clicked on.
+     * Machines can't be clicked on.
+     * @return An empty rectangle
+     */
+    wxRect GetPlacedBounds() override { return wxRect(); }
+
     void ShowMachineDialog(wxWindow * parent);
 
 
@@ -78,6 +91,11 @@ public:
      */
     int GetMachineStartFrame() const { return mStartFrame;}
 
+    std::shared_ptr<MachineCheckpoint> CreateCheckpoint();
+
+    void RestoreCheckpoint(std::shared_ptr<MachineCheckpoint> checkpoint);
+
+    void SetLookahead(int frames);
 
 };
 
@@ -0,0 +1,97 @@
+/**
+ * @file MachineUpdater.cpp
+ * @author Frederick Fan
+ */
+
+#include "pch.h"
+#include "MachineUpdater.h"
+#include "MachineDrawable.h"
+
+/**
+ * Destructor. Stops the worker threads.
+ */
+MachineUpdater::~MachineUpdater()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mCondition.notify_all();
+
+    for (auto &thread : mThreads)
+    {
+        thread.join();
+    }
+}
+
+/**
+ * Update all of the machines to the current frame, returning once
+ * every one is done. Only one thread may call this at a time.
+ * @param machines Machines to update
+ */
+void MachineUpdater::Update(const std::vector<std::shared_ptr<MachineDrawable>> &machines)
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    // Enough workers that every machine is updated at once
+    while (mThreads.size() + 1 < machines.size())
+    {
+        mThreads.push_back(std::thread(&MachineUpdater::Run, this));
+    }
+
+    mMachines = machines;
+    mNext = 0;
+    mRemaining = machines.size();
+    mCondition.notify_all();
+
+    while (UpdateNext(lock))
+    {
+    }
+
+    mDoneCondition.wait(lock, [this]() { return mRemaining == 0; });
+    mMachines.clear();
+}
+
+/**
+ * Update the next machine no one has started on, if there is one
+ * @param lock Lock on mMutex, which is released during the update
+ * @return false if every machine has been started on
+ */
+bool MachineUpdater::UpdateNext(std::unique_lock<std::mutex> &lock)
+{
+    if (mNext == mMachines.size())
+    {
+        return false;
+    }
+
+    auto machine = mMachines[mNext++];
+
+    lock.unlock();
+    machine->UpdateMachine();
+    lock.lock();
+
+    if (--mRemaining == 0)
+    {
+        mDoneCondition.notify_all();
+    }
+
+    return true;
+}
+
+/**
+ * The worker thread
+ */
+void MachineUpdater::Run()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true)
+    {
+        mCondition.wait(lock, [this]() { return mStop || mNext < mMachines.size(); });
+        if (mStop)
+        {
+            return;
+        }
+
+        UpdateNext(lock);
+    }
+}
@@ -0,0 +1,72 @@
+/**
+ * @file MachineUpdater.h
+ * @author Frederick Fan
+ *
+ * Advances the machines of a picture at the same time
+ */
+
+#ifndef CANADIANEXPERIENCE_CANADIANEXPERIENCELIB_MACHINEUPDATER_H
+#define CANADIANEXPERIENCE_CANADIANEXPERIENCELIB_MACHINEUPDATER_H
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class MachineDrawable;
+
+/**
+ * Advances the machines of a picture at the same time.
+ *
+ * Each machine has its own physics world, so they are independent.
+ * The worker threads are started the first time they are needed and
+ * then wait for the next update, so painting a frame never starts a
+ * thread. The calling thread updates machines too, so one machine
+ * needs no workers and two need one.
+ */
+class MachineUpdater
+{
+private:
+    /// Protects everything below
+    std::mutex mMutex;
+
+    /// Signalled when there are machines to update or we are stopped
+    std::condition_variable mCondition;
+
+    /// Signalled when the last machine of an update is done
+    std::condition_variable mDoneCondition;
+
+    /// Machines being updated
+    std::vector<std::shared_ptr<MachineDrawable>> mMachines;
+
+    /// Index in mMachines of the next machine to update
+    size_t mNext = 0;
+
+    /// Number of machines not finished yet
+    size_t mRemaining = 0;
+
+    /// Set to stop the worker threads
+    bool mStop = false;
+
+    /// The worker threads
+    std::vector<std::thread> mThreads;
+
+    bool UpdateNext(std::unique_lock<std::mutex> &lock);
+    void Run();
+
+public:
+    MachineUpdater() = default;
+
+    virtual ~MachineUpdater();
+
+    /// Copy constructor (disabled)
+    MachineUpdater(const MachineUpdater &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const MachineUpdater &) = delete;
+
+    void Update(const std::vector<std::shared_ptr<MachineDrawable>> &machines);
+};
+
+#endif //CANADIANEXPERIENCE_CANADIANEXPERIENCELIB_MACHINEUPDATER_H
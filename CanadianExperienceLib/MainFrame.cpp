@@ -6,6 +6,7 @@
 
 #include <wx/xrc/xmlres.h>
 #include <wx/stdpaths.h>
+#include <wx/progdlg.h>
 
 #include "MainFrame.h"
 
@@ -13,6 +14,8 @@
 #include "ViewTimeline.h"
 #include "Picture.h"
 #include "PictureFactory.h"
+#include "PictureExporter.h"
+#include <MachinePrototypes.h>
 
 /// Directory within resources that contains the images.
 const std::wstring ImagesDirectory = L"/images";
@@ -56,6 +59,7 @@ void MainFrame::Initialize()
     Bind(wxEVT_COMMAND_MENU_SELECTED, &MainFrame::OnExit, this, wxID_EXIT);
     Bind(wxEVT_COMMAND_MENU_SELECTED, &MainFrame::OnAbout, this, wxID_ABOUT);
     Bind(wxEVT_CLOSE_WINDOW, &MainFrame::OnClose, this);
+    Bind(wxEVT_COMMAND_MENU_SELECTED, &MainFrame::OnFileExportFrames, this, XRCID("FileExportFrames"));
 
     //
     // Create the picture
@@ -93,12 +97,67 @@ void MainFrame::OnAbout(wxCommandEvent& event)
 
 /**
  * Handle a close event. Stop the animation and destroy this window.
+ *
+ * The machine prototypes are released here, while wxWidgets can
+ * still free the images and bitmaps they hold.
  * @param event The Close event
  */
 void MainFrame::OnClose(wxCloseEvent& event)
 {
     mViewTimeline->Stop();
+    MachinePrototypes::Clear();
     Destroy();
 }
 
 
+/**
+ * File>Export Frames menu handler
+ *
+ * Renders every frame of the animation, without the window,
+ * to a PNG sequence or a Y4M video. The frames are encoded
+ * and written in parallel.
+ * @param event Menu event
+ */
+void MainFrame::OnFileExportFrames(wxCommandEvent& event)
+{
+    mViewTimeline->Stop();
+
+    wxFileDialog exportDialog(this, _("Export Frames"), "", "",
+            "PNG Image Sequence (*.png)|*.png|Y4M Video (*.y4m)|*.y4m", wxFD_SAVE|wxFD_OVERWRITE_PROMPT);
+    if (exportDialog.ShowModal() == wxID_CANCEL)
+    {
+        return;
+    }
+
+    PictureExporter exporter(mPicture, mResourcesDir);
+    exporter.SetFormat(exportDialog.GetFilterIndex() == 1 ? PictureExporter::Format::Y4M : PictureExporter::Format::PNG);
+
+    auto size = exporter.GetSize();
+    auto sizeText = wxGetTextFromUser(L"Frame size in pixels (width x height)", L"Export Frames",
+            wxString::Format(wxT("%ix%i"), size.GetWidth(), size.GetHeight()), this);
+    if (sizeText.IsEmpty())
+    {
+        return;
+    }
+
+    int width, height;
+    if (sscanf(sizeText.ToStdString().c_str(), "%d x %d", &width, &height) != 2 || width <= 0 || height <= 0)
+    {
+        wxMessageBox(L"Frame size must be given as width x height");
+        return;
+    }
+    exporter.SetSize(wxSize(width, height));
+
+    int frames = mPicture->GetTimeline()->GetNumFrames();
+    wxProgressDialog progressDialog(L"Export Frames", L"Rendering frames...", frames, this,
+            wxPD_APP_MODAL | wxPD_CAN_ABORT | wxPD_ELAPSED_TIME | wxPD_REMAINING_TIME);
+
+    bool ok = exporter.Export(exportDialog.GetPath(), [&progressDialog](int done, int total) {
+        return progressDialog.Update(std::min(done, total));
+    });
+
+    if (!ok && !progressDialog.WasCancelled())
+    {
+        wxMessageBox(L"Unable to export the frames");
+    }
+}
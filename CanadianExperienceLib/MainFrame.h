@@ -26,6 +26,7 @@ private:
     void OnExit(wxCommandEvent& event);
     void OnAbout(wxCommandEvent&);
     void OnClose(wxCloseEvent &event);
+    void OnFileExportFrames(wxCommandEvent& event);
 
     /// The resources directory to use
     std::wstring mResourcesDir;
@@ -0,0 +1,104 @@
+/**
+ * @file MappedFile.cpp
+ * @author Frederick Fan
+ */
+
+#include "pch.h"
+#include "MappedFile.h"
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Constructor
+ * @param filename File to map
+ */
+MappedFile::MappedFile(const wxString &filename)
+{
+#ifdef WIN32
+    auto file = CreateFileW(filename.wc_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return;
+    }
+    mFile = file;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+        return;
+    }
+
+    mMapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mMapping == nullptr)
+    {
+        return;
+    }
+
+    auto data = MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0);
+    if (data != nullptr)
+    {
+        mData = (const unsigned char *)data;
+        mSize = (size_t)size.QuadPart;
+    }
+#else
+    mFile = open(filename.fn_str(), O_RDONLY);
+    if (mFile < 0)
+    {
+        return;
+    }
+
+    struct stat status;
+    if (fstat(mFile, &status) != 0 || status.st_size == 0)
+    {
+        return;
+    }
+
+    auto data = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, mFile, 0);
+    if (data != MAP_FAILED)
+    {
+        mData = (const unsigned char *)data;
+        mSize = (size_t)status.st_size;
+    }
+#endif
+}
+
+/**
+ * Destructor
+ */
+MappedFile::~MappedFile()
+{
+#ifdef WIN32
+    if (mData != nullptr)
+    {
+        UnmapViewOfFile(mData);
+    }
+
+    if (mMapping != nullptr)
+    {
+        CloseHandle(mMapping);
+    }
+
+    if (mFile != nullptr)
+    {
+        CloseHandle(mFile);
+    }
+#else
+    if (mData != nullptr)
+    {
+        munmap((void *)mData, mSize);
+    }
+
+    if (mFile >= 0)
+    {
+        close(mFile);
+    }
+#endif
+}
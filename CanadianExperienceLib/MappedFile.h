@@ -0,0 +1,68 @@
+/**
+ * @file MappedFile.h
+ * @author Frederick Fan
+ *
+ * A file mapped into memory for reading
+ */
+
+#ifndef CANADIANEXPERIENCE_CANADIANEXPERIENCELIB_MAPPEDFILE_H
+#define CANADIANEXPERIENCE_CANADIANEXPERIENCELIB_MAPPEDFILE_H
+
+/**
+ * A file mapped into memory for reading.
+ *
+ * The contents are read by the operating system as they are
+ * touched, rather than copied into a buffer first. The mapping
+ * lasts as long as this object.
+ */
+class MappedFile
+{
+private:
+    /// The contents of the file, or nullptr if it is not mapped
+    const unsigned char *mData = nullptr;
+
+    /// Size of the file in bytes
+    size_t mSize = 0;
+
+#ifdef WIN32
+    /// The file handle
+    void *mFile = nullptr;
+
+    /// The file mapping handle
+    void *mMapping = nullptr;
+#else
+    /// The file descriptor
+    int mFile = -1;
+#endif
+
+public:
+    MappedFile(const wxString &filename);
+    virtual ~MappedFile();
+
+    /// Copy constructor (disabled)
+    MappedFile(const MappedFile &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const MappedFile &) = delete;
+
+    /**
+     * Is the file mapped? Files that do not exist or are
+     * empty are not.
+     * @return true if the contents can be read
+     */
+    bool IsOpen() const { return mData != nullptr; }
+
+    /**
+     * Get the contents of the file
+     * @return Pointer to the first byte
+     */
+    const unsigned char *GetData() const { return mData; }
+
+    /**
+     * Get the size of the file
+     * @return Size in bytes
+     */
+    size_t GetSize() const { return mSize; }
+};
+
+#endif //CANADIANEXPERIENCE_CANADIANEXPERIENCELIB_MAPPEDFILE_H
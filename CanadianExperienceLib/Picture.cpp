@@ -4,11 +4,15 @@
  */
 #include "pch.h"
 #include <wx/stdpaths.h>
+#include <wx/wfstream.h>
 
 #include "Picture.h"
 #include "PictureObserver.h"
 #include "Actor.h"
 #include "MachineDrawable.h"
+#include "Drawable.h"
+
+#include <algorithm>
 
 
 /**
@@ -85,12 +89,39 @@ void Picture::UpdateObservers()
  */
 void Picture::Draw(std::shared_ptr<wxGraphicsContext> graphics)
 {
+    UpdateMachines();
+
     for (auto actor : mActors)
     {
         actor->Draw(graphics);
     }
 }
 
+/**
+ * Advance all of the machines in the picture to the current frame.
+ *
+ * Each machine has its own physics world, so they are independent
+ * and are simulated at the same time by mMachineUpdater.
+ */
+void Picture::UpdateMachines()
+{
+    std::vector<std::shared_ptr<MachineDrawable>> machines;
+    for (auto machine : {mMachineOneDrawable, mMachineTwoDrawable})
+    {
+        if (machine != nullptr)
+        {
+            machines.push_back(machine);
+        }
+    }
+
+    if (machines.empty())
+    {
+        return;
+    }
+
+    mMachineUpdater.Update(machines);
+}
+
 /**
  * Add an actor to this drawable.
  * @param actor Actor to add
@@ -99,37 +130,138 @@ void Picture::AddActor(std::shared_ptr<Actor> actor)
 {
     mActors.push_back(actor);
     actor->SetPicture(this);
+
+    for (auto drawable : actor->GetDrawables())
+    {
+        DrawableAdded(actor.get(), drawable);
+    }
+}
+
+
+/**
+ * Find the drawable at a point in the picture.
+ *
+ * Only the drawables whose placed bounds contain the point are
+ * hit tested. Of those, the one drawn last is the one on top.
+ * @param pos Position in the picture
+ * @param actor Receives the actor the drawable is part of
+ * @return The drawable, or nullptr if there is none at the point
+ */
+std::shared_ptr<Drawable> Picture::HitTest(wxPoint pos, std::shared_ptr<Actor> &actor)
+{
+    mHitGrid.Query(pos, mHitCandidates);
+
+    // Actors are drawn in order, and each draws its drawables in order
+    std::sort(mHitCandidates.begin(), mHitCandidates.end(), [this](int a, int b) {
+        auto &entryA = mHitEntries[a];
+        auto &entryB = mHitEntries[b];
+        return entryA.mActor != entryB.mActor ? entryA.mActor > entryB.mActor : entryA.mOrder > entryB.mOrder;
+    });
+
+    for (auto id : mHitCandidates)
+    {
+        auto &entry = mHitEntries[id];
+        auto &candidate = mActors[entry.mActor];
+        if (candidate->IsClickable() && candidate->IsEnabled() && entry.mDrawable->HitTest(pos))
+        {
+            actor = candidate;
+            return entry.mDrawable;
+        }
+    }
+
+    return nullptr;
+}
+
+
+/**
+ * Add a drawable of an actor in this picture to the hit grid
+ * @param actor The actor
+ * @param drawable The drawable, already added to the actor
+ */
+void Picture::DrawableAdded(Actor *actor, std::shared_ptr<Drawable> drawable)
+{
+    HitEntry entry;
+    entry.mActor = 0;
+    while (mActors[entry.mActor].get() != actor)
+    {
+        entry.mActor++;
+    }
+
+    entry.mOrder = (int)actor->GetDrawables().size() - 1;
+    while (actor->GetDrawables()[entry.mOrder] != drawable)
+    {
+        entry.mOrder--;
+    }
+
+    entry.mDrawable = drawable;
+
+    mHitIds[drawable.get()] = mHitGrid.Add(drawable->GetPlacedBounds());
+    mHitEntries.push_back(entry);
+}
+
+
+/**
+ * Indicate a drawable has been placed somewhere new,
+ * so it is moved in the hit grid
+ * @param drawable The drawable
+ */
+void Picture::DrawableMoved(Drawable *drawable)
+{
+    auto found = mHitIds.find(drawable);
+    if (found != mHitIds.end())
+    {
+        mHitGrid.Move(found->second, drawable->GetPlacedBounds());
+    }
 }
 
 
 /**
 * Save the picture animation to a file
+*
+* Files with the binary animation extension are saved in
+* the binary format, any others as XML.
 * @param filename File to save to.
 */
 void Picture::Save(const wxString& filename)
 {
+    if(AnimFile::IsBinaryFilename(filename))
+    {
+        if(!AnimFile::Save(filename, mTimeline, GetAttributes()))
+        {
+            wxMessageBox(L"Write to binary animation file failed");
+        }
+        return;
+    }
+
     wxXmlDocument xmlDoc;
 
     auto root = new wxXmlNode(wxXML_ELEMENT_NODE, L"anim");
     xmlDoc.SetRoot(root);
 
+    XmlSave(root);
+
+    if(!xmlDoc.Save(filename, wxXML_NO_INDENTATION))
+    {
+        wxMessageBox(L"Write to XML failed");
+        return;
+    }
+}
+
+/**
+ * Save the picture animation into an XML node
+ * @param root The anim node to save into
+ */
+void Picture::XmlSave(wxXmlNode* root)
+{
     // Save the timeline animation into the XML
     mTimeline.Save(root);
 
     //
-    // It is possible to add attributes to the root node here
+    // The attributes are saved as attributes of the root node
     //
-    //root->AddAttribute(L"something", mSomething);
-    root->AddAttribute(L"MachineOneId", wxString::Format(wxT("%i"), mMachineOneDrawable->GetMachineId()));
-    root->AddAttribute(L"MachineTwoId", wxString::Format(wxT("%i"), mMachineTwoDrawable->GetMachineId()));
-    root->AddAttribute(L"MachineOneAnimationStart", wxString::Format(wxT("%i"), mMachineOneDrawable->GetMachineStartFrame()));
-    root->AddAttribute(L"MachineTwoAnimationStart", wxString::Format(wxT("%i"), mMachineTwoDrawable->GetMachineStartFrame()));
-
-
-    if(!xmlDoc.Save(filename, wxXML_NO_INDENTATION))
+    for(auto &attribute : GetAttributes())
     {
-        wxMessageBox(L"Write to XML failed");
-        return;
+        root->AddAttribute(attribute.first, wxString::Format(wxT("%i"), attribute.second));
     }
 }
 
@@ -137,34 +269,123 @@ void Picture::Save(const wxString& filename)
 
 /**
 * Load a picture animation from a file
+*
+* The file may be XML or the binary format, whatever its name.
+* A file that can't be loaded leaves the animation as it was.
 * @param filename file to load from
 */
 void Picture::Load(const wxString& filename)
 {
-    wxXmlDocument xmlDoc;
-    if(!xmlDoc.Load(filename))
+    if(AnimFile::IsAnimFile(filename))
     {
-        wxMessageBox(L"Unable to load Animation file");
-        return;
+        AnimFile::Attributes attributes;
+        if(!AnimFile::Load(filename, mTimeline, attributes))
+        {
+            wxMessageBox(L"Unable to load Animation file");
+            return;
+        }
+
+        SetAttributes(attributes);
     }
+    else
+    {
+        // Animations can be very large, so the XML is
+        // loaded as it is read rather than all at once
+        wxFileInputStream stream(filename);
+        wxXmlNode root(wxXML_ELEMENT_NODE, L"anim");
+        if(!stream.IsOk() || !mTimeline.Load(stream, &root))
+        {
+            wxMessageBox(L"Unable to load Animation file");
+            return;
+        }
 
-    // Get the XML document root node
-    auto root = xmlDoc.GetRoot();
+        XmlLoadAttributes(&root);
+    }
+
+    SetAnimationTime(0);
+    UpdateObservers();
+}
 
+/**
+ * Load the picture animation from an XML node
+ * @param root The anim node to load from
+ */
+void Picture::XmlLoad(wxXmlNode* root)
+{
     // Load the animation from the XML
     mTimeline.Load(root);
 
-    //
-    // It is possible to load attributes from the root node here
-    //
-    // mSomething = root->GetAttribute(L"something", L"default");
+    XmlLoadAttributes(root);
+}
 
-    mMachineOneDrawable->SetMachineID(wxAtoi(root->GetAttribute(L"MachineOneId", L"1")));
-    mMachineTwoDrawable->SetMachineID(wxAtoi(root->GetAttribute(L"MachineTwoId", L"2")));
-    mMachineOneDrawable->SetStartFrame(wxAtoi(root->GetAttribute(L"MachineOneAnimationStart", L"0")));
-    mMachineTwoDrawable->SetStartFrame(wxAtoi(root->GetAttribute(L"MachineTwoAnimationStart", L"0")));
+/**
+ * Load the values saved with the animation from
+ * the attributes of the XML root node
+ * @param root The anim node to load from
+ */
+void Picture::XmlLoadAttributes(wxXmlNode* root)
+{
+    AnimFile::Attributes attributes;
+    for(auto attribute = root->GetAttributes(); attribute; attribute = attribute->GetNext())
+    {
+        attributes[attribute->GetName().ToStdWstring()] = wxAtoi(attribute->GetValue());
+    }
 
-    SetAnimationTime(0);
-    UpdateObservers();
+    SetAttributes(attributes);
+}
+
+/**
+ * Get the values saved with the animation, other than the timeline
+ * @return Attributes to save
+ */
+AnimFile::Attributes Picture::GetAttributes()
+{
+    AnimFile::Attributes attributes;
+    attributes[L"MachineOneId"] = mMachineOneDrawable->GetMachineId();
+    attributes[L"MachineTwoId"] = mMachineTwoDrawable->GetMachineId();
+    attributes[L"MachineOneAnimationStart"] = mMachineOneDrawable->GetMachineStartFrame();
+    attributes[L"MachineTwoAnimationStart"] = mMachineTwoDrawable->GetMachineStartFrame();
+    return attributes;
+}
+
+/**
+ * Set the values saved with the animation, other than the timeline.
+ * Any that are missing get their defaults.
+ * @param attributes Attributes that were loaded
+ */
+void Picture::SetAttributes(const AnimFile::Attributes &attributes)
+{
+    auto get = [&attributes](const std::wstring &name, int value) {
+        auto found = attributes.find(name);
+        return found != attributes.end() ? found->second : value;
+    };
+
+    mMachineOneDrawable->SetMachineID(get(L"MachineOneId", 1));
+    mMachineTwoDrawable->SetMachineID(get(L"MachineTwoId", 2));
+    mMachineOneDrawable->SetStartFrame(get(L"MachineOneAnimationStart", 0));
+    mMachineTwoDrawable->SetStartFrame(get(L"MachineTwoAnimationStart", 0));
 }
 
+/**
+ * Make this picture a copy of another picture built by the same factory.
+ *
+ * The animation is copied through XML, the same way it is saved,
+ * and the current pose of every actor is copied so parts that have
+ * no keyframes end up where they are in the other picture.
+ * @param other Picture to copy
+ */
+void Picture::CopyFrom(Picture* other)
+{
+    mSize = other->mSize;
+
+    wxXmlNode root(wxXML_ELEMENT_NODE, L"anim");
+    other->XmlSave(&root);
+    XmlLoad(&root);
+
+    for (size_t i = 0; i < mActors.size() && i < other->mActors.size(); i++)
+    {
+        mActors[i]->CopyPose(*other->mActors[i]);
+    }
+
+    SetAnimationTime(other->GetAnimationTime());
+}
@@ -9,10 +9,14 @@
 #pragma once
 
 #include "Timeline.h"
+#include "AnimFile.h"
+#include "SpatialGrid.h"
+#include "MachineUpdater.h"
 
 class PictureObserver;
 class Actor;
 class MachineDrawable;
+class Drawable;
 
 
 /**
@@ -39,7 +43,37 @@ private:
     ///The machine two drawable object that is in the picture
     std::shared_ptr<MachineDrawable> mMachineTwoDrawable = nullptr;
 
+    /// Advances the machines at the same time
+    MachineUpdater mMachineUpdater;
 
+    /// A drawable in the hit grid
+    struct HitEntry
+    {
+        /// Index of the actor in mActors
+        int mActor;
+
+        /// Index of the drawable in the actor's drawing order
+        int mOrder;
+
+        /// The drawable
+        std::shared_ptr<Drawable> mDrawable;
+    };
+
+    /// The placed bounds of every drawable, for finding what was clicked on
+    SpatialGrid mHitGrid;
+
+    /// The drawable for each ID in mHitGrid
+    std::vector<HitEntry> mHitEntries;
+
+    /// The ID in mHitGrid of each drawable
+    std::unordered_map<Drawable *, int> mHitIds;
+
+    /// The IDs found by the last query of mHitGrid
+    std::vector<int> mHitCandidates;
+
+    AnimFile::Attributes GetAttributes();
+    void SetAttributes(const AnimFile::Attributes &attributes);
+    void XmlLoadAttributes(wxXmlNode* root);
 
 public:
     Picture();
@@ -76,9 +110,14 @@ public:
     void RemoveObserver(PictureObserver *observer);
     void UpdateObservers();
     void Draw(std::shared_ptr<wxGraphicsContext> graphics);
+    void UpdateMachines();
 
     void AddActor(std::shared_ptr<Actor> actor);
 
+    std::shared_ptr<Drawable> HitTest(wxPoint pos, std::shared_ptr<Actor> &actor);
+    void DrawableAdded(Actor *actor, std::shared_ptr<Drawable> drawable);
+    void DrawableMoved(Drawable *drawable);
+
     /** Iterator that iterates over the actors in a picture */
     class ActorIter
     {
@@ -140,6 +179,12 @@ public:
 
     void Save(const wxString& filename);
 
+    void XmlSave(wxXmlNode* root);
+
+    void XmlLoad(wxXmlNode* root);
+
+    void CopyFrom(Picture* other);
+
     /**
      * Set the machine one drawable for the picture
      * @param machine the machine to set to
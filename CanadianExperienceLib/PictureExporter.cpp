@@ -0,0 +1,366 @@
+/**
+ * @file PictureExporter.cpp
+ * @author Frederick Fan
+ */
+
+#include "pch.h"
+#include "PictureExporter.h"
+#include "Picture.h"
+#include "PictureFactory.h"
+#include "MachineDrawable.h"
+
+#include <wx/filename.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+/// Y4M frame marker that starts every frame
+const std::string Y4mFrameMarker = "FRAME\n";
+
+/**
+ * Constructor
+ * @param picture The picture to export
+ * @param resourcesDir The resources directory the picture was built from
+ */
+PictureExporter::PictureExporter(std::shared_ptr<Picture> picture, std::wstring resourcesDir) :
+    mPicture(picture), mResourcesDir(std::move(resourcesDir))
+{
+    mSize = mPicture->GetSize();
+}
+
+/**
+ * Export every frame of the timeline.
+ *
+ * For PNG, each frame is written to its own file, named by adding
+ * the frame number to the filename. For Y4M, all of the frames are
+ * written to the one file. Every Y4M frame is the same size, so each
+ * thread writes its frames straight to their place in the file.
+ *
+ * The frames are drawn on this thread in order and only encoded and
+ * written on the other threads, so the output is the same whatever
+ * the number of threads.
+ * @param filename File to write
+ * @param progress Function called on this thread with the progress, or nullptr
+ * @return true if every frame was written, false if writing failed or the export was cancelled
+ */
+bool PictureExporter::Export(const wxString &filename, Progress progress)
+{
+    auto timeline = mPicture->GetTimeline();
+    int frames = timeline->GetNumFrames();
+    int frameRate = timeline->GetFrameRate();
+    if(frames <= 0 || frameRate <= 0 || mSize.GetWidth() <= 0 || mSize.GetHeight() <= 0)
+    {
+        return false;
+    }
+
+    int threadCount = mThreadCount;
+    if(threadCount <= 0)
+    {
+        threadCount = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+
+    if(mFormat == Format::Y4M)
+    {
+        std::ofstream file(filename.fn_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        file << GetY4mHeader(mSize, frameRate);
+        if(!file)
+        {
+            return false;
+        }
+    }
+
+    // The copy is built before the threads start, since building it loads images
+    auto picture = CreateCopy();
+
+    /// A drawn frame waiting to be written
+    struct Frame
+    {
+        /// Frame number
+        int mFrame = 0;
+
+        /// RGB pixels, in the layout of wxImage::GetData
+        std::vector<unsigned char> mPixels;
+    };
+
+    // Frames waiting to be written. The queue is kept short
+    // so drawing can't get far ahead of writing.
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<Frame> queue;
+    size_t queueLimit = (size_t)threadCount * 2;
+    bool drawn = false;
+
+    std::atomic<int> done(0);
+    std::atomic<bool> failed(false);
+    bool cancelled = false;
+
+    auto writer = [&]() {
+        std::fstream file;
+        size_t headerSize = GetY4mHeader(mSize, frameRate).size();
+        size_t frameSize = GetY4mFrameSize(mSize);
+        std::vector<unsigned char> buffer;
+        if(mFormat == Format::Y4M)
+        {
+            file.open(filename.fn_str(), std::ios::in | std::ios::out | std::ios::binary);
+        }
+
+        while(true)
+        {
+            Frame frame;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                condition.wait(lock, [&]() { return drawn || !queue.empty(); });
+                if(queue.empty())
+                {
+                    break;
+                }
+
+                frame = std::move(queue.front());
+                queue.pop_front();
+            }
+            condition.notify_all();
+
+            if(failed)
+            {
+                continue;
+            }
+
+            // The image only refers to this thread's pixels, so
+            // it shares nothing with any other thread
+            wxImage image(mSize.GetWidth(), mSize.GetHeight(), frame.mPixels.data(), true);
+
+            bool ok;
+            if(mFormat == Format::Y4M)
+            {
+                ConvertY4m(image, buffer);
+                file.seekp(headerSize + frame.mFrame * frameSize);
+                file.write((const char *)buffer.data(), buffer.size());
+                file.flush();
+                ok = !file.fail();
+            }
+            else
+            {
+                ok = image.SaveFile(GetFrameFilename(filename, frame.mFrame), wxBITMAP_TYPE_PNG);
+            }
+
+            if(!ok)
+            {
+                failed = true;
+            }
+            done++;
+        }
+    };
+
+    std::vector<std::thread> writers;
+    for(int i=0; i<threadCount; i++)
+    {
+        writers.push_back(std::thread(writer));
+    }
+
+    //
+    // Play the picture through the timeline on this thread,
+    // drawing each frame and queueing it to be written
+    //
+    wxImage image(mSize);
+    size_t pixelCount = (size_t)mSize.GetWidth() * mSize.GetHeight() * 3;
+    for(int frame = 0; frame < frames && !cancelled && !failed; frame++)
+    {
+        picture->SetAnimationTime(frame / (double)frameRate);
+        RenderFrame(picture.get(), image);
+
+        Frame drawnFrame;
+        drawnFrame.mFrame = frame;
+        drawnFrame.mPixels.assign(image.GetData(), image.GetData() + pixelCount);
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [&]() { return queue.size() < queueLimit; });
+            queue.push_back(std::move(drawnFrame));
+        }
+        condition.notify_all();
+
+        if(progress != nullptr && !progress(done, frames))
+        {
+            cancelled = true;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        drawn = true;
+    }
+    condition.notify_all();
+
+    for(auto &thread : writers)
+    {
+        thread.join();
+    }
+
+    if(progress != nullptr && !progress(done, frames))
+    {
+        cancelled = true;
+    }
+
+    return !cancelled && !failed;
+}
+
+/**
+ * Create a copy of the picture to render
+ * @return New picture with the same animation as the picture being exported
+ */
+std::shared_ptr<Picture> PictureExporter::CreateCopy()
+{
+    PictureFactory factory;
+    auto picture = factory.Create(mResourcesDir);
+
+    // The copy is only ever stepped forward, frame by frame,
+    // so simulating ahead in the background would only compete
+    // with the threads writing the frames.
+    for(auto machine : GetMachines(picture.get()))
+    {
+        machine->SetLookahead(0);
+    }
+
+    picture->CopyFrom(mPicture.get());
+    return picture;
+}
+
+/**
+ * Render the current frame of a picture into an image
+ * @param picture Picture to render
+ * @param image Image to render into, the size of the exported frames
+ */
+void PictureExporter::RenderFrame(Picture *picture, wxImage &image)
+{
+    image.SetRGB(wxRect(mSize), 255, 255, 255);
+
+    auto pictureSize = picture->GetSize();
+
+    // The image receives the drawing when the context is destroyed
+    auto graphics = std::shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create(image));
+    graphics->Scale((double)mSize.GetWidth() / pictureSize.GetWidth(),
+                    (double)mSize.GetHeight() / pictureSize.GetHeight());
+    picture->Draw(graphics);
+}
+
+/**
+ * Get the machine drawables of a picture
+ * @param picture Picture to get the machines of
+ * @return Machine drawables, always in the same order
+ */
+std::vector<std::shared_ptr<MachineDrawable>> PictureExporter::GetMachines(Picture *picture)
+{
+    std::vector<std::shared_ptr<MachineDrawable>> machines;
+    for(auto machine : {picture->GetMachineOneDrawable(), picture->GetMachineTwoDrawable()})
+    {
+        if(machine != nullptr)
+        {
+            machines.push_back(machine);
+        }
+    }
+
+    return machines;
+}
+
+/**
+ * Get the filename a frame of a PNG sequence is written to
+ * @param filename Filename chosen for the sequence
+ * @param frame Frame number
+ * @return Filename with the frame number added to the name
+ */
+wxString PictureExporter::GetFrameFilename(const wxString &filename, int frame)
+{
+    wxFileName name(filename);
+    name.SetName(name.GetName() + wxString::Format(wxT("%05d"), frame));
+    name.SetExt(L"png");
+    return name.GetFullPath();
+}
+
+/**
+ * Get the header of a Y4M file
+ * @param size Frame size in pixels
+ * @param frameRate Frame rate in frames per second
+ * @return Header text
+ */
+std::string PictureExporter::GetY4mHeader(wxSize size, int frameRate)
+{
+    return wxString::Format(wxT("YUV4MPEG2 W%i H%i F%i:1 Ip A1:1 C420jpeg\n"),
+            size.GetWidth(), size.GetHeight(), frameRate).ToStdString();
+}
+
+/**
+ * Get the size of one frame in a Y4M file
+ * @param size Frame size in pixels
+ * @return Size in bytes, including the frame marker
+ */
+size_t PictureExporter::GetY4mFrameSize(wxSize size)
+{
+    size_t luma = (size_t)size.GetWidth() * size.GetHeight();
+    size_t chroma = (size_t)((size.GetWidth() + 1) / 2) * ((size.GetHeight() + 1) / 2);
+    return Y4mFrameMarker.size() + luma + chroma * 2;
+}
+
+/**
+ * Convert an image to a Y4M frame.
+ *
+ * The frame is full range 4:2:0, with each chroma sample the
+ * average of a 2x2 block of pixels, as JPEG does it.
+ * @param image Image to convert
+ * @param frame Receives the frame, starting with the frame marker
+ */
+void PictureExporter::ConvertY4m(const wxImage &image, std::vector<unsigned char> &frame)
+{
+    int width = image.GetWidth();
+    int height = image.GetHeight();
+    int chromaWidth = (width + 1) / 2;
+    int chromaHeight = (height + 1) / 2;
+
+    frame.resize(GetY4mFrameSize(wxSize(width, height)));
+    std::copy(Y4mFrameMarker.begin(), Y4mFrameMarker.end(), frame.begin());
+
+    auto luma = frame.data() + Y4mFrameMarker.size();
+    auto cb = luma + (size_t)width * height;
+    auto cr = cb + (size_t)chromaWidth * chromaHeight;
+
+    const unsigned char *rgb = image.GetData();
+    for(int i=0; i<width * height; i++)
+    {
+        int r = rgb[i * 3];
+        int g = rgb[i * 3 + 1];
+        int b = rgb[i * 3 + 2];
+        luma[i] = (unsigned char)((77 * r + 150 * g + 29 * b + 128) >> 8);
+    }
+
+    for(int cy=0; cy<chromaHeight; cy++)
+    {
+        for(int cx=0; cx<chromaWidth; cx++)
+        {
+            int r = 0, g = 0, b = 0, count = 0;
+            for(int y = cy * 2; y < cy * 2 + 2 && y < height; y++)
+            {
+                for(int x = cx * 2; x < cx * 2 + 2 && x < width; x++)
+                {
+                    auto pixel = rgb + ((size_t)y * width + x) * 3;
+                    r += pixel[0];
+                    g += pixel[1];
+                    b += pixel[2];
+                    count++;
+                }
+            }
+
+            r /= count;
+            g /= count;
+            b /= count;
+
+            // Offset by 128 << 8 so the sums are never negative
+            size_t i = (size_t)cy * chromaWidth + cx;
+            cb[i] = (unsigned char)std::min(255, (-43 * r - 85 * g + 128 * b + 32896) >> 8);
+            cr[i] = (unsigned char)std::min(255, (128 * r - 107 * g - 21 * b + 32896) >> 8);
+        }
+    }
+}
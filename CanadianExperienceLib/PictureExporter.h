@@ -0,0 +1,112 @@
+/**
+ * @file PictureExporter.h
+ * @author Frederick Fan
+ *
+ * Renders every frame of a picture to an image sequence
+ */
+
+#ifndef CANADIANEXPERIENCE_CANADIANEXPERIENCELIB_PICTUREEXPORTER_H
+#define CANADIANEXPERIENCE_CANADIANEXPERIENCELIB_PICTUREEXPORTER_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+class Picture;
+class MachineDrawable;
+
+/**
+ * Renders every frame of a picture to an image sequence.
+ *
+ * The frames are drawn into an image in memory, so no window is
+ * involved. Drawing uses wx objects that every copy of the picture
+ * shares, such as the cached images and brushes, and those are not
+ * thread safe. The frames are therefore all drawn on the calling
+ * thread, by one copy of the picture that plays through the timeline
+ * in order, so the machines are simulated by one continuous run.
+ *
+ * Encoding and writing the frames is the slow part, and that is
+ * done in parallel. Each drawn frame is copied out as plain pixels
+ * and queued for a pool of threads that encode and write it.
+ */
+class PictureExporter
+{
+public:
+    /// Output formats
+    enum class Format {PNG, Y4M};
+
+    /**
+     * Function called with the number of frames done and the total
+     * number of frames. Returning false cancels the export.
+     */
+    typedef std::function<bool(int done, int total)> Progress;
+
+private:
+    /// The picture to export
+    std::shared_ptr<Picture> mPicture;
+
+    /// The resources directory the picture was built from
+    std::wstring mResourcesDir;
+
+    /// Size of the exported frames in pixels
+    wxSize mSize;
+
+    /// Output format
+    Format mFormat = Format::PNG;
+
+    /// Number of threads to write frames on, 0 for one per hardware thread
+    int mThreadCount = 0;
+
+    std::shared_ptr<Picture> CreateCopy();
+
+    void RenderFrame(Picture *picture, wxImage &image);
+
+    static std::vector<std::shared_ptr<MachineDrawable>> GetMachines(Picture *picture);
+
+public:
+    PictureExporter(std::shared_ptr<Picture> picture, std::wstring resourcesDir);
+
+    /// Copy constructor (disabled)
+    PictureExporter(const PictureExporter &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const PictureExporter &) = delete;
+
+    /**
+     * Set the size of the exported frames. The picture is
+     * scaled to fill the frame.
+     * @param size Size in pixels
+     */
+    void SetSize(wxSize size) { mSize = size; }
+
+    /**
+     * Get the size of the exported frames
+     * @return Size in pixels
+     */
+    wxSize GetSize() const { return mSize; }
+
+    /**
+     * Set the output format
+     * @param format Format to write
+     */
+    void SetFormat(Format format) { mFormat = format; }
+
+    /**
+     * Set the number of threads to encode and write the frames on
+     * @param count Number of threads, 0 for one per hardware thread
+     */
+    void SetThreadCount(int count) { mThreadCount = count; }
+
+    bool Export(const wxString &filename, Progress progress = nullptr);
+
+    static wxString GetFrameFilename(const wxString &filename, int frame);
+
+    static std::string GetY4mHeader(wxSize size, int frameRate);
+
+    static size_t GetY4mFrameSize(wxSize size);
+
+    static void ConvertY4m(const wxImage &image, std::vector<unsigned char> &frame);
+};
+
+#endif //CANADIANEXPERIENCE_CANADIANEXPERIENCELIB_PICTUREEXPORTER_H
@@ -6,6 +6,8 @@
 #include "pch.h"
 #include "PolyDrawable.h"
 
+#include <algorithm>
+
 /**
  * Constructor
  * @param name The drawable name
@@ -23,10 +25,10 @@ void PolyDrawable::Draw(std::shared_ptr<wxGraphicsContext> graphics)
     if(!mPoints.empty()) {
 
         mPath = graphics->CreatePath();
-        mPath.MoveToPoint(RotatePoint(mPoints[0], mPlacedR) + mPlacedPosition);
+        mPath.MoveToPoint(PlacePoint(mPoints[0]));
         for (auto i = 1; i<mPoints.size(); i++)
         {
-            mPath.AddLineToPoint(RotatePoint(mPoints[i], mPlacedR) + mPlacedPosition);
+            mPath.AddLineToPoint(PlacePoint(mPoints[i]));
         }
         mPath.CloseSubpath();
 
@@ -61,6 +63,31 @@ bool PolyDrawable::HitTest(wxPoint pos)
 }
 
 
+/**
+ * Get a rectangle in the drawing that contains the polygon
+ * @return Rectangle in the drawing, as of when we were last placed
+ */
+wxRect PolyDrawable::GetPlacedBounds()
+{
+    if (mPoints.empty())
+    {
+        return wxRect();
+    }
+
+    int left = mPoints[0].x, right = mPoints[0].x;
+    int top = mPoints[0].y, bottom = mPoints[0].y;
+    for (auto point : mPoints)
+    {
+        left = std::min(left, point.x);
+        right = std::max(right, point.x);
+        top = std::min(top, point.y);
+        bottom = std::max(bottom, point.y);
+    }
+
+    return PlaceBounds(left, top, right, bottom);
+}
+
+
 /**
  * Add a point to the polygon
  * @param point Point to add
@@ -43,6 +43,7 @@ public:
 
     void Draw(std::shared_ptr<wxGraphicsContext> graphics) override;
     bool HitTest(wxPoint pos) override;
+    wxRect GetPlacedBounds() override;
 
     void AddPoint(wxPoint point);
 
@@ -5,6 +5,7 @@
 
 #include "pch.h"
 #include "RotatedBitmap.h"
+#include <ImageCache.h>
 
 
 
@@ -14,8 +15,8 @@
  */
 void RotatedBitmap::LoadImage(const std::wstring &filename)
 {
-    mImage = std::make_unique<wxImage>(filename, wxBITMAP_TYPE_ANY);
-    mLoaded = true;
+    mImage = ImageCache::Load(filename);
+    mLoaded = mImage != nullptr;
 }
 
 
@@ -29,14 +30,17 @@ void RotatedBitmap::DrawImage(std::shared_ptr<wxGraphicsContext> graphics, wxPoi
 {
     if(!mBitmapCreated)
     {
-        mBitmap = graphics->CreateBitmapFromImage(*mImage);
+        mBitmap = mImage->GetBitmap(graphics);
+        mBitmapCreated = true;
     }
 
+    auto &image = mImage->GetImage();
+
     graphics->PushState();
     graphics->Translate(position.x, position.y);
     graphics->Rotate(-angle);
     graphics->DrawBitmap(mBitmap, -mCenter.x, -mCenter.y,
-            mImage->GetWidth(), mImage->GetHeight());
+            image.GetWidth(), image.GetHeight());
 
     graphics->PopState();
 }
\ No newline at end of file
@@ -8,13 +8,16 @@
 #ifndef CANADIANEXPERIENCE_ROTATEDBITMAP_H
 #define CANADIANEXPERIENCE_ROTATEDBITMAP_H
 
+class SharedImage;
+
 /**
  * Basic class for displaying a rotated bitmap
  */
 class RotatedBitmap {
 private:
-    /// The image for this drawable
-    std::unique_ptr<wxImage> mImage;
+    /// The image for this drawable, shared with
+    /// every other user of the same image file
+    std::shared_ptr<SharedImage> mImage;
 
     /// The graphics bitmap we will use
     wxGraphicsBitmap mBitmap;
@@ -0,0 +1,234 @@
+/**
+ * @file SpatialGrid.cpp
+ * @author Frederick Fan
+ */
+
+#include "pch.h"
+#include "SpatialGrid.h"
+
+#include <algorithm>
+
+/// Rectangles that cover more than this many cells are not put in cells
+const long long MaxCells = 64;
+
+/**
+ * Constructor
+ * @param cellSize Size of a cell in pixels
+ */
+SpatialGrid::SpatialGrid(int cellSize) : mCellSize(cellSize)
+{
+}
+
+/**
+ * Add a rectangle to the grid
+ * @param bounds The rectangle. An empty rectangle contains no points.
+ * @return The ID of the rectangle
+ */
+int SpatialGrid::Add(const wxRect &bounds)
+{
+    int id = (int)mEntries.size();
+    mEntries.push_back(Entry());
+    mEntries.back().mBounds = bounds;
+    Insert(id);
+    return id;
+}
+
+/**
+ * Move a rectangle in the grid.
+ *
+ * Only the cells the rectangle has moved into or out of are
+ * changed. A rectangle that moves into or out of the list of
+ * large rectangles is taken out and put back in.
+ * @param id ID of the rectangle
+ * @param bounds The new rectangle
+ */
+void SpatialGrid::Move(int id, const wxRect &bounds)
+{
+    auto &entry = mEntries[id];
+
+    Entry moved;
+    moved.mBounds = bounds;
+    SetCells(moved);
+
+    if (entry.mLarge || moved.mLarge)
+    {
+        Remove(id);
+        entry.mBounds = bounds;
+        Insert(id);
+        return;
+    }
+
+    // Leave the cells only the old rectangle is in
+    for (int y = entry.mTop; y <= entry.mBottom; y++)
+    {
+        for (int x = entry.mLeft; x <= entry.mRight; x++)
+        {
+            if (!moved.Covers(x, y))
+            {
+                RemoveFromCell(id, x, y);
+            }
+        }
+    }
+
+    // Enter the cells only the new rectangle is in
+    for (int y = moved.mTop; y <= moved.mBottom; y++)
+    {
+        for (int x = moved.mLeft; x <= moved.mRight; x++)
+        {
+            if (!entry.Covers(x, y))
+            {
+                mCells[CellKey(x, y)].push_back(id);
+            }
+        }
+    }
+
+    entry = moved;
+}
+
+/**
+ * Remove every rectangle from the grid
+ */
+void SpatialGrid::Clear()
+{
+    mEntries.clear();
+    mCells.clear();
+    mLarge.clear();
+}
+
+/**
+ * Find the rectangles that contain a point
+ * @param pos The point
+ * @param ids Receives the IDs of the rectangles, in no particular order
+ */
+void SpatialGrid::Query(wxPoint pos, std::vector<int> &ids) const
+{
+    ids.clear();
+
+    auto cell = mCells.find(CellKey(CellOf(pos.x), CellOf(pos.y)));
+    if (cell != mCells.end())
+    {
+        for (auto id : cell->second)
+        {
+            if (mEntries[id].mBounds.Contains(pos))
+            {
+                ids.push_back(id);
+            }
+        }
+    }
+
+    for (auto id : mLarge)
+    {
+        if (mEntries[id].mBounds.Contains(pos))
+        {
+            ids.push_back(id);
+        }
+    }
+}
+
+/**
+ * Get the cell a coordinate is in
+ * @param coordinate X or Y coordinate in pixels
+ * @return Cell column or row
+ */
+int SpatialGrid::CellOf(int coordinate) const
+{
+    // Round down, so negative coordinates get their own cells
+    return coordinate >= 0 ? coordinate / mCellSize : -((-coordinate - 1) / mCellSize) - 1;
+}
+
+/**
+ * Get the key a cell is stored under
+ * @param x Cell column
+ * @param y Cell row
+ * @return Key for mCells
+ */
+long long SpatialGrid::CellKey(int x, int y)
+{
+    return (long long)(((unsigned long long)(unsigned int)x << 32) | (unsigned int)y);
+}
+
+/**
+ * Set the range of cells a rectangle is in from its bounds, and
+ * whether it covers too many cells to be put in them
+ * @param entry The rectangle
+ */
+void SpatialGrid::SetCells(Entry &entry) const
+{
+    entry.mLarge = false;
+    entry.mLeft = entry.mTop = 0;
+    entry.mRight = entry.mBottom = -1;
+    if (entry.mBounds.IsEmpty())
+    {
+        return;
+    }
+
+    entry.mLeft = CellOf(entry.mBounds.GetLeft());
+    entry.mTop = CellOf(entry.mBounds.GetTop());
+    entry.mRight = CellOf(entry.mBounds.GetRight());
+    entry.mBottom = CellOf(entry.mBounds.GetBottom());
+
+    long long cells = ((long long)entry.mRight - entry.mLeft + 1) * ((long long)entry.mBottom - entry.mTop + 1);
+    entry.mLarge = cells > MaxCells;
+}
+
+/**
+ * Put a rectangle into the cells it overlaps
+ * @param id ID of the rectangle
+ */
+void SpatialGrid::Insert(int id)
+{
+    auto &entry = mEntries[id];
+    SetCells(entry);
+    if (entry.mLarge)
+    {
+        mLarge.push_back(id);
+        return;
+    }
+
+    for (int y = entry.mTop; y <= entry.mBottom; y++)
+    {
+        for (int x = entry.mLeft; x <= entry.mRight; x++)
+        {
+            mCells[CellKey(x, y)].push_back(id);
+        }
+    }
+}
+
+/**
+ * Take a rectangle out of the cells it is in
+ * @param id ID of the rectangle
+ */
+void SpatialGrid::Remove(int id)
+{
+    auto &entry = mEntries[id];
+    if (entry.mLarge)
+    {
+        mLarge.erase(std::find(mLarge.begin(), mLarge.end(), id));
+        return;
+    }
+
+    for (int y = entry.mTop; y <= entry.mBottom; y++)
+    {
+        for (int x = entry.mLeft; x <= entry.mRight; x++)
+        {
+            RemoveFromCell(id, x, y);
+        }
+    }
+}
+
+/**
+ * Take a rectangle out of one cell
+ * @param id ID of the rectangle
+ * @param x Cell column
+ * @param y Cell row
+ */
+void SpatialGrid::RemoveFromCell(int id, int x, int y)
+{
+    auto cell = mCells.find(CellKey(x, y));
+    auto &ids = cell->second;
+    ids.erase(std::find(ids.begin(), ids.end(), id));
+    if (ids.empty())
+    {
+        mCells.erase(cell);
+    }
+}
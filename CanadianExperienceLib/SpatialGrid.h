@@ -0,0 +1,82 @@
+/**
+ * @file SpatialGrid.h
+ * @author Frederick Fan
+ *
+ * A uniform grid of rectangles for finding what is under a point
+ */
+
+#ifndef CANADIANEXPERIENCE_CANADIANEXPERIENCELIB_SPATIALGRID_H
+#define CANADIANEXPERIENCE_CANADIANEXPERIENCELIB_SPATIALGRID_H
+
+#include <unordered_map>
+#include <vector>
+
+/**
+ * A uniform grid of rectangles for finding what is under a point.
+ *
+ * Each rectangle is added with an ID and kept in every square cell
+ * of the grid it overlaps. Finding the rectangles under a point then
+ * only looks at the cell the point is in. Only the cells that are
+ * used are stored, so the grid has no fixed extent. Rectangles that
+ * would cover too many cells are kept in one list that every query
+ * looks at instead.
+ */
+class SpatialGrid
+{
+private:
+    /// A rectangle in the grid
+    struct Entry
+    {
+        /// The rectangle
+        wxRect mBounds;
+
+        /// The range of cells it is in, inclusive
+        int mLeft = 0, mTop = 0, mRight = -1, mBottom = -1;
+
+        /// Is it in the list of large rectangles rather than in cells?
+        bool mLarge = false;
+
+        /**
+         * Is a cell in the range of cells of this rectangle?
+         * @param x Cell column
+         * @param y Cell row
+         * @return true if the cell is in the range
+         */
+        bool Covers(int x, int y) const { return x >= mLeft && x <= mRight && y >= mTop && y <= mBottom; }
+    };
+
+    /// Size of a cell in pixels
+    int mCellSize;
+
+    /// The rectangles, indexed by ID
+    std::vector<Entry> mEntries;
+
+    /// The IDs of the rectangles in each cell that is used
+    std::unordered_map<long long, std::vector<int>> mCells;
+
+    /// The IDs of the rectangles that cover too many cells to be put in them
+    std::vector<int> mLarge;
+
+    int CellOf(int coordinate) const;
+    static long long CellKey(int x, int y);
+    void SetCells(Entry &entry) const;
+    void Insert(int id);
+    void Remove(int id);
+    void RemoveFromCell(int id, int x, int y);
+
+public:
+    SpatialGrid(int cellSize = 64);
+
+    int Add(const wxRect &bounds);
+    void Move(int id, const wxRect &bounds);
+    void Clear();
+    void Query(wxPoint pos, std::vector<int> &ids) const;
+
+    /**
+     * Get the number of rectangles in the grid
+     * @return Number of rectangles, which are IDs 0 to this minus one
+     */
+    int GetCount() const { return (int)mEntries.size(); }
+};
+
+#endif //CANADIANEXPERIENCE_CANADIANEXPERIENCELIB_SPATIALGRID_H
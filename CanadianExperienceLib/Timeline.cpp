@@ -6,6 +6,11 @@
 #include "pch.h"
 #include "Timeline.h"
 #include "AnimChannel.h"
+#include "AnimChannelAngle.h"
+#include "AnimChannelPoint.h"
+#include "XmlStreamReader.h"
+
+#include <memory>
 
 /**
  * Constructor
@@ -22,6 +27,32 @@ Timeline::Timeline()
 void Timeline::AddChannel(AnimChannel *channel)
 {
     mChannels.push_back(channel);
+    mChannelIndex.clear();
+    mOtherChannels.push_back(channel);
+    channel->SetTimeline(this);
+}
+
+/**
+ * Add an angle animation channel to the timeline
+ * @param channel Channel to add
+ */
+void Timeline::AddChannel(AnimChannelAngle *channel)
+{
+    mChannels.push_back(channel);
+    mChannelIndex.clear();
+    mAngleChannels.push_back(channel);
+    channel->SetTimeline(this);
+}
+
+/**
+ * Add a point animation channel to the timeline
+ * @param channel Channel to add
+ */
+void Timeline::AddChannel(AnimChannelPoint *channel)
+{
+    mChannels.push_back(channel);
+    mChannelIndex.clear();
+    mPointChannels.push_back(channel);
     channel->SetTimeline(this);
 }
 
@@ -30,6 +61,9 @@ void Timeline::AddChannel(AnimChannel *channel)
 *
 * Ensures all of the channels are
 * valid for that point in time.
+*
+* Every channel finds its keyframes first. Then the channels of
+* each type are tweened together in one batch.
 * @param t The new time to set
 */
 void Timeline::SetCurrentTime(double t)
@@ -37,9 +71,18 @@ void Timeline::SetCurrentTime(double t)
     // Set the time
     mCurrentTime = t;
 
+    int frame = GetCurrentFrame();
     for (auto channel : mChannels)
     {
-        channel->SetFrame(GetCurrentFrame());
+        channel->Locate(frame);
+    }
+
+    AnimChannelAngle::EvaluateAll(mAngleChannels);
+    AnimChannelPoint::EvaluateAll(mPointChannels);
+
+    for (auto channel : mOtherChannels)
+    {
+        channel->Evaluate();
     }
 }
 
@@ -79,12 +122,7 @@ void Timeline::Save(wxXmlNode* root)
 */
 void Timeline::Load(wxXmlNode* root)
 {
-    // Once we know it is open, clear the existing data
-    Clear();
-
-    // Get the attributes
-    mNumFrames = wxAtoi(root->GetAttribute(L"numframes", L"300"));
-    mFrameRate = wxAtoi(root->GetAttribute(L"framerate", L"30"));
+    XmlLoadStart(root);
 
     //
     // Traverse the children of the root
@@ -100,6 +138,141 @@ void Timeline::Load(wxXmlNode* root)
         }
     }
 
+    // The channels add keyframes without moving to them,
+    // so put every channel at the current time once at the end
+    SetCurrentTime(mCurrentTime);
+}
+
+
+/**
+ * Load a timeline animation from an XML stream.
+ *
+ * The document is never held in memory. Channels and keyframes
+ * are loaded as they are read, so the memory used does not grow
+ * with the size of the document.
+ *
+ * The keyframes are read into stand-in channels on a staging
+ * timeline, and only replace the animation once the whole document
+ * has been read, so a bad or cut off document changes nothing.
+ * @param stream Stream to read the XML from
+ * @param root Node that receives the attributes of the root node
+ * @return true if the document was read, false if it is not valid,
+ * in which case the timeline and root are left as they were
+ */
+bool Timeline::Load(wxInputStream &stream, wxXmlNode* root)
+{
+    // A stand-in for each channel, in the same order, so
+    // channels are found by name just as they are here
+    std::vector<std::pair<AnimChannelAngle *, std::unique_ptr<AnimChannelAngle>>> angles;
+    std::vector<std::pair<AnimChannelPoint *, std::unique_ptr<AnimChannelPoint>>> points;
+
+    Timeline staging;
+    for (auto channel : mChannels)
+    {
+        if (auto angle = dynamic_cast<AnimChannelAngle *>(channel))
+        {
+            auto staged = std::make_unique<AnimChannelAngle>();
+            staged->SetName(channel->GetName());
+            staging.AddChannel(staged.get());
+            angles.emplace_back(angle, std::move(staged));
+        }
+        else if (auto point = dynamic_cast<AnimChannelPoint *>(channel))
+        {
+            auto staged = std::make_unique<AnimChannelPoint>();
+            staged->SetName(channel->GetName());
+            staging.AddChannel(staged.get());
+            points.emplace_back(point, std::move(staged));
+        }
+    }
+
+    wxXmlNode stagedRoot(wxXML_ELEMENT_NODE, root->GetName());
+    if (!staging.Read(stream, &stagedRoot))
+    {
+        return false;
+    }
+
+    //
+    // The document is valid, so replace the animation
+    //
+    Clear();
+    mNumFrames = staging.mNumFrames;
+    mFrameRate = staging.mFrameRate;
+
+    for (auto &angle : angles)
+    {
+        angle.first->SetKeyframes(angle.second->GetKeyframeFrames(), angle.second->GetKeyframeAngles());
+    }
+
+    for (auto &point : points)
+    {
+        point.first->SetKeyframes(point.second->GetKeyframeFrames(), point.second->GetKeyframePoints());
+    }
+
+    for (auto attribute = stagedRoot.GetAttributes(); attribute; attribute = attribute->GetNext())
+    {
+        root->AddAttribute(attribute->GetName(), attribute->GetValue());
+    }
+
+    SetCurrentTime(mCurrentTime);
+    return true;
+}
+
+
+/**
+ * Read the channels and keyframes of an XML stream into this timeline
+ * @param stream Stream to read the XML from
+ * @param root Node that receives the attributes of the root node
+ * @return true if the document was read, false if it is not valid
+ */
+bool Timeline::Read(wxInputStream &stream, wxXmlNode* root)
+{
+    // The channel the keyframes being read are for
+    AnimChannel *channel = nullptr;
+
+    XmlStreamReader reader(stream);
+    reader.SetStartHandler([this, root, &channel](wxXmlNode *node, int depth) {
+        if (depth == 0)
+        {
+            for (auto attribute = node->GetAttributes(); attribute; attribute = attribute->GetNext())
+            {
+                root->AddAttribute(attribute->GetName(), attribute->GetValue());
+            }
+
+            XmlLoadStart(node);
+        }
+        else if (depth == 1 && node->GetName() == L"channel")
+        {
+            channel = FindChannel(node->GetAttribute(L"name", L"").ToStdWstring());
+        }
+        else if (depth == 2 && channel != nullptr && node->GetName() == L"keyframe")
+        {
+            channel->XmlKeyframe(node);
+        }
+    });
+
+    reader.SetEndHandler([&channel](const wxString &name, int depth) {
+        if (depth == 1)
+        {
+            channel = nullptr;
+        }
+    });
+
+    return reader.Read();
+}
+
+
+/**
+ * Clear the timeline and load the attributes of the root node
+ * @param root XML node to load from
+ */
+void Timeline::XmlLoadStart(wxXmlNode* root)
+{
+    // Once we know it is open, clear the existing data
+    Clear();
+
+    // Get the attributes
+    mNumFrames = wxAtoi(root->GetAttribute(L"numframes", L"300"));
+    mFrameRate = wxAtoi(root->GetAttribute(L"framerate", L"30"));
 }
 
 
@@ -113,14 +286,46 @@ void Timeline::XmlChannel(wxXmlNode* node)
     auto name = node->GetAttribute(L"name", L"");
 
     // Find the channel
+    auto channel = FindChannel(name.ToStdWstring());
+    if (channel != nullptr)
+    {
+        // We found it, let it handle it
+        channel->XmlLoad(node);
+    }
+}
+
+/**
+ * Find a channel by name
+ * @param name Name of the channel
+ * @return The first channel added with that name, or nullptr if there is none
+ */
+AnimChannel *Timeline::FindChannel(const std::wstring &name)
+{
+    IndexChannels();
+
+    auto found = mChannelIndex.find(name);
+    return found != mChannelIndex.end() ? found->second : nullptr;
+}
+
+/**
+ * Build the index of the channels by name, if it is not already built.
+ *
+ * Channels get their names from their actors and drawables, which may
+ * happen after they are added to the timeline, so the index is built
+ * when it is needed and rebuilt whenever a channel is added.
+ */
+void Timeline::IndexChannels()
+{
+    if (!mChannelIndex.empty() || mChannels.empty())
+    {
+        return;
+    }
+
+    mChannelIndex.reserve(mChannels.size());
     for (auto channel : mChannels)
     {
-        if (channel->GetName() == name)
-        {
-            // We found it, let it handle it
-            channel->XmlLoad(node);
-            break;
-        }
+        // Like a search in order, the first channel with a name wins
+        mChannelIndex.emplace(channel->GetName(), channel);
     }
 }
 
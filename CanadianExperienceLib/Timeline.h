@@ -8,7 +8,12 @@
 #ifndef CANADIANEXPERIENCE_TIMELINE_H
 #define CANADIANEXPERIENCE_TIMELINE_H
 
+#include <unordered_map>
+
 class AnimChannel;
+class AnimChannelAngle;
+class AnimChannelPoint;
+class wxInputStream;
 
 /**
  * This class implements a timeline that manages the animation
@@ -20,6 +25,7 @@ class AnimChannel;
 class Timeline {
 private:
     void XmlChannel(wxXmlNode* node);
+    void XmlLoadStart(wxXmlNode* root);
 
     int mNumFrames = 300;       ///< Number of frames in the animation
     int mFrameRate = 30;        ///< Animation frame rate in frames per second
@@ -28,6 +34,23 @@ private:
     /// List of all animation channels
     std::vector<AnimChannel *> mChannels;
 
+    /// The angle channels, evaluated together
+    std::vector<AnimChannelAngle *> mAngleChannels;
+
+    /// The point channels, evaluated together
+    std::vector<AnimChannelPoint *> mPointChannels;
+
+    /// Channels of any other type, evaluated one at a time
+    std::vector<AnimChannel *> mOtherChannels;
+
+    /// The channels by name, for finding them when loading.
+    /// Built on first use, since channels are named after they are added.
+    std::unordered_map<std::wstring, AnimChannel *> mChannelIndex;
+
+    void IndexChannels();
+
+    bool Read(wxInputStream &stream, wxXmlNode* root);
+
 public:
     Timeline();
 
@@ -87,11 +110,29 @@ public:
     void ClearKeyframe();
 
     void AddChannel(AnimChannel* channel);
+    void AddChannel(AnimChannelAngle* channel);
+    void AddChannel(AnimChannelPoint* channel);
+
+    AnimChannel *FindChannel(const std::wstring &name);
+
+    /**
+     * Get the angle channels
+     * @return Angle channels, in the order they were added
+     */
+    const std::vector<AnimChannelAngle *> &GetAngleChannels() const { return mAngleChannels; }
+
+    /**
+     * Get the point channels
+     * @return Point channels, in the order they were added
+     */
+    const std::vector<AnimChannelPoint *> &GetPointChannels() const { return mPointChannels; }
 
     void Save(wxXmlNode* root);
 
     void Load(wxXmlNode* root);
 
+    bool Load(wxInputStream &stream, wxXmlNode* root);
+
 
 };
 
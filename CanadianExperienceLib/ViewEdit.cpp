@@ -89,20 +89,10 @@ void ViewEdit::OnLeftDown(wxMouseEvent &event)
     // Did we hit anything?
     //
 
+    // The picture finds the drawable on top, testing
+    // only the drawables near where we clicked
     std::shared_ptr<Actor> hitActor;
-    std::shared_ptr<Drawable> hitDrawable;
-    for (auto actor : *GetPicture())
-    {
-        // Note: We do not exit when we get the first hit, since
-        // we are looking at these in drawing order. Instead, we
-        // keep the last hit.
-        std::shared_ptr<Drawable> drawable = actor->HitTest(wxPoint(click.x, click.y));
-        if (drawable != nullptr)
-        {
-            hitActor = actor;
-            hitDrawable = drawable;
-        }
-    }
+    std::shared_ptr<Drawable> hitDrawable = GetPicture()->HitTest(wxPoint(click.x, click.y), hitActor);
 
     // If we hit something determine what we do with it based on the
     // current mode.
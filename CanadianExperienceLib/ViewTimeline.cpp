@@ -352,7 +352,8 @@ void ViewTimeline::Stop()
 void ViewTimeline::OnFileSaveAs(wxCommandEvent& event)
 {
     wxFileDialog saveFileDialog(this, _("Save Animation file"), "", "",
-            "Animation Files (*.anim)|*.anim", wxFD_SAVE|wxFD_OVERWRITE_PROMPT);
+            "Animation Files (*.anim)|*.anim|Binary Animation Files (*.banim)|*.banim",
+            wxFD_SAVE|wxFD_OVERWRITE_PROMPT);
     if (saveFileDialog.ShowModal() == wxID_CANCEL)
     {
         return;
@@ -369,7 +370,7 @@ void ViewTimeline::OnFileSaveAs(wxCommandEvent& event)
 void ViewTimeline::OnFileOpen(wxCommandEvent& event)
 {
     wxFileDialog loadFileDialog(this, _("Load Animation file"), "", "",
-            "Animation Files (*.anim)|*.anim", wxFD_OPEN);
+            "Animation Files (*.anim;*.banim)|*.anim;*.banim", wxFD_OPEN);
     if (loadFileDialog.ShowModal() == wxID_CANCEL)
     {
         return;
@@ -0,0 +1,108 @@
+/**
+ * @file XmlStreamReader.cpp
+ * @author Frederick Fan
+ */
+
+#include "pch.h"
+#include "XmlStreamReader.h"
+
+#include <wx/stream.h>
+
+#include <expat.h>
+#include <memory>
+#include <vector>
+
+/// Number of bytes read from the stream at a time
+const size_t BlockSize = 65536;
+
+/**
+ * Constructor
+ * @param stream Stream to read the document from
+ */
+XmlStreamReader::XmlStreamReader(wxInputStream &stream) : mStream(stream)
+{
+}
+
+/**
+ * Handle the start of an element, called by expat
+ * @param data The reader
+ * @param name Element name in UTF-8
+ * @param attributes Attribute names and values in UTF-8, alternating,
+ * ending with a null
+ */
+void XmlStreamReader::OnStart(void *data, const char *name, const char **attributes)
+{
+    auto reader = static_cast<XmlStreamReader *>(data);
+
+    if (reader->mStartHandler != nullptr)
+    {
+        wxXmlNode node(wxXML_ELEMENT_NODE, wxString::FromUTF8(name));
+        for (auto attribute = attributes; *attribute != nullptr; attribute += 2)
+        {
+            node.AddAttribute(wxString::FromUTF8(attribute[0]), wxString::FromUTF8(attribute[1]));
+        }
+
+        reader->mStartHandler(&node, reader->mDepth);
+    }
+
+    reader->mDepth++;
+}
+
+/**
+ * Handle the end of an element, called by expat
+ * @param data The reader
+ * @param name Element name in UTF-8
+ */
+void XmlStreamReader::OnEnd(void *data, const char *name)
+{
+    auto reader = static_cast<XmlStreamReader *>(data);
+
+    reader->mDepth--;
+    if (reader->mEndHandler != nullptr)
+    {
+        reader->mEndHandler(wxString::FromUTF8(name), reader->mDepth);
+    }
+}
+
+/**
+ * Read the document, calling the handlers as elements start and end
+ * @return true if the whole document was read, false if it is not
+ * a valid document. The handlers may have been called for the elements
+ * before the error.
+ */
+bool XmlStreamReader::Read()
+{
+    // The encoding comes from the XML declaration, UTF-8 if there is none
+    std::unique_ptr<XML_ParserStruct, void (*)(XML_Parser)> parser(XML_ParserCreate(nullptr), XML_ParserFree);
+    if (parser == nullptr)
+    {
+        return false;
+    }
+
+    mDepth = 0;
+    XML_SetUserData(parser.get(), this);
+    XML_SetElementHandler(parser.get(), &XmlStreamReader::OnStart, &XmlStreamReader::OnEnd);
+
+    std::vector<char> buffer(BlockSize);
+    while (true)
+    {
+        mStream.Read(buffer.data(), buffer.size());
+        size_t length = mStream.LastRead();
+        if (length == 0 && mStream.GetLastError() == wxSTREAM_READ_ERROR)
+        {
+            return false;
+        }
+
+        // The last call, with nothing more to come, checks the document is complete
+        bool done = length == 0;
+        if (XML_Parse(parser.get(), buffer.data(), (int)length, done) != XML_STATUS_OK)
+        {
+            return false;
+        }
+
+        if (done)
+        {
+            return true;
+        }
+    }
+}
@@ -0,0 +1,87 @@
+/**
+ * @file XmlStreamReader.h
+ * @author Frederick Fan
+ *
+ * Reads an XML document one element at a time
+ */
+
+#ifndef CANADIANEXPERIENCE_CANADIANEXPERIENCELIB_XMLSTREAMREADER_H
+#define CANADIANEXPERIENCE_CANADIANEXPERIENCELIB_XMLSTREAMREADER_H
+
+#include <functional>
+
+class wxInputStream;
+
+/**
+ * Reads an XML document one element at a time.
+ *
+ * Unlike wxXmlDocument, this never holds the document in memory.
+ * The stream is read in blocks, and a handler is called for the
+ * start and end of each element as it is read. The start handler
+ * gets a node with the name and attributes of the element, but no
+ * children, so the existing XML loading code can be used on it.
+ *
+ * The parsing is done by expat, the same parser wxXmlDocument uses,
+ * so the encoding declaration (UTF-8, UTF-16, ISO-8859-1 or US-ASCII),
+ * references and document type declarations are handled the way they
+ * are when the document is loaded whole. Text, comments and processing
+ * instructions are skipped.
+ */
+class XmlStreamReader
+{
+public:
+    /**
+     * Function called at the start of an element
+     * @param node Node with the name and attributes of the element
+     * @param depth Depth of the element, 0 for the root
+     */
+    typedef std::function<void(wxXmlNode *node, int depth)> StartHandler;
+
+    /**
+     * Function called at the end of an element
+     * @param name Name of the element
+     * @param depth Depth of the element, 0 for the root
+     */
+    typedef std::function<void(const wxString &name, int depth)> EndHandler;
+
+private:
+    /// Stream to read from
+    wxInputStream &mStream;
+
+    /// Depth of the next element to start
+    int mDepth = 0;
+
+    /// Handler for the start of elements
+    StartHandler mStartHandler;
+
+    /// Handler for the end of elements
+    EndHandler mEndHandler;
+
+    static void OnStart(void *data, const char *name, const char **attributes);
+    static void OnEnd(void *data, const char *name);
+
+public:
+    XmlStreamReader(wxInputStream &stream);
+
+    /// Copy constructor (disabled)
+    XmlStreamReader(const XmlStreamReader &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const XmlStreamReader &) = delete;
+
+    /**
+     * Set the function called at the start of each element
+     * @param handler Handler function
+     */
+    void SetStartHandler(StartHandler handler) { mStartHandler = handler; }
+
+    /**
+     * Set the function called at the end of each element
+     * @param handler Handler function
+     */
+    void SetEndHandler(EndHandler handler) { mEndHandler = handler; }
+
+    bool Read();
+};
+
+#endif //CANADIANEXPERIENCE_CANADIANEXPERIENCELIB_XMLSTREAMREADER_H
@@ -0,0 +1,244 @@
+/**
+ * @file main.cpp
+ * @author Frederick Fan
+ *
+ * Headless simulation benchmark for MachineLib.
+ *
+ * Runs one of the machines for some number of frames without
+ * a window or graphics context and prints the time each
+ * Machine::Update call took as JSON.
+ *
+ * With --trace the hash of the machine state after every frame is
+ * saved to a file. With --compare the hashes are checked against a
+ * trace saved by an earlier run and the first frame that differs is
+ * reported, so a change can be shown not to alter the simulation.
+ *
+ * Usage: machine-bench [--machine n] [--frames n] [--rate fps] [--step seconds]
+ *                      [--max-substeps n] [--resources dir]
+ *                      [--trace file] [--compare file]
+ */
+
+#include "pch.h"
+#include <wx/init.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <Machine.h>
+#include <Machine1Factory.h>
+#include <Machine2Factory.h>
+#include <MachineTrace.h>
+
+/// Default number of frames to simulate
+const int DefaultFrames = 900;
+
+/// Default frame rate in frames per second
+const double DefaultFrameRate = 30;
+
+/// Default resources directory, relative to the build directory
+/// the executable is run from
+const std::wstring DefaultResourcesDir = L"..";
+
+/**
+ * Compute a percentile of a sorted array of samples
+ * @param sorted Samples in ascending order
+ * @param percent Percentile in the range [0, 100]
+ * @return Sample at that percentile
+ */
+static double Percentile(const std::vector<double> &sorted, double percent)
+{
+    if(sorted.empty())
+    {
+        return 0;
+    }
+
+    auto index = (size_t)(percent / 100.0 * (double)(sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+/**
+ * Print the usage message
+ */
+static void Usage()
+{
+    std::cerr << "Usage: machine-bench [--machine n] [--frames n] [--rate fps] [--step seconds]" << std::endl;
+    std::cerr << "                     [--max-substeps n] [--resources dir]" << std::endl;
+    std::cerr << "                     [--trace file] [--compare file]" << std::endl;
+}
+
+/**
+ * Main entry point for the benchmark
+ * @param argc Number of arguments
+ * @param argv Arguments
+ * @return 0 if successful
+ */
+int main(int argc, char **argv)
+{
+    int machineNumber = 1;
+    int frames = DefaultFrames;
+    double frameRate = DefaultFrameRate;
+    double stepSize = 0;
+    int maxSubSteps = 0;
+    std::wstring resourcesDir = DefaultResourcesDir;
+    std::wstring traceFile;
+    std::wstring compareFile;
+
+    for(int i=1; i<argc; i++)
+    {
+        bool hasValue = i + 1 < argc;
+        if(strcmp(argv[i], "--machine") == 0 && hasValue)
+        {
+            machineNumber = atoi(argv[++i]);
+        }
+        else if(strcmp(argv[i], "--frames") == 0 && hasValue)
+        {
+            frames = atoi(argv[++i]);
+        }
+        else if(strcmp(argv[i], "--rate") == 0 && hasValue)
+        {
+            frameRate = atof(argv[++i]);
+        }
+        else if(strcmp(argv[i], "--step") == 0 && hasValue)
+        {
+            stepSize = atof(argv[++i]);
+        }
+        else if(strcmp(argv[i], "--max-substeps") == 0 && hasValue)
+        {
+            maxSubSteps = atoi(argv[++i]);
+        }
+        else if(strcmp(argv[i], "--resources") == 0 && hasValue)
+        {
+            resourcesDir = wxString(argv[++i]).ToStdWstring();
+        }
+        else if(strcmp(argv[i], "--trace") == 0 && hasValue)
+        {
+            traceFile = wxString(argv[++i]).ToStdWstring();
+        }
+        else if(strcmp(argv[i], "--compare") == 0 && hasValue)
+        {
+            compareFile = wxString(argv[++i]).ToStdWstring();
+        }
+        else
+        {
+            Usage();
+            return 1;
+        }
+    }
+
+    if(frames <= 0 || frameRate <= 0 || stepSize < 0)
+    {
+        Usage();
+        return 1;
+    }
+
+    // wxWidgets base library only, no GUI is ever created
+    wxInitializer initializer;
+    if(!initializer.IsOk())
+    {
+        std::cerr << "Unable to initialize wxWidgets" << std::endl;
+        return 1;
+    }
+
+    wxInitAllImageHandlers();
+
+    std::shared_ptr<Machine> machine;
+    if(machineNumber == 2)
+    {
+        Machine2Factory factory(resourcesDir);
+        machine = factory.Create();
+    }
+    else
+    {
+        machineNumber = 1;
+        Machine1Factory factory(resourcesDir);
+        machine = factory.Create();
+    }
+
+    if(stepSize > 0)
+    {
+        machine->SetStepSize(stepSize);
+    }
+    machine->SetMaxSubSteps(maxSubSteps);
+    machine->Reset();
+
+    MachineTrace expected;
+    if(!compareFile.empty() && !expected.Load(compareFile))
+    {
+        std::cerr << "Unable to load the trace to compare against" << std::endl;
+        return 1;
+    }
+
+    // Hashing the state costs a little, so only trace when asked
+    std::shared_ptr<MachineTrace> trace;
+    if(!traceFile.empty() || !compareFile.empty())
+    {
+        trace = std::make_shared<MachineTrace>();
+        machine->SetTrace(trace);
+    }
+
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<double> frameTimes;
+    frameTimes.reserve(frames);
+
+    auto start = Clock::now();
+    for(int frame=0; frame<frames; frame++)
+    {
+        auto frameStart = Clock::now();
+        machine->Update(1.0 / frameRate);
+        auto frameEnd = Clock::now();
+
+        frameTimes.push_back(std::chrono::duration<double, std::milli>(frameEnd - frameStart).count());
+    }
+    double total = std::chrono::duration<double>(Clock::now() - start).count();
+
+    if(!traceFile.empty() && !trace->Save(traceFile))
+    {
+        std::cerr << "Unable to save the trace" << std::endl;
+        return 1;
+    }
+
+    auto sorted = frameTimes;
+    std::sort(sorted.begin(), sorted.end());
+
+    double sum = 0;
+    for(auto time : frameTimes)
+    {
+        sum += time;
+    }
+
+    printf("{\n");
+    printf("  \"machine\": %d,\n", machineNumber);
+    printf("  \"frames\": %d,\n", frames);
+    printf("  \"frameRate\": %g,\n", frameRate);
+    printf("  \"stepSize\": %g,\n", machine->GetStepSize());
+    printf("  \"totalSeconds\": %.6f,\n", total);
+    printf("  \"meanMs\": %.6f,\n", sum / frameTimes.size());
+    printf("  \"minMs\": %.6f,\n", sorted.front());
+    printf("  \"p50Ms\": %.6f,\n", Percentile(sorted, 50));
+    printf("  \"p90Ms\": %.6f,\n", Percentile(sorted, 90));
+    printf("  \"p99Ms\": %.6f,\n", Percentile(sorted, 99));
+    printf("  \"maxMs\": %.6f,\n", sorted.back());
+    if(trace != nullptr)
+    {
+        printf("  \"finalHash\": \"%016llx\",\n", (unsigned long long)trace->GetHashes().back());
+    }
+    if(!compareFile.empty())
+    {
+        // -1 if every frame matched
+        printf("  \"firstDifference\": %d,\n", MachineTrace::FindDifference(expected, *trace));
+    }
+    printf("  \"frameMs\": [");
+    for(size_t i=0; i<frameTimes.size(); i++)
+    {
+        printf(i == 0 ? "%.6f" : ", %.6f", frameTimes[i]);
+    }
+    printf("]\n}\n");
+
+    return 0;
+}
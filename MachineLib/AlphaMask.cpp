@@ -0,0 +1,79 @@
+/**
+ * @file AlphaMask.cpp
+ * @author Frederick Fan
+ */
+
+#include "pch.h"
+#include "include/AlphaMask.h"
+
+#include <algorithm>
+
+/**
+ * Constructor
+ * @param image Image to make the mask for
+ * @param threshold Pixels with an alpha below this are transparent,
+ * the same as for wxImage::IsTransparent
+ */
+AlphaMask::AlphaMask(const wxImage &image, unsigned char threshold)
+{
+    if (!image.IsOk())
+    {
+        return;
+    }
+
+    mWidth = image.GetWidth();
+    mHeight = image.GetHeight();
+    mStride = (mWidth + 63) / 64;
+    mBits.assign((size_t)mStride * mHeight, 0);
+
+    const unsigned char *alpha = image.HasAlpha() ? image.GetAlpha() : nullptr;
+    const unsigned char *rgb = image.GetData();
+
+    bool hasMask = alpha == nullptr && image.HasMask();
+    unsigned char maskR = 0, maskG = 0, maskB = 0;
+    if (hasMask)
+    {
+        maskR = image.GetMaskRed();
+        maskG = image.GetMaskGreen();
+        maskB = image.GetMaskBlue();
+    }
+
+    int left = mWidth, top = mHeight, right = -1, bottom = -1;
+    for (int y = 0; y < mHeight; y++)
+    {
+        auto row = mBits.data() + (size_t)y * mStride;
+        for (int x = 0; x < mWidth; x++)
+        {
+            size_t pixel = (size_t)y * mWidth + x;
+
+            bool opaque;
+            if (alpha != nullptr)
+            {
+                opaque = alpha[pixel] >= threshold;
+            }
+            else if (hasMask)
+            {
+                auto color = rgb + pixel * 3;
+                opaque = color[0] != maskR || color[1] != maskG || color[2] != maskB;
+            }
+            else
+            {
+                opaque = true;
+            }
+
+            if (opaque)
+            {
+                row[x >> 6] |= (uint64_t)1 << (x & 63);
+                left = std::min(left, x);
+                right = std::max(right, x);
+                top = std::min(top, y);
+                bottom = std::max(bottom, y);
+            }
+        }
+    }
+
+    if (right >= 0)
+    {
+        mOpaqueBounds = wxRect(wxPoint(left, top), wxPoint(right, bottom));
+    }
+}
@@ -7,6 +7,8 @@
 
 #include "pch.h"
 #include "Banner.h"
+#include "include/ImageCache.h"
+#include "DisplayList.h"
 
 
 /// Scale to draw relative to the image sizes
@@ -24,8 +26,8 @@ const double BannerRollHeight = 300 * BannerScale;
 /// Width of the banner roll image in pixels
 double const BannerRollWidth = 16 * BannerScale;
 
-/// How fast the banner will unfurl at each time update
-double const BannerSpeed = 4;
+/// How fast the banner will unfurl in pixels per second
+double const BannerSpeed = 120;
 
 /// Minimum number of pixels to start with as unfurled
 const double BannerMinimum = 15;
@@ -37,16 +39,35 @@ const double BannerMinimum = 15;
  */
 Banner::Banner(const std::wstring& bannerImage, const std::wstring& rollImage)
 {
-    mBannerImage = std::make_unique<wxImage>(bannerImage);
-    mRollImage = std::make_unique<wxImage>(rollImage);
+    mBannerImage = ImageCache::Load(bannerImage);
+    mRollImage = ImageCache::Load(rollImage);
 
 }
 
+/**
+ * Copy constructor. The images are shared with the original.
+ * @param other Banner to copy
+ */
+Banner::Banner(const Banner &other) : Component(other), mBannerImage(other.mBannerImage),
+    mRollImage(other.mRollImage), mBannerPosition(other.mBannerPosition),
+    mRollOffsetByBannerPosition(other.mRollOffsetByBannerPosition)
+{
+}
+
+/**
+ * Create a copy of this banner that is not part of any machine
+ * @return New banner object
+ */
+std::shared_ptr<Component> Banner::Clone()
+{
+    return std::make_shared<Banner>(*this);
+}
+
 /**
  * Draw the banner
- * @param graphics the context to draw on
+ * @param list the display list to record into
  */
-void Banner::Draw(std::shared_ptr<wxGraphicsContext> graphics)
+void Banner::Draw(std::shared_ptr<DisplayList> list)
 {
 
     //How I am handling the unfurling banner is that I have a position stored for where the roll should be,
@@ -57,25 +78,16 @@ void Banner::Draw(std::shared_ptr<wxGraphicsContext> graphics)
     //go past the roll's position minus the banner width, commenting out the clip statement might give a
     //better idea of what I mean
 
-    graphics->PushState();
-    graphics->Translate(mRollOffsetByBannerPosition.m_x, mRollOffsetByBannerPosition.m_y);
-    graphics->Scale(BannerScale,-BannerScale);
-
-    if(mBannerGraphicsBitmap.IsNull())
-    {
-        mBannerGraphicsBitmap = graphics->CreateBitmapFromImage(*mBannerImage);
-    }
-    if(mRollGraphicsBitmap.IsNull())
-    {
-        mRollGraphicsBitmap = graphics->CreateBitmapFromImage(*mRollImage);
-    }
+    list->PushState();
+    list->Translate(mRollOffsetByBannerPosition.m_x, mRollOffsetByBannerPosition.m_y);
+    list->Scale(BannerScale,-BannerScale);
 
-    graphics->Clip(BannerRollWidth, 0, BannerWidth,BannerHeight);
-    graphics->DrawBitmap( mBannerGraphicsBitmap, mBannerPosition.m_x-mRollOffsetByBannerPosition.m_x, 0,
+    list->Clip(BannerRollWidth, 0, BannerWidth,BannerHeight);
+    list->DrawBitmap( mBannerImage, mBannerPosition.m_x-mRollOffsetByBannerPosition.m_x, 0,
                           BannerWidth, BannerHeight);
-    graphics->DrawBitmap(mRollGraphicsBitmap, BannerWidth, -BannerHeight/2, //using constant just to take 1/2 height
+    list->DrawBitmap(mRollImage, BannerWidth, -BannerHeight/2, //using constant just to take 1/2 height
                          BannerRollWidth, BannerRollHeight);
-    graphics->PopState();
+    list->PopState();
 
 
 
@@ -99,9 +111,9 @@ void Banner::UpdateTime(double time)
     Component::UpdateTime(time);
 
 
-    if (mBannerPosition.m_x-BannerSpeed >= mRollOffsetByBannerPosition.m_x)
+    if (mBannerPosition.m_x-BannerSpeed*time >= mRollOffsetByBannerPosition.m_x)
     {
-        mBannerPosition.m_x -= BannerSpeed;
+        mBannerPosition.m_x -= BannerSpeed*time;
     }
     else
     {
@@ -126,3 +138,23 @@ void Banner::SetPosition(wxPoint2DDouble point)
     mRollOffsetByBannerPosition = point;
 }
 
+/**
+ * Save the state of the banner
+ * @param state Array to append the unfurled position to
+ */
+void Banner::SaveState(std::vector<double> &state)
+{
+    Component::SaveState(state);
+    state.push_back(mBannerPosition.m_x);
+}
+
+/**
+ * Restore the state of the banner saved by SaveState
+ * @param state Array of saved state values
+ * @param index Index of the next value to read
+ */
+void Banner::LoadState(const std::vector<double> &state, size_t &index)
+{
+    Component::LoadState(state, index);
+    mBannerPosition.m_x = state[index++];
+}
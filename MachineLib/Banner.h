@@ -10,6 +10,8 @@
 
 #include "Component.h"
 
+class SharedImage;
+
 
 /** Class for the banner component */
 class Banner : public Component
@@ -17,16 +19,10 @@ class Banner : public Component
 private:
 
     /// The basic texture image we load for the banner
-    std::unique_ptr<wxImage> mBannerImage = nullptr;
-
-    /// The graphics bitmap we actually draw for the banner
-    wxGraphicsBitmap mBannerGraphicsBitmap;
+    std::shared_ptr<SharedImage> mBannerImage = nullptr;
 
     /// The basic texture image we load for the scroll
-    std::unique_ptr<wxImage> mRollImage = nullptr;
-
-    /// The graphics bitmap we actually draw for the scroll
-    wxGraphicsBitmap mRollGraphicsBitmap;
+    std::shared_ptr<SharedImage> mRollImage = nullptr;
 
     ///The position of the banner
     wxPoint2DDouble mBannerPosition = wxPoint2DDouble(0,0);
@@ -43,16 +39,21 @@ public:
     /// Destructor
     virtual ~Banner() {}
 
-    /** Copy constructor disabled */
-    Banner(const Banner &) = delete;
+    Banner(const Banner &other);
 
     /** Assignment operator disabled */
     void operator=(const Banner &) = delete;
 
-    void Draw(std::shared_ptr<wxGraphicsContext> graphics) override;
+    std::shared_ptr<Component> Clone() override;
+
+    void Draw(std::shared_ptr<DisplayList> list) override;
 
     void ResetComponent() override;
 
+    void SaveState(std::vector<double> &state) override;
+
+    void LoadState(const std::vector<double> &state, size_t &index) override;
+
 
     void SetPosition(wxPoint2DDouble point);
 
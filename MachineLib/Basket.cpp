@@ -29,14 +29,14 @@ const int BasketBottomPolygonThickness = 9;
 
 /**
  * Draw the basket component
- * @param graphics the context being drawn on
+ * @param list the display list being recorded into
  */
-void Basket::Draw(std::shared_ptr<wxGraphicsContext> graphics)
+void Basket::Draw(std::shared_ptr<DisplayList> list)
 {
-    mBasket.DrawPolygon(graphics, mPosition.m_x, mPosition.m_y, 0);
-//    mBasketBottom.Draw(graphics);
-//    mBasketLeft.Draw(graphics);
-//    mBasketRight.Draw(graphics);
+    mBasket.DrawPolygon(list, mPosition.m_x, mPosition.m_y, 0);
+//    mBasketBottom.Draw(list);
+//    mBasketLeft.Draw(list);
+//    mBasketRight.Draw(list);
 }
 
 /**
@@ -122,6 +122,26 @@ Basket::Basket(std::wstring imagesDir)
 
 }
 
+/**
+ * Copy constructor
+ * @param other Basket to copy
+ */
+Basket::Basket(const Basket &other) : Component(other), mBasket(other.mBasket),
+    mBasketBottom(other.mBasketBottom), mBasketRight(other.mBasketRight), mBasketLeft(other.mBasketLeft),
+    mPosition(other.mPosition), mTimeInBasket(other.mTimeInBasket), mInBasket(other.mInBasket),
+    mBasketShot(other.mBasketShot)
+{
+}
+
+/**
+ * Create a copy of this basket that is not part of any machine
+ * @return New basket object
+ */
+std::shared_ptr<Component> Basket::Clone()
+{
+    return std::make_shared<Basket>(*this);
+}
+
 /**
  * handle the presolve, aka prior to the contact
  * @param contact the contact
@@ -144,3 +164,26 @@ void Basket::PreSolve(b2Contact *contact, const b2Manifold *oldManifold)
     }
 
 }
+
+/**
+ * Save the state of the basket
+ * @param state Array to append the time the ball has been in the basket to
+ */
+void Basket::SaveState(std::vector<double> &state)
+{
+    Component::SaveState(state);
+    state.push_back(mTimeInBasket);
+    state.push_back(mInBasket ? 1 : 0);
+}
+
+/**
+ * Restore the state of the basket saved by SaveState
+ * @param state Array of saved state values
+ * @param index Index of the next value to read
+ */
+void Basket::LoadState(const std::vector<double> &state, size_t &index)
+{
+    Component::LoadState(state, index);
+    mTimeInBasket = state[index++];
+    mInBasket = state[index++] != 0;
+}
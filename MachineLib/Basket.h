@@ -45,14 +45,15 @@ public:
     /// Destructor
     virtual ~Basket() {}
 
-    /** Copy constructor disabled */
-    Basket(const Basket &) = delete;
+    Basket(const Basket &other);
 
     /** Assignment operator disabled */
     void operator=(const Basket &) = delete;
 
+    std::shared_ptr<Component> Clone() override;
+
     Basket(std::wstring directory);
-    void Draw(std::shared_ptr<wxGraphicsContext> graphics) override;
+    void Draw(std::shared_ptr<DisplayList> list) override;
     void UpdateTime(double time) override;
     void SetPosition(wxPoint2DDouble point);
 
@@ -64,6 +65,10 @@ public:
 
     void ResetComponent() override;
 
+    void SaveState(std::vector<double> &state) override;
+
+    void LoadState(const std::vector<double> &state, size_t &index) override;
+
     /**
      * Set the basket shot
      * @param basketShot basket shot to set to
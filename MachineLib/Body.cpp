@@ -11,13 +11,31 @@ Body::Body()
 {
     mSink.SetComponent(this);
 }
+
+/**
+ * Copy constructor
+ * @param other Body to copy
+ */
+Body::Body(const Body &other) : Component(other), mPolygon(other.mPolygon)
+{
+    mSink.SetComponent(this);
+}
+
+/**
+ * Create a copy of this body that is not part of any machine
+ * @return New body object
+ */
+std::shared_ptr<Component> Body::Clone()
+{
+    return std::make_shared<Body>(*this);
+}
 /**
  * Draw the body component
- * @param graphics
+ * @param list
  */
-void Body::Draw(std::shared_ptr<wxGraphicsContext> graphics)
+void Body::Draw(std::shared_ptr<DisplayList> list)
 {
-    GetPolygon()->Draw(graphics);
+    GetPolygon()->Draw(list);
 }
 
 
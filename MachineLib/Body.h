@@ -30,13 +30,14 @@ public:
     /// Destructor
     virtual ~Body() {}
 
-    /** Copy constructor disabled */
-    Body(const Body &) = delete;
+    Body(const Body &other);
 
     /** Assignment operator disabled */
     void operator=(const Body &) = delete;
 
-    void Draw(std::shared_ptr<wxGraphicsContext> graphics) override;
+    std::shared_ptr<Component> Clone() override;
+
+    void Draw(std::shared_ptr<DisplayList> list) override;
     void InstallPhysics(std::shared_ptr<b2World> world) override;
 
 
@@ -50,7 +51,7 @@ public:
      * Get a pointer to the source object
      * @return Pointer to RotationSource object
      */
-    RotationSink *GetSink() { return &mSink; }
+    RotationSink *GetSink() override { return &mSink; }
 
     void Rotate(double rotation, double speed) override;
 
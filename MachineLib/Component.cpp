@@ -8,11 +8,49 @@
 #include "pch.h"
 #include "Component.h"
 #include "Machine.h"
+#include "RotationSource.h"
+#include "RotationSink.h"
+
+/**
+ * Constructor
+ */
 Component::Component()
 {
 
 }
 
+/**
+ * Copy constructor. The copy is not part of any machine.
+ * @param other Component to copy
+ */
+Component::Component(const Component &other) : mTime(other.mTime)
+{
+}
+
+/**
+ * Connect the clone of this component to the clones of the
+ * components this one is connected to.
+ *
+ * This drives the clones of our sinks from the clone's source.
+ * Derived classes with other connections extend this.
+ * @param clone The clone of this component
+ * @param clones The clone of every component in the machine
+ */
+void Component::ConnectClone(Component *clone, const std::map<Component*, std::shared_ptr<Component>> &clones)
+{
+    auto source = GetSource();
+    if (source == nullptr)
+    {
+        return;
+    }
+
+    for (auto sink : source->GetSinks())
+    {
+        auto target = clones.at(sink->GetComponent());
+        clone->GetSource()->AddSink(target->GetSink());
+    }
+}
+
 /**
  * Install physics into each component, this function will just be empty in component
  * since not all components need to install physics, this function will be overridden in the necessary classes
@@ -33,3 +71,28 @@ void Component::UpdateTime(double time)
     mTime +=time;
 
 }
+
+/**
+ * Save the state of this component so it can be restored later.
+ *
+ * Derived classes that have state of their own that changes as the
+ * machine runs must override this, call the base class version, and
+ * append their own values.
+ * @param state Array to append the state values to
+ */
+void Component::SaveState(std::vector<double> &state)
+{
+    state.push_back(mTime);
+}
+
+/**
+ * Restore the state of this component saved by SaveState
+ *
+ * Values must be read in the same order SaveState wrote them.
+ * @param state Array of saved state values
+ * @param index Index of the next value to read, advanced past the values we read
+ */
+void Component::LoadState(const std::vector<double> &state, size_t &index)
+{
+    mTime = state[index++];
+}
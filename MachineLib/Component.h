@@ -11,9 +11,11 @@
 #include "PhysicsPolygon.h"
 #include "box2d.h"
 #include "ContactListener.h"
+#include <map>
 
 class Machine;
 class RotationSink;
+class RotationSource;
 
 /** Class for the components of a machine */
 class Component
@@ -35,17 +37,16 @@ public:
     /// Destructor
     virtual ~Component() {}
 
-    /** Copy constructor disabled */
-    Component(const Component&) = delete;
+    Component(const Component &other);
 
     /** Assignment operator disabled */
     void operator=(const Component &) = delete;
 
     /**
      * Draw the component
-     * @param graphics the graphics context to draw on
+     * @param list the display list to record the drawing into
      */
-    virtual void Draw(std::shared_ptr<wxGraphicsContext> graphics) = 0;
+    virtual void Draw(std::shared_ptr<DisplayList> list) = 0;
 
     /**
      * Update the time
@@ -77,6 +78,26 @@ public:
       */
      virtual void Rotate(double rotation, double speed) {}
 
+    /**
+     * Get the rotation source of the component
+     * @return Pointer to RotationSource object or nullptr if it has none
+     */
+    virtual RotationSource *GetSource() { return nullptr; }
+
+    /**
+     * Get the rotation sink of the component
+     * @return Pointer to RotationSink object or nullptr if it has none
+     */
+    virtual RotationSink *GetSink() { return nullptr; }
+
+    /**
+     * Create a copy of this component that is not part of any machine
+     * @return New component object
+     */
+    virtual std::shared_ptr<Component> Clone() = 0;
+
+    virtual void ConnectClone(Component *clone, const std::map<Component*, std::shared_ptr<Component>> &clones);
+
 
      /**
       * Reset a component
@@ -89,6 +110,10 @@ public:
      */
      double GetTime(){return mTime;}
 
+    virtual void SaveState(std::vector<double> &state);
+
+    virtual void LoadState(const std::vector<double> &state, size_t &index);
+
 
 };
 
@@ -5,27 +5,69 @@
 
 #include "pch.h"
 #include <b2_contact.h>
+#include <b2_body.h>
 
 #include "ContactListener.h"
 
+/**
+ * Get the listener installed for a body.
+ *
+ * The listener is kept in the body user data, so finding
+ * it is a pointer load rather than a lookup. PreSolve is
+ * called for every touching pair on every step, so this
+ * is on the hot path of the simulation.
+ * @param body Body to get the listener for
+ * @return Listener or nullptr if none is installed
+ */
+static inline b2ContactListener* GetListener(b2Body* body)
+{
+    return reinterpret_cast<b2ContactListener*>(body->GetUserData().pointer);
+}
+
+/**
+ * Add a dispatched listener for some body.
+ * @param body Body to listen for
+ * @param listener Listener to call
+ */
+void ContactListener::Add(b2Body *body, b2ContactListener *listener)
+{
+    body->GetUserData().pointer = reinterpret_cast<uintptr_t>(listener);
+}
+
 /**
  * Handle a contact beginning
  * @param contact Contact object
  */
 void ContactListener::BeginContact(b2Contact *contact)
 {
-    b2ContactListener* listener = nullptr;
-    if(ShouldDispatch(contact, 1, listener))
+    if(auto listener = GetListener(contact->GetFixtureA()->GetBody()))
     {
         listener->BeginContact(contact);
     }
 
-    if(ShouldDispatch(contact, 2, listener))
+    if(auto listener = GetListener(contact->GetFixtureB()->GetBody()))
     {
         listener->BeginContact(contact);
     }
 }
 
+/**
+ * Handle the end of a contact situation
+ * @param contact Contact object
+ */
+void ContactListener::EndContact(b2Contact *contact)
+{
+    if(auto listener = GetListener(contact->GetFixtureA()->GetBody()))
+    {
+        listener->EndContact(contact);
+    }
+
+    if(auto listener = GetListener(contact->GetFixtureB()->GetBody()))
+    {
+        listener->EndContact(contact);
+    }
+}
+
 /**
  * This function is called before the contact occurs
  * @param contact Contact object
@@ -33,44 +75,31 @@ void ContactListener::BeginContact(b2Contact *contact)
  */
 void ContactListener::PreSolve(b2Contact *contact, const b2Manifold *oldManifold)
 {
-    b2ContactListener* listener = nullptr;
-    if(ShouldDispatch(contact, 1, listener))
+    if(auto listener = GetListener(contact->GetFixtureA()->GetBody()))
     {
         listener->PreSolve(contact, oldManifold);
     }
 
-    if(ShouldDispatch(contact, 2, listener))
+    if(auto listener = GetListener(contact->GetFixtureB()->GetBody()))
     {
         listener->PreSolve(contact, oldManifold);
     }
 }
 
 /**
- * Should a contact be dispatched to an installed listener for some body?
- *
- * We have installed listeners in mDispatch for bodies. This tests to see
- * if either of the two bodies involved  in the collision are in the
- * mDispatch map. If so, the listener reference value is set and a
- * true value is returned.
- *
- * @param contact Contact to test
- * @param body Which body for the contact (1 or 2?)
- * @param listener Where to put the listener to call the function on
- * @return true if we should dispatch this contact
+ * Called after the solve has been computed, but before the contact is reported
+ * @param contact Contact object
+ * @param impulse Impulse related to the contact
  */
- bool ContactListener::ShouldDispatch(b2Contact *contact, int body, b2ContactListener* &listener)
+void ContactListener::PostSolve(b2Contact *contact, const b2ContactImpulse *impulse)
 {
-    b2Body* bodyD = body == 1 ? contact->GetFixtureA()->GetBody() :
-                               contact->GetFixtureB()->GetBody();
-
-    auto dispatchA = mDispatch.find(bodyD);
-    if(dispatchA != mDispatch.end())
+    if(auto listener = GetListener(contact->GetFixtureA()->GetBody()))
     {
-       listener = dispatchA->second;
-       return true;
+        listener->PostSolve(contact, impulse);
     }
 
-    return false;
+    if(auto listener = GetListener(contact->GetFixtureB()->GetBody()))
+    {
+        listener->PostSolve(contact, impulse);
+    }
 }
-
-
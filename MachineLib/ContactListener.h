@@ -9,7 +9,6 @@
 #ifndef CANADIANEXPERIENCE_MACHINELIB_CONTACTLISTENER_H
 #define CANADIANEXPERIENCE_MACHINELIB_CONTACTLISTENER_H
 
-#include <map>
 #include <b2_world_callbacks.h>
 
 /**
@@ -18,41 +17,16 @@
  */
 class ContactListener : public b2ContactListener
 {
-private:
-    /**
-     * Keep track of bodies we want to dispatch
-     * the contact listener to.
-     */
-    std::map<b2Body*, b2ContactListener*> mDispatch;
-
-    bool ShouldDispatch(b2Contact *contact, int body, b2ContactListener* &listener);
-
 public:
-    /**
-     * Add a dispatched listener for some body.
-     * @param body Body to listen for
-     * @param listener Listener to call
-     */
-    void Add(b2Body* body, b2ContactListener* listener) {mDispatch[body] = listener;}
+    void Add(b2Body* body, b2ContactListener* listener);
 
     void BeginContact(b2Contact* contact) override;
 
-    /**
-     * Handle the end of a contact situation
-     * @param contact Contact object
-     */
-    void EndContact(b2Contact* contact) override
-    { /* handle end event */ }
+    void EndContact(b2Contact* contact) override;
 
     void PreSolve(b2Contact* contact, const b2Manifold* oldManifold) override;
 
-    /**
-     * Called after the solve has been computed, but before the contact is reported
-     * @param contact Contact object
-     * @param impulse Impulse related to the contact
-     */
-    void PostSolve(b2Contact* contact, const b2ContactImpulse* impulse) override
-    { /* handle post-solve event */ }
+    void PostSolve(b2Contact* contact, const b2ContactImpulse* impulse) override;
 };
 
 #endif //CANADIANEXPERIENCE_MACHINELIB_CONTACTLISTENER_H
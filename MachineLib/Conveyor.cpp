@@ -29,13 +29,32 @@ Conveyor::Conveyor(std::wstring imagesDir)
     mSink.SetComponent(this);
 }
 
+/**
+ * Copy constructor
+ * @param other Conveyor to copy
+ */
+Conveyor::Conveyor(const Conveyor &other) : Component(other), mPosition(other.mPosition),
+    mConveyor(other.mConveyor), mShaftPosition(other.mShaftPosition), mSpeed(other.mSpeed)
+{
+    mSink.SetComponent(this);
+}
+
+/**
+ * Create a copy of this conveyor that is not part of any machine
+ * @return New conveyor object
+ */
+std::shared_ptr<Component> Conveyor::Clone()
+{
+    return std::make_shared<Conveyor>(*this);
+}
+
 /**
  * Draw the conveyor
- * @param graphics the context to draw on
+ * @param list the display list to record into
  */
-void Conveyor::Draw(std::shared_ptr<wxGraphicsContext> graphics)
+void Conveyor::Draw(std::shared_ptr<DisplayList> list)
 {
-    mConveyor.Draw(graphics);
+    mConveyor.Draw(list);
 }
 
 /**
@@ -110,3 +129,24 @@ void Conveyor::PreSolve(b2Contact *contact, const b2Manifold *oldManifold)
 void Conveyor::ResetComponent()
 {
 }
+
+/**
+ * Save the state of the conveyor
+ * @param state Array to append the belt speed to
+ */
+void Conveyor::SaveState(std::vector<double> &state)
+{
+    Component::SaveState(state);
+    state.push_back(mSpeed);
+}
+
+/**
+ * Restore the state of the conveyor saved by SaveState
+ * @param state Array of saved state values
+ * @param index Index of the next value to read
+ */
+void Conveyor::LoadState(const std::vector<double> &state, size_t &index)
+{
+    Component::LoadState(state, index);
+    mSpeed = state[index++];
+}
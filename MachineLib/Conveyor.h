@@ -38,13 +38,14 @@ public:
     /// Destructor
     virtual ~Conveyor() {}
 
-    /** Copy constructor disabled */
-    Conveyor(const Conveyor &) = delete;
+    Conveyor(const Conveyor &other);
 
     /** Assignment operator disabled */
     void operator=(const Conveyor &) = delete;
 
-    void Draw(std::shared_ptr<wxGraphicsContext> graphics) override;
+    std::shared_ptr<Component> Clone() override;
+
+    void Draw(std::shared_ptr<DisplayList> list) override;
 
     void SetPosition(wxPoint2DDouble point);
 
@@ -62,7 +63,7 @@ public:
     * Get a pointer to the source object
     * @return Pointer to RotationSource object
     */
-    RotationSink *GetSink() { return &mSink; }
+    RotationSink *GetSink() override { return &mSink; }
 
     void Rotate(double rotation, double speed) override;
 
@@ -78,6 +79,10 @@ public:
 
     void ResetComponent() override;
 
+    void SaveState(std::vector<double> &state) override;
+
+    void LoadState(const std::vector<double> &state, size_t &index) override;
+
 };
 
 #endif //CANADIANEXPERIENCE_MACHINELIB_CONVEYOR_H
@@ -0,0 +1,588 @@
+/**
+ * @file DisplayList.cpp
+ * @author Frederick Fan
+ */
+
+#include "pch.h"
+#include "DisplayList.h"
+#include "include/ImageCache.h"
+
+/**
+ * Multiply two matrices
+ * @param other Matrix to apply before this one
+ * @return Matrix that applies other and then this
+ */
+DisplayList::Matrix DisplayList::Matrix::operator*(const Matrix &other) const
+{
+    Matrix m;
+    m.a = a * other.a + c * other.b;
+    m.b = b * other.a + d * other.b;
+    m.c = a * other.c + c * other.d;
+    m.d = b * other.c + d * other.d;
+    m.tx = a * other.tx + c * other.ty + tx;
+    m.ty = b * other.tx + d * other.ty + ty;
+    return m;
+}
+
+/**
+ * Compute the inverse of the matrix
+ * @return Inverse, or the identity if the matrix is singular
+ */
+DisplayList::Matrix DisplayList::Matrix::Inverse() const
+{
+    Matrix m;
+    double det = a * d - b * c;
+    if(det == 0)
+    {
+        return m;
+    }
+
+    m.a = d / det;
+    m.b = -b / det;
+    m.c = -c / det;
+    m.d = a / det;
+    m.tx = -(m.a * tx + m.c * ty);
+    m.ty = -(m.b * tx + m.d * ty);
+    return m;
+}
+
+/**
+ * Equality operator
+ * @param other Command to compare to
+ * @return true if the commands are the same
+ */
+bool DisplayList::Command::operator==(const Command &other) const
+{
+    return mType == other.mType && mMatrix == other.mMatrix && mClip == other.mClip &&
+        mBrush == other.mBrush && mPen == other.mPen && mFont == other.mFont &&
+        mResource == other.mResource && mFirst == other.mFirst && mCount == other.mCount &&
+        std::equal(mValues, mValues + 4, other.mValues);
+}
+
+/**
+ * Constructor
+ */
+DisplayList::DisplayList()
+{
+}
+
+/**
+ * Discard all of the commands. The memory is kept for the next
+ * recording, and so are the paths built by Replay.
+ */
+void DisplayList::Clear()
+{
+    mCommands.clear();
+    mMatrices.clear();
+    mClips.clear();
+    mPoints.clear();
+    mBrushes.clear();
+    mPens.clear();
+    mFonts.clear();
+    mTextures.clear();
+    mTexts.clear();
+    mStack.clear();
+
+    mMatrix = Matrix();
+    mClip = -1;
+    mBrush = -1;
+    mPen = -1;
+    mFont = -1;
+}
+
+/**
+ * Add a command with the current state
+ * @param type Kind of command
+ * @return The new command
+ */
+DisplayList::Command &DisplayList::Add(Type type)
+{
+    if(mMatrices.empty() || !(mMatrices.back() == mMatrix))
+    {
+        mMatrices.push_back(mMatrix);
+    }
+
+    mCommands.emplace_back();
+    auto &command = mCommands.back();
+    command.mType = type;
+    command.mMatrix = (int)mMatrices.size() - 1;
+    command.mClip = mClip;
+    command.mBrush = mBrush;
+    command.mPen = mPen;
+    command.mFont = mFont;
+    return command;
+}
+
+/**
+ * Save the current transformation and clip
+ */
+void DisplayList::PushState()
+{
+    mStack.push_back({mMatrix, mClip});
+}
+
+/**
+ * Restore the transformation and clip saved by the matching PushState
+ */
+void DisplayList::PopState()
+{
+    if(mStack.empty())
+    {
+        return;
+    }
+
+    mMatrix = mStack.back().mMatrix;
+    mClip = mStack.back().mClip;
+    mStack.pop_back();
+}
+
+/**
+ * Translate the coordinate system
+ * @param x X offset
+ * @param y Y offset
+ */
+void DisplayList::Translate(double x, double y)
+{
+    Matrix m;
+    m.tx = x;
+    m.ty = y;
+    mMatrix = mMatrix * m;
+}
+
+/**
+ * Rotate the coordinate system
+ * @param angle Angle in radians
+ */
+void DisplayList::Rotate(double angle)
+{
+    Matrix m;
+    m.a = cos(angle);
+    m.b = sin(angle);
+    m.c = -m.b;
+    m.d = m.a;
+    mMatrix = mMatrix * m;
+}
+
+/**
+ * Scale the coordinate system
+ * @param x X scale
+ * @param y Y scale
+ */
+void DisplayList::Scale(double x, double y)
+{
+    Matrix m;
+    m.a = x;
+    m.d = y;
+    mMatrix = mMatrix * m;
+}
+
+/**
+ * Clip the commands that follow to a rectangle
+ * @param x Left of the rectangle
+ * @param y Top of the rectangle
+ * @param width Width of the rectangle
+ * @param height Height of the rectangle
+ */
+void DisplayList::Clip(double x, double y, double width, double height)
+{
+    if(mMatrices.empty() || !(mMatrices.back() == mMatrix))
+    {
+        mMatrices.push_back(mMatrix);
+    }
+
+    mClips.emplace_back();
+    auto &clip = mClips.back();
+    clip.mMatrix = (int)mMatrices.size() - 1;
+    clip.mParent = mClip;
+    clip.mRect[0] = x;
+    clip.mRect[1] = y;
+    clip.mRect[2] = width;
+    clip.mRect[3] = height;
+    mClip = (int)mClips.size() - 1;
+}
+
+/**
+ * Clip the commands that follow to a region
+ * @param region Region to clip to
+ */
+void DisplayList::Clip(const wxRegion &region)
+{
+    Clip(0, 0, 0, 0);
+    mClips.back().mIsRegion = true;
+    mClips.back().mRegion = region;
+}
+
+/**
+ * Set the brush used to fill paths and rectangles
+ * @param brush Brush to use
+ */
+void DisplayList::SetBrush(const wxBrush &brush)
+{
+    if(mBrush >= 0 && mBrushes[mBrush] == brush)
+    {
+        return;
+    }
+
+    mBrushes.push_back(brush);
+    mBrush = (int)mBrushes.size() - 1;
+}
+
+/**
+ * Set the pen used to draw lines and outline rectangles
+ * @param pen Pen to use
+ */
+void DisplayList::SetPen(const wxPen &pen)
+{
+    if(mPen >= 0 && mPens[mPen] == pen)
+    {
+        return;
+    }
+
+    mPens.push_back(pen);
+    mPen = (int)mPens.size() - 1;
+}
+
+/**
+ * Set the font used to draw text
+ * @param font Font to use
+ * @param color Color of the text
+ */
+void DisplayList::SetFont(const wxFont &font, const wxColour &color)
+{
+    if(mFont >= 0 && mFonts[mFont].first == font && mFonts[mFont].second == color)
+    {
+        return;
+    }
+
+    mFonts.emplace_back(font, color);
+    mFont = (int)mFonts.size() - 1;
+}
+
+/**
+ * Fill a closed polygon with the current brush
+ * @param points Vertices of the polygon
+ */
+void DisplayList::FillPath(const std::vector<wxPoint2DDouble> &points)
+{
+    auto &command = Add(Type::FillPath);
+    command.mFirst = (int)mPoints.size();
+    command.mCount = (int)points.size();
+    mPoints.insert(mPoints.end(), points.begin(), points.end());
+}
+
+/**
+ * Draw a rectangle filled with the current brush and outlined with the current pen
+ * @param x Left of the rectangle
+ * @param y Top of the rectangle
+ * @param width Width of the rectangle
+ * @param height Height of the rectangle
+ */
+void DisplayList::DrawRectangle(double x, double y, double width, double height)
+{
+    auto &command = Add(Type::Rectangle);
+    command.mValues[0] = x;
+    command.mValues[1] = y;
+    command.mValues[2] = width;
+    command.mValues[3] = height;
+}
+
+/**
+ * Draw a line with the current pen
+ * @param x1 X of the start of the line
+ * @param y1 Y of the start of the line
+ * @param x2 X of the end of the line
+ * @param y2 Y of the end of the line
+ */
+void DisplayList::StrokeLine(double x1, double y1, double x2, double y2)
+{
+    auto &command = Add(Type::Line);
+    command.mValues[0] = x1;
+    command.mValues[1] = y1;
+    command.mValues[2] = x2;
+    command.mValues[3] = y2;
+}
+
+/**
+ * Draw an image stretched to a rectangle
+ * @param image Image to draw
+ * @param x Left of the rectangle
+ * @param y Top of the rectangle
+ * @param width Width of the rectangle
+ * @param height Height of the rectangle
+ */
+void DisplayList::DrawBitmap(std::shared_ptr<SharedImage> image, double x, double y, double width, double height)
+{
+    if(image == nullptr)
+    {
+        return;
+    }
+
+    int texture = (int)mTextures.size();
+    for(int i=0; i<(int)mTextures.size(); i++)
+    {
+        if(mTextures[i] == image)
+        {
+            texture = i;
+            break;
+        }
+    }
+
+    if(texture == (int)mTextures.size())
+    {
+        mTextures.push_back(image);
+    }
+
+    auto &command = Add(Type::Bitmap);
+    command.mResource = texture;
+    command.mValues[0] = x;
+    command.mValues[1] = y;
+    command.mValues[2] = width;
+    command.mValues[3] = height;
+}
+
+/**
+ * Draw text with the current font
+ * @param text Text to draw
+ * @param x Left of the text
+ * @param y Top of the text
+ */
+void DisplayList::DrawText(const wxString &text, double x, double y)
+{
+    auto &command = Add(Type::Text);
+    command.mResource = (int)mTexts.size();
+    command.mValues[0] = x;
+    command.mValues[1] = y;
+    mTexts.push_back(text);
+}
+
+/**
+ * Start drawing into a layer that is blended when it ends
+ * @param opacity Opacity of the layer in the range 0 to 1
+ */
+void DisplayList::BeginLayer(double opacity)
+{
+    auto &command = Add(Type::BeginLayer);
+    command.mValues[0] = opacity;
+}
+
+/**
+ * End the layer started by the matching BeginLayer
+ */
+void DisplayList::EndLayer()
+{
+    Add(Type::EndLayer);
+}
+
+/**
+ * Apply a clip and all of the clips it is inside of
+ * @param graphics Graphics context to clip
+ * @param clip Index of the clip
+ * @param current Transformation the context has relative to where
+ * replay started. Updated to the transformation of the clip.
+ */
+void DisplayList::ApplyClip(std::shared_ptr<wxGraphicsContext> graphics, int clip, Matrix &current) const
+{
+    if(clip < 0)
+    {
+        return;
+    }
+
+    auto &entry = mClips[clip];
+    ApplyClip(graphics, entry.mParent, current);
+
+    auto &matrix = mMatrices[entry.mMatrix];
+    auto relative = current.Inverse() * matrix;
+    if(!relative.IsIdentity())
+    {
+        graphics->ConcatTransform(graphics->CreateMatrix(relative.a, relative.b, relative.c,
+                                                         relative.d, relative.tx, relative.ty));
+    }
+    current = matrix;
+
+    if(entry.mIsRegion)
+    {
+        graphics->Clip(entry.mRegion);
+    }
+    else
+    {
+        graphics->Clip(entry.mRect[0], entry.mRect[1], entry.mRect[2], entry.mRect[3]);
+    }
+}
+
+/**
+ * Draw the recorded commands onto a graphics context.
+ *
+ * The commands are drawn relative to the transformation and clip the
+ * context has when this is called. Consecutive commands that share a
+ * transformation and clip are drawn without restoring the state in
+ * between, and brushes, pens and fonts are only set when they change.
+ * @param graphics Graphics context to draw on
+ */
+void DisplayList::Replay(std::shared_ptr<wxGraphicsContext> graphics) const
+{
+    // State of the context, -2 when unknown
+    bool open = false;
+    int matrix = -2;
+    int clip = -2;
+    int brush = -2;
+    int pen = -2;
+    int font = -2;
+
+    // Paths are only valid for the renderer that created them
+    if(mPathRenderer != graphics->GetRenderer())
+    {
+        mPaths.clear();
+        mPathRenderer = graphics->GetRenderer();
+    }
+    size_t pathIndex = 0;
+
+    auto close = [&]() {
+        if(open)
+        {
+            graphics->PopState();
+            open = false;
+        }
+    };
+
+    for(auto &command : mCommands)
+    {
+        if(command.mType == Type::BeginLayer || command.mType == Type::EndLayer)
+        {
+            close();
+            if(command.mType == Type::BeginLayer)
+            {
+                graphics->BeginLayer(command.mValues[0]);
+            }
+            else
+            {
+                graphics->EndLayer();
+            }
+            continue;
+        }
+
+        if(!open || command.mMatrix != matrix || command.mClip != clip)
+        {
+            close();
+            graphics->PushState();
+            open = true;
+            matrix = command.mMatrix;
+            clip = command.mClip;
+
+            Matrix current;
+            ApplyClip(graphics, clip, current);
+
+            auto relative = current.Inverse() * mMatrices[matrix];
+            if(!relative.IsIdentity())
+            {
+                graphics->ConcatTransform(graphics->CreateMatrix(relative.a, relative.b, relative.c,
+                                                                 relative.d, relative.tx, relative.ty));
+            }
+        }
+
+        if(command.mBrush != brush && command.mBrush >= 0 &&
+            (command.mType == Type::FillPath || command.mType == Type::Rectangle))
+        {
+            graphics->SetBrush(mBrushes[command.mBrush]);
+            brush = command.mBrush;
+        }
+
+        if(command.mPen != pen && command.mPen >= 0 &&
+            (command.mType == Type::Line || command.mType == Type::Rectangle))
+        {
+            graphics->SetPen(mPens[command.mPen]);
+            pen = command.mPen;
+        }
+
+        auto values = command.mValues;
+        switch(command.mType)
+        {
+        case Type::FillPath:
+            if(command.mCount > 0)
+            {
+                if(pathIndex == mPaths.size())
+                {
+                    mPaths.emplace_back();
+                }
+
+                // The path from the last replay is reused if it has the same points
+                auto &path = mPaths[pathIndex++];
+                auto first = mPoints.begin() + command.mFirst;
+                auto last = first + command.mCount;
+                if(path.mPath.IsNull() || !std::equal(first, last, path.mPoints.begin(), path.mPoints.end()))
+                {
+                    path.mPoints.assign(first, last);
+                    path.mPath = graphics->CreatePath();
+                    path.mPath.MoveToPoint(*first);
+                    for(auto point = first + 1; point != last; ++point)
+                    {
+                        path.mPath.AddLineToPoint(*point);
+                    }
+                    path.mPath.CloseSubpath();
+                    mPathsBuilt++;
+                }
+
+                graphics->FillPath(path.mPath);
+            }
+            break;
+
+        case Type::Rectangle:
+            graphics->DrawRectangle(values[0], values[1], values[2], values[3]);
+            break;
+
+        case Type::Line:
+            graphics->StrokeLine(values[0], values[1], values[2], values[3]);
+            break;
+
+        case Type::Bitmap:
+            graphics->DrawBitmap(mTextures[command.mResource]->GetBitmap(graphics),
+                                 values[0], values[1], values[2], values[3]);
+            break;
+
+        case Type::Text:
+            if(command.mFont >= 0 && command.mFont != font)
+            {
+                graphics->SetFont(mFonts[command.mFont].first, mFonts[command.mFont].second);
+                font = command.mFont;
+            }
+            graphics->DrawText(mTexts[command.mResource], values[0], values[1]);
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    close();
+}
+
+/**
+ * Does this list draw exactly the same thing as another list?
+ *
+ * Used to tell if a frame has changed since the last one. Images
+ * are compared by identity and everything else by value.
+ * @param other List to compare to
+ * @return true if the lists are the same
+ */
+bool DisplayList::IsSameAs(const DisplayList &other) const
+{
+    if(mCommands != other.mCommands || mMatrices != other.mMatrices || mPoints != other.mPoints ||
+        mBrushes != other.mBrushes || mPens != other.mPens || mFonts != other.mFonts ||
+        mTextures != other.mTextures || mTexts != other.mTexts || mClips.size() != other.mClips.size())
+    {
+        return false;
+    }
+
+    for(size_t i=0; i<mClips.size(); i++)
+    {
+        auto &a = mClips[i];
+        auto &b = other.mClips[i];
+        if(a.mMatrix != b.mMatrix || a.mParent != b.mParent || a.mIsRegion != b.mIsRegion ||
+            !std::equal(a.mRect, a.mRect + 4, b.mRect) ||
+            (a.mIsRegion && !a.mRegion.IsEqual(b.mRegion)))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
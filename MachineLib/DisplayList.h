@@ -0,0 +1,328 @@
+/**
+ * @file DisplayList.h
+ * @author Frederick Fan
+ *
+ * A recorded list of drawing commands
+ */
+
+#ifndef CANADIANEXPERIENCE_MACHINELIB_DISPLAYLIST_H
+#define CANADIANEXPERIENCE_MACHINELIB_DISPLAYLIST_H
+
+#include <memory>
+#include <vector>
+
+class SharedImage;
+
+/**
+ * A recorded list of drawing commands.
+ *
+ * Components draw into a display list with the same calls they would
+ * make on a wxGraphicsContext. Rather than drawing anything, each call
+ * appends a command to a flat buffer. Every command carries the full
+ * transformation and clip it was recorded under, so commands don't
+ * depend on the ones before them and no graphics context is needed
+ * to record. Replay then draws the commands onto a graphics context.
+ *
+ * The buffers keep their memory when the list is cleared, so a list
+ * that is recorded every frame stops allocating after the first one.
+ * Bitmaps are recorded by the shared image they come from, so the
+ * same list can be replayed onto contexts from different renderers.
+ *
+ * The paths Replay builds for the filled paths are kept when the list
+ * is cleared, with the points each was built from. A polygon records
+ * its points in its own coordinates and where it goes in the matrix,
+ * so when a frame is recorded again, a path with the same points as
+ * the one in the same place of the last recording is reused, however
+ * far the polygon moved. Paths are only built again when the points
+ * change or the list is replayed on another renderer.
+ */
+class DisplayList
+{
+public:
+    /// An affine transformation in the same form as wxGraphicsMatrix
+    struct Matrix
+    {
+        /// Elements of the matrix. A point maps to
+        /// (a*x + c*y + tx, b*x + d*y + ty)
+        double a = 1, b = 0, c = 0, d = 1, tx = 0, ty = 0;
+
+        Matrix operator*(const Matrix &other) const;
+
+        Matrix Inverse() const;
+
+        /**
+         * Is this the identity transformation?
+         * @return true if it leaves every point in place
+         */
+        bool IsIdentity() const { return a == 1 && b == 0 && c == 0 && d == 1 && tx == 0 && ty == 0; }
+
+        /**
+         * Equality operator
+         * @param other Matrix to compare to
+         * @return true if every element is the same
+         */
+        bool operator==(const Matrix &other) const
+        {
+            return a == other.a && b == other.b && c == other.c && d == other.d && tx == other.tx && ty == other.ty;
+        }
+    };
+
+    /// The kinds of command
+    enum class Type {FillPath, Rectangle, Line, Bitmap, Text, BeginLayer, EndLayer};
+
+    /// A single recorded drawing command
+    struct Command
+    {
+        /// What the command draws
+        Type mType;
+
+        /// Index of the transformation in the matrix list
+        int mMatrix = 0;
+
+        /// Index of the innermost clip in the clip list, -1 for none
+        int mClip = -1;
+
+        /// Index of the brush in effect, -1 if none was set
+        int mBrush = -1;
+
+        /// Index of the pen in effect, -1 if none was set
+        int mPen = -1;
+
+        /// Index of the font in effect, -1 if none was set
+        int mFont = -1;
+
+        /// Index of the texture for bitmaps or the string for text
+        int mResource = -1;
+
+        /// Index of the first path point
+        int mFirst = 0;
+
+        /// Number of path points
+        int mCount = 0;
+
+        /// Rectangle, line end points or text location. For
+        /// a layer the first value is the opacity.
+        double mValues[4] = {0, 0, 0, 0};
+
+        bool operator==(const Command &other) const;
+    };
+
+    /// A clip that applies to commands recorded after it
+    struct ClipArea
+    {
+        /// Transformation the clip was recorded under
+        int mMatrix = 0;
+
+        /// Clip that was already in effect, -1 for none
+        int mParent = -1;
+
+        /// Is the clip a region rather than a rectangle?
+        bool mIsRegion = false;
+
+        /// Rectangle to clip to
+        double mRect[4] = {0, 0, 0, 0};
+
+        /// Region to clip to
+        wxRegion mRegion;
+    };
+
+private:
+    /// A path built by Replay for a filled path command
+    struct Path
+    {
+        /// Points the path was built from
+        std::vector<wxPoint2DDouble> mPoints;
+
+        /// The path
+        wxGraphicsPath mPath;
+    };
+
+    /// Transformation and clip saved by PushState
+    struct State
+    {
+        /// Transformation
+        Matrix mMatrix;
+
+        /// Clip index
+        int mClip;
+    };
+
+    /// The recorded commands in drawing order
+    std::vector<Command> mCommands;
+
+    /// Transformations used by the commands
+    std::vector<Matrix> mMatrices;
+
+    /// Clips used by the commands
+    std::vector<ClipArea> mClips;
+
+    /// Points for the filled paths
+    std::vector<wxPoint2DDouble> mPoints;
+
+    /// Brushes used by the commands
+    std::vector<wxBrush> mBrushes;
+
+    /// Pens used by the commands
+    std::vector<wxPen> mPens;
+
+    /// Fonts used by the commands, with the text color
+    std::vector<std::pair<wxFont, wxColour>> mFonts;
+
+    /// Images bitmaps are drawn from
+    std::vector<std::shared_ptr<SharedImage>> mTextures;
+
+    /// Strings for the text commands
+    std::vector<wxString> mTexts;
+
+    /// Paths built by Replay for the filled path commands, in
+    /// order. These are kept when the list is cleared.
+    mutable std::vector<Path> mPaths;
+
+    /// Renderer that created the paths in mPaths
+    mutable wxGraphicsRenderer *mPathRenderer = nullptr;
+
+    /// Number of paths Replay has built
+    mutable int mPathsBuilt = 0;
+
+    /// Stack of states saved by PushState
+    std::vector<State> mStack;
+
+    /// Current transformation
+    Matrix mMatrix;
+
+    /// Current clip index
+    int mClip = -1;
+
+    /// Current brush index
+    int mBrush = -1;
+
+    /// Current pen index
+    int mPen = -1;
+
+    /// Current font index
+    int mFont = -1;
+
+    Command &Add(Type type);
+
+    void ApplyClip(std::shared_ptr<wxGraphicsContext> graphics, int clip, Matrix &current) const;
+
+public:
+    DisplayList();
+
+    /// Copy constructor (disabled)
+    DisplayList(const DisplayList &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const DisplayList &) = delete;
+
+    void Clear();
+
+    void PushState();
+
+    void PopState();
+
+    void Translate(double x, double y);
+
+    void Rotate(double angle);
+
+    void Scale(double x, double y);
+
+    void Clip(double x, double y, double width, double height);
+
+    void Clip(const wxRegion &region);
+
+    void SetBrush(const wxBrush &brush);
+
+    void SetPen(const wxPen &pen);
+
+    void SetFont(const wxFont &font, const wxColour &color);
+
+    void FillPath(const std::vector<wxPoint2DDouble> &points);
+
+    void DrawRectangle(double x, double y, double width, double height);
+
+    void StrokeLine(double x1, double y1, double x2, double y2);
+
+    void DrawBitmap(std::shared_ptr<SharedImage> image, double x, double y, double width, double height);
+
+    void DrawText(const wxString &text, double x, double y);
+
+    void BeginLayer(double opacity);
+
+    void EndLayer();
+
+    void Replay(std::shared_ptr<wxGraphicsContext> graphics) const;
+
+    bool IsSameAs(const DisplayList &other) const;
+
+    /**
+     * Get the number of paths Replay has built for filled paths,
+     * rather than reusing one from an earlier replay
+     * @return Number of paths built since the list was created
+     */
+    int GetPathsBuilt() const { return mPathsBuilt; }
+
+    /**
+     * Get the recorded commands
+     * @return Commands in drawing order
+     */
+    const std::vector<Command> &GetCommands() const { return mCommands; }
+
+    /**
+     * Get a transformation used by the commands
+     * @param index Index from Command::mMatrix
+     * @return Transformation
+     */
+    const Matrix &GetMatrix(int index) const { return mMatrices[index]; }
+
+    /**
+     * Get an image used by the bitmap commands
+     * @param index Index from Command::mResource
+     * @return Image
+     */
+    const std::shared_ptr<SharedImage> &GetTexture(int index) const { return mTextures[index]; }
+
+    /**
+     * Get a clip used by the commands
+     * @param index Index from Command::mClip or ClipArea::mParent
+     * @return Clip
+     */
+    const ClipArea &GetClip(int index) const { return mClips[index]; }
+
+    /**
+     * Get a point of a filled path
+     * @param index Index from Command::mFirst onward
+     * @return Point
+     */
+    const wxPoint2DDouble &GetPoint(int index) const { return mPoints[index]; }
+
+    /**
+     * Get a brush used by the commands
+     * @param index Index from Command::mBrush
+     * @return Brush
+     */
+    const wxBrush &GetBrush(int index) const { return mBrushes[index]; }
+
+    /**
+     * Get a pen used by the commands
+     * @param index Index from Command::mPen
+     * @return Pen
+     */
+    const wxPen &GetPen(int index) const { return mPens[index]; }
+
+    /**
+     * Get a font used by the commands
+     * @param index Index from Command::mFont
+     * @return Font and text color
+     */
+    const std::pair<wxFont, wxColour> &GetFont(int index) const { return mFonts[index]; }
+
+    /**
+     * Get the string for a text command
+     * @param index Index from Command::mResource
+     * @return Text
+     */
+    const wxString &GetText(int index) const { return mTexts[index]; }
+};
+
+#endif //CANADIANEXPERIENCE_MACHINELIB_DISPLAYLIST_H
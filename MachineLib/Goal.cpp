@@ -11,6 +11,7 @@
 #include "Goal.h"
 #include "ContactListener.h"
 #include "Machine.h"
+#include "DisplayList.h"
 
 
 /// Image to draw for the goal
@@ -74,30 +75,30 @@ bool Goal::HitTest(wxPoint position)
 
 /**
  * Draw the goal
- * @param graphics graphics context being drawn on
+ * @param list display list being recorded into
  */
-void Goal::Draw(std::shared_ptr<wxGraphicsContext> graphics)
+void Goal::Draw(std::shared_ptr<DisplayList> list)
 {
-    mGoalPolygon.DrawPolygon(graphics, mPosition.m_x, mPosition.m_y,0);
-//    mGoal.Draw(graphics);
-//    mPost.Draw(graphics);
+    mGoalPolygon.DrawPolygon(list, mPosition.m_x, mPosition.m_y,0);
+//    mGoal.Draw(list);
+//    mPost.Draw(list);
 
 
     //code to draw the scoreboard
     wxBrush background(ScoreboardBackgroundColor);
-    graphics->SetBrush(background);
-    graphics->DrawRectangle(ScoreboardRectangle.m_x + mPosition.m_x,ScoreboardRectangle.m_y,
+    list->SetBrush(background);
+    list->DrawRectangle(ScoreboardRectangle.m_x + mPosition.m_x,ScoreboardRectangle.m_y,
                             ScoreboardRectangle.m_width ,ScoreboardRectangle.m_height);
 
     wxString score = wxString::Format(wxT("%i%i"), mScore/Ten%Ten, mScore%Ten);
 
-    graphics->PushState();
-    graphics->Translate(mPosition.m_x + ScoreboardTextLocation.m_x,mPosition.m_y + ScoreboardTextLocation.m_y);
-    graphics->Scale(1, -1);
+    list->PushState();
+    list->Translate(mPosition.m_x + ScoreboardTextLocation.m_x,mPosition.m_y + ScoreboardTextLocation.m_y);
+    list->Scale(1, -1);
     wxFont font(wxSize(ScoreboardFontSize, ScoreboardFontSize), wxFONTFAMILY_SWISS, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_BOLD);
-    graphics->SetFont(font, FontColor);
-    graphics->DrawText(score, 0, 0);
-    graphics->PopState();
+    list->SetFont(font, FontColor);
+    list->DrawText(score, 0, 0);
+    list->PopState();
 
 }
 
@@ -140,6 +141,24 @@ Goal::Goal(std::wstring imagesDir)
 
 }
 
+/**
+ * Copy constructor
+ * @param other Goal to copy
+ */
+Goal::Goal(const Goal &other) : Component(other), mGoalPolygon(other.mGoalPolygon),
+    mPost(other.mPost), mGoal(other.mGoal), mScore(other.mScore), mPosition(other.mPosition)
+{
+}
+
+/**
+ * Create a copy of this goal that is not part of any machine
+ * @return New goal object
+ */
+std::shared_ptr<Component> Goal::Clone()
+{
+    return std::make_shared<Goal>(*this);
+}
+
 /**
  * Install physics into the goal
  * @param world the machines b2World
@@ -194,3 +213,24 @@ void Goal::ResetComponent()
 {
     mScore = 0;
 }
+
+/**
+ * Save the state of the goal
+ * @param state Array to append the score to
+ */
+void Goal::SaveState(std::vector<double> &state)
+{
+    Component::SaveState(state);
+    state.push_back(mScore);
+}
+
+/**
+ * Restore the state of the goal saved by SaveState
+ * @param state Array of saved state values
+ * @param index Index of the next value to read
+ */
+void Goal::LoadState(const std::vector<double> &state, size_t &index)
+{
+    Component::LoadState(state, index);
+    mScore = (int)state[index++];
+}
@@ -40,18 +40,25 @@ public:
     /// Destructor
     virtual ~Goal() {}
 
-    /** Copy constructor disabled */
-    Goal(const Goal &) = delete;
+    Goal(const Goal &other);
 
     /** Assignment operator disabled */
     void operator=(const Goal &) = delete;
 
+    std::shared_ptr<Component> Clone() override;
+
     Goal(std::wstring directory);
-    void Draw(std::shared_ptr<wxGraphicsContext> graphics) override;
+    void Draw(std::shared_ptr<DisplayList> list) override;
     bool HitTest(wxPoint position);
     void UpdateTime(double time) override;
     void SetPosition(wxPoint2DDouble point);
 
+    /**
+     * Get the score on the scoreboard
+     * @return Score in points
+     */
+    int GetScore() const { return mScore; }
+
     void InstallPhysics(std::shared_ptr<b2World> world) override;
     void BeginContact(b2Contact *contact) override;
     void PreSolve(b2Contact *contact, const b2Manifold *oldManifold) override;
@@ -60,6 +67,10 @@ public:
 
     void ResetComponent() override;
 
+    void SaveState(std::vector<double> &state) override;
+
+    void LoadState(const std::vector<double> &state, size_t &index) override;
+
 };
 
 #endif //CANADIANEXPERIENCE_MACHINELIB_GOAL_H
@@ -10,6 +10,7 @@
 #include "Polygon.h"
 #include "PhysicsPolygon.h"
 #include "ContactListener.h"
+#include "DisplayList.h"
 
 
 /// The center point for drawing the wheel
@@ -83,6 +84,27 @@ Hamster::Hamster(std::wstring imagesDir)
                             //manually
 }
 
+/**
+ * Copy constructor. The hamster images are shared with the original.
+ * @param other Hamster to copy
+ */
+Hamster::Hamster(const Hamster &other) : Component(other), mIsAsleep(other.mIsAsleep),
+    mHamsters(other.mHamsters), mPosition(other.mPosition), mSpeed(other.mSpeed),
+    mCage(other.mCage), mWheel(other.mWheel), mHamsterShaft(other.mHamsterShaft),
+    mInitiallyRunning(other.mInitiallyRunning), mRotation(other.mRotation)
+{
+    mSource.SetComponent(this);
+}
+
+/**
+ * Create a copy of this hamster that is not part of any machine
+ * @return New hamster object
+ */
+std::shared_ptr<Component> Hamster::Clone()
+{
+    return std::make_shared<Hamster>(*this);
+}
+
 /**
  * Update the time
  * @param time the time to add
@@ -105,21 +127,21 @@ void Hamster::UpdateTime(double time)
 
 /**
  * Draw the hamster
- * @param graphics the context being drawn on
+ * @param list the display list being recorded into
  */
-void Hamster::Draw(std::shared_ptr<wxGraphicsContext> graphics)
+void Hamster::Draw(std::shared_ptr<DisplayList> list)
 {
 
-    mCage.Draw(graphics);
-    mWheel.DrawPolygon(graphics, mPosition.m_x+WheelCenter.m_x, mPosition.m_y+WheelCenter.m_y, mRotation);
+    mCage.Draw(list);
+    mWheel.DrawPolygon(list, mPosition.m_x+WheelCenter.m_x, mPosition.m_y+WheelCenter.m_y, mRotation);
     int hamsterIndex = 0;
 
-    graphics->PushState();
-    graphics->Translate(mPosition.m_x + WheelCenter.m_x, mPosition.m_y + WheelCenter.m_y);
+    list->PushState();
+    list->Translate(mPosition.m_x + WheelCenter.m_x, mPosition.m_y + WheelCenter.m_y);
 
     if(mSpeed < 0)
     {
-        graphics->Scale(-1, 1);
+        list->Scale(-1, 1);
     }
 
     if (mIsAsleep)
@@ -154,8 +176,8 @@ void Hamster::Draw(std::shared_ptr<wxGraphicsContext> graphics)
 
     }
 
-    mHamsters[hamsterIndex]->DrawPolygon(graphics, 0, -WheelCenter.m_y, NoRotation);
-    graphics->PopState();
+    mHamsters[hamsterIndex]->DrawPolygon(list, 0, -WheelCenter.m_y, NoRotation);
+    list->PopState();
 
 
 }
@@ -223,3 +245,26 @@ void Hamster::ResetComponent()
         mIsAsleep = true;
     }
 }
+
+/**
+ * Save the state of the hamster
+ * @param state Array to append the asleep flag and wheel rotation to
+ */
+void Hamster::SaveState(std::vector<double> &state)
+{
+    Component::SaveState(state);
+    state.push_back(mIsAsleep ? 1 : 0);
+    state.push_back(mRotation);
+}
+
+/**
+ * Restore the state of the hamster saved by SaveState
+ * @param state Array of saved state values
+ * @param index Index of the next value to read
+ */
+void Hamster::LoadState(const std::vector<double> &state, size_t &index)
+{
+    Component::LoadState(state, index);
+    mIsAsleep = state[index++] != 0;
+    mRotation = state[index++];
+}
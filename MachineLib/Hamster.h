@@ -57,13 +57,14 @@ public:
     /// Destructor
     virtual ~Hamster() {}
 
-    /** Copy constructor disabled */
-    Hamster(const Hamster &) = delete;
+    Hamster(const Hamster &other);
 
     /** Assignment operator disabled */
     void operator=(const Hamster &) = delete;
 
-    void Draw(std::shared_ptr<wxGraphicsContext> graphics) override;
+    std::shared_ptr<Component> Clone() override;
+
+    void Draw(std::shared_ptr<DisplayList> list) override;
 
     void UpdateTime(double time) override;
 
@@ -92,12 +93,16 @@ public:
      * Get a pointer to the source object
      * @return Pointer to RotationSource object
      */
-    RotationSource *GetSource() { return &mSource; }
+    RotationSource *GetSource() override { return &mSource; }
 
     void BeginContact(b2Contact *contact) override;
 
 
     void ResetComponent() override;
+
+    void SaveState(std::vector<double> &state) override;
+
+    void LoadState(const std::vector<double> &state, size_t &index) override;
 };
 
 #endif //CANADIANEXPERIENCE_MACHINELIB_HAMSTER_H
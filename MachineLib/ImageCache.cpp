@@ -0,0 +1,95 @@
+/**
+ * @file ImageCache.cpp
+ * @author Frederick Fan
+ */
+
+#include "pch.h"
+#include "include/ImageCache.h"
+
+/// Protects the cached images
+static std::mutex CacheMutex;
+
+/// The loaded images keyed by path
+static std::map<std::wstring, std::weak_ptr<SharedImage>> CacheImages;
+
+/**
+ * Get the graphics bitmap for this image, creating it
+ * the first time it is drawn with a renderer
+ * @param graphics Graphics context to draw with
+ * @return Graphics bitmap
+ */
+wxGraphicsBitmap SharedImage::GetBitmap(std::shared_ptr<wxGraphicsContext> graphics)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    auto &bitmap = mBitmaps[graphics->GetRenderer()];
+    if(bitmap.IsNull())
+    {
+        bitmap = graphics->CreateBitmapFromImage(mImage);
+    }
+
+    return bitmap;
+}
+
+/**
+ * Load an image, sharing it with anything that has already loaded it
+ * @param filename Image filename
+ * @return Shared image or nullptr if the image could not be loaded
+ */
+std::shared_ptr<SharedImage> ImageCache::Load(const std::wstring &filename)
+{
+    std::lock_guard<std::mutex> lock(CacheMutex);
+
+    auto found = CacheImages.find(filename);
+    if(found != CacheImages.end())
+    {
+        auto image = found->second.lock();
+        if(image != nullptr)
+        {
+            return image;
+        }
+    }
+
+    // Drop any images nobody is using anymore
+    for(auto i = CacheImages.begin(); i != CacheImages.end(); )
+    {
+        if(i->second.expired())
+        {
+            i = CacheImages.erase(i);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    wxImage decoded;
+    if(!decoded.LoadFile(filename, wxBITMAP_TYPE_ANY))
+    {
+        return nullptr;
+    }
+
+    auto image = std::make_shared<SharedImage>(decoded);
+    CacheImages[filename] = image;
+    return image;
+}
+
+/**
+ * Get the number of images currently loaded
+ * @return Number of images
+ */
+size_t ImageCache::GetCount()
+{
+    std::lock_guard<std::mutex> lock(CacheMutex);
+
+    size_t count = 0;
+    for(auto &image : CacheImages)
+    {
+        if(!image.second.expired())
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
@@ -8,6 +8,14 @@
 #include "Component.h"
 #include "ContactListener.h"
 #include "MachineSystemActual.h"
+#include "MachineCheckpoint.h"
+#include "MachineBake.h"
+#include "MachineTrace.h"
+#include "DisplayList.h"
+#include "RotationSource.h"
+#include "RotationSink.h"
+#include <map>
+#include <set>
 
 /// Gravity in meters per second per second
 const float Gravity = -9.8f;
@@ -18,13 +26,22 @@ const int VelocityIterations = 6;
 /// Number of position update iterations per step
 const int PositionIterations = 2;
 
+/// Default size of a physics step in seconds. This matches the
+/// default animation frame rate, so one frame is one step.
+const double DefaultStepSize = 1.0 / 30.0;
+
+/// Tolerance when deciding if enough time has accumulated for
+/// another step, so rounding error doesn't drop a step
+const double StepEpsilon = 1e-9;
+
 
 /**
  * constructor
  * @param machineId the id of the machine
  */
-Machine::Machine(int machineId)
+Machine::Machine(int machineId) : mStepSize(DefaultStepSize)
 {
+    mDisplayList = std::make_shared<DisplayList>();
     mWorld = std::make_shared<b2World>(b2Vec2(0.0f, Gravity));
     mMachineId = machineId;
 }
@@ -35,12 +52,24 @@ Machine::Machine(int machineId)
  */
 void Machine::Draw(std::shared_ptr<wxGraphicsContext> graphics)
 {
-    for (auto component : mComponents)
-    {
+    mDisplayList->Clear();
+    Record(mDisplayList);
+    mDisplayList->Replay(graphics);
+}
 
-        component->Draw(graphics);
+/**
+ * Record drawing the machine into a display list.
+ *
+ * Nothing is drawn, so this does not need a graphics context. The
+ * list can then be replayed onto as many contexts as needed.
+ * @param list Display list to add the drawing to
+ */
+void Machine::Record(std::shared_ptr<DisplayList> list)
+{
+    for (auto &component : mComponents)
+    {
+        component->Draw(list);
     }
-
 }
 
 /**
@@ -51,28 +80,142 @@ void Machine::AddComponent(std::shared_ptr<Component> component)
 {
     mComponents.push_back(component);
     component->SetParentMachine(this);
+    mRotationCompiled = false;
+    mInstalled = false;
 }
 
 /**
  * Update the machine in time
+ *
+ * The physics is always advanced in fixed steps of mStepSize, no
+ * matter what the elapsed time is. Time left over that is less than
+ * a step is kept and used by the next update.
  * @param elapsed Elapsed time in seconds
  */
 void Machine::Update(double elapsed)
+{
+    mAccumulator += elapsed;
+
+    int steps = 0;
+    while(mAccumulator >= mStepSize - StepEpsilon)
+    {
+        if(mMaxSubSteps > 0 && steps >= mMaxSubSteps)
+        {
+            // Too far behind, drop the rest of the time
+            mAccumulator = 0;
+            break;
+        }
+
+        Step(mStepSize);
+        mAccumulator -= mStepSize;
+        steps++;
+    }
+
+    if(mAccumulator < 0)
+    {
+        mAccumulator = 0;
+    }
+
+    if(mTrace != nullptr)
+    {
+        mTrace->Record(HashState());
+    }
+}
+
+/**
+ * Compute a hash of the exact state of the machine.
+ *
+ * Covers the position, angle, velocities and awake flag of every
+ * body and the state of every component, bit for bit, so any
+ * difference at all between two machines gives a different hash.
+ * @return 64-bit hash of the state
+ */
+uint64_t Machine::HashState()
+{
+    auto hash = MachineTrace::HashStart;
+
+    for(auto body : mBodies)
+    {
+        float values[] = {body->GetPosition().x, body->GetPosition().y, body->GetAngle(),
+                          body->GetLinearVelocity().x, body->GetLinearVelocity().y,
+                          body->GetAngularVelocity(), body->IsAwake() ? 1.0f : 0.0f};
+        hash = MachineTrace::Hash(hash, values, sizeof(values));
+    }
+
+    mState.clear();
+    for (auto &component : mComponents)
+    {
+        component->SaveState(mState);
+    }
+    return MachineTrace::Hash(hash, mState.data(), mState.size() * sizeof(double));
+}
+
+/**
+ * Advance the machine one fixed physics step
+ * @param step Step size in seconds
+ */
+void Machine::Step(double step)
 {
     // Call Update on all of our components so they can advance in time
 
     for (auto component : mComponents)
     {
-        component->UpdateTime(elapsed);
+        component->UpdateTime(step);
     }
-    // Advance the physics system one frame in time
-    mWorld->Step(elapsed, VelocityIterations, PositionIterations);
+    // Advance the physics system one step in time
+    mWorld->Step(step, VelocityIterations, PositionIterations);
+}
+
+/**
+ * Set the size of the fixed physics steps
+ * @param step Step size in seconds
+ */
+void Machine::SetStepSize(double step)
+{
+    wxASSERT(step > 0);
+    mStepSize = step;
+    mAccumulator = 0;
 }
 
 /**
  * Reset the b2World
+ *
+ * The first reset builds the world and saves its state. After that,
+ * the world is reset in place by putting that state back into the
+ * same bodies, which is much faster than building a new world with
+ * all of its bodies and fixtures. The state includes everything Box2D
+ * keeps to itself, so a run after a reset is exactly the run of a new
+ * machine.
  */
 void Machine::Reset()
+{
+    if (!mRotationCompiled)
+    {
+        CompileRotation();
+    }
+
+    mAccumulator = 0;
+
+    if (mInstalled)
+    {
+        mInitialPhysics.Restore(mWorld.get());
+    }
+    else
+    {
+        BuildWorld();
+    }
+
+    for (auto component : mComponents)
+    {
+        component->ResetComponent();
+    }
+}
+
+/**
+ * Build a new b2World with the physics for all of the components
+ * and save the initial state of the world
+ */
+void Machine::BuildWorld()
 {
     mWorld = std::make_shared<b2World>(b2Vec2(0.0f, Gravity));
 
@@ -82,12 +225,119 @@ void Machine::Reset()
 
     InstallPhysics();
 
+    mBodies.clear();
+    for(auto body = mWorld->GetBodyList(); body != nullptr; body = body->GetNext())
+    {
+        mBodies.push_back(body);
+    }
+
+    mInitialPhysics.Save(mWorld.get());
+    mInstalled = true;
+}
+
+/**
+ * Flatten the connections between rotation sources and sinks
+ * into a plan for each source that is not driven by another.
+ *
+ * Each plan is the drives downstream of that source in topological
+ * order, so when the source rotates it sweeps the array once instead
+ * of recursing through the chain. A source driven from more than one
+ * root is in the plan of each of them, just as the recursion would
+ * reach it from each of them. Sources that are part of a cycle can
+ * never be ordered and are left out of every plan.
+ */
+void Machine::CompileRotation()
+{
+    // Every source and whether another source drives it
+    std::vector<RotationSource*> sources;
+    std::set<RotationSource*> driven;
     for (auto component : mComponents)
     {
-        component->ResetComponent();
+        auto source = component->GetSource();
+        if (source != nullptr)
+        {
+            source->ClearPlan();
+            sources.push_back(source);
+        }
     }
 
+    for (auto source : sources)
+    {
+        for (auto sink : source->GetSinks())
+        {
+            auto target = sink->GetComponent()->GetSource();
+            if (target != nullptr)
+            {
+                driven.insert(target);
+            }
+        }
+    }
+
+    std::set<RotationSource*> ordered;
+    for (auto root : sources)
+    {
+        if (driven.count(root) != 0)
+        {
+            continue;
+        }
+
+        // The sources reachable from this root and how many
+        // sources among them drive each one
+        std::map<RotationSource*, int> drivers = {{root, 0}};
+        std::vector<RotationSource*> reached = {root};
+        for (size_t i = 0; i < reached.size(); i++)
+        {
+            for (auto sink : reached[i]->GetSinks())
+            {
+                auto target = sink->GetComponent()->GetSource();
+                if (target != nullptr)
+                {
+                    if (drivers.emplace(target, 0).second)
+                    {
+                        reached.push_back(target);
+                    }
+                    drivers[target]++;
+                }
+            }
+        }
 
+        // Kahn's algorithm over them
+        std::vector<RotationSource::Drive> plan;
+        std::vector<RotationSource*> ready = {root};
+        for (size_t i = 0; i < ready.size(); i++)
+        {
+            auto source = ready[i];
+            ordered.insert(source);
+
+            for (auto sink : source->GetSinks())
+            {
+                // Sinks turn at the same rate as their source
+                plan.push_back({source, 1.0, sink});
+
+                auto target = sink->GetComponent()->GetSource();
+                if (target != nullptr && --drivers[target] == 0)
+                {
+                    ready.push_back(target);
+                }
+            }
+        }
+
+        root->SetPlan(std::move(plan), false);
+    }
+
+    // Driven sources only record their rotation for the plans to read.
+    // This also leaves any cycle disconnected rather than recursing forever.
+    for (auto source : driven)
+    {
+        source->SetPlan({}, true);
+    }
+
+    if (ordered.size() < sources.size())
+    {
+        wxFAIL_MSG(L"Rotation sources in the machine form a cycle");
+    }
+
+    mRotationCompiled = true;
 }
 
 /**
@@ -102,11 +352,171 @@ void Machine::InstallPhysics()
     }
 }
 
+/**
+ * Create a copy of this machine with copies of all of its components.
+ *
+ * The copy shares images and geometry with this machine, but
+ * has its own physics and state. It must be reset before use.
+ * @return New machine object
+ */
+std::shared_ptr<Machine> Machine::Clone()
+{
+    auto machine = std::make_shared<Machine>(mMachineId);
+    machine->mStepSize = mStepSize;
+    machine->mMaxSubSteps = mMaxSubSteps;
+
+    std::map<Component*, std::shared_ptr<Component>> clones;
+    for (auto component : mComponents)
+    {
+        auto clone = component->Clone();
+        clones[component.get()] = clone;
+        machine->AddComponent(clone);
+    }
+
+    // Connect the clones the same way the originals are connected
+    for (auto component : mComponents)
+    {
+        component->ConnectClone(clones[component.get()].get(), clones);
+    }
+
+    return machine;
+}
+
+/**
+ * Create a checkpoint of the current state of the machine
+ * @param frame The frame number the machine is currently at
+ * @return New checkpoint object
+ */
+std::shared_ptr<MachineCheckpoint> Machine::CreateCheckpoint(int frame)
+{
+    auto checkpoint = std::make_shared<MachineCheckpoint>(frame);
+
+    auto &bodies = checkpoint->GetBodies();
+    bodies.reserve(mBodies.size());
+    for(auto body : mBodies)
+    {
+        MachineCheckpoint::BodyState state;
+        state.mPosition = body->GetPosition();
+        state.mAngle = body->GetAngle();
+        state.mLinearVelocity = body->GetLinearVelocity();
+        state.mAngularVelocity = body->GetAngularVelocity();
+        state.mAwake = body->IsAwake();
+        bodies.push_back(state);
+    }
+
+    checkpoint->GetPhysics().Save(mWorld.get());
+
+    for (auto component : mComponents)
+    {
+        component->SaveState(checkpoint->GetComponentState());
+    }
+
+    checkpoint->SetAccumulator(mAccumulator);
+
+    return checkpoint;
+}
+
+/**
+ * Restore the machine to the state saved in a checkpoint.
+ *
+ * The world is put back in the saved state in place, with the same
+ * bodies, like a reset. The checkpoint holds the solver state Box2D
+ * keeps to itself too, so the machine then steps on exactly like the
+ * run that took the checkpoint, no matter what it was doing before.
+ * The checkpoint may come from another machine built the same way.
+ * @param checkpoint Checkpoint to restore
+ */
+void Machine::RestoreCheckpoint(const MachineCheckpoint &checkpoint)
+{
+    if (!mRotationCompiled)
+    {
+        CompileRotation();
+    }
+
+    if (!mInstalled)
+    {
+        BuildWorld();
+    }
 
+    for (auto component : mComponents)
+    {
+        component->ResetComponent();
+    }
+
+    checkpoint.GetPhysics().Restore(mWorld.get());
+
+    size_t index = 0;
+    for (auto component : mComponents)
+    {
+        component->LoadState(checkpoint.GetComponentState(), index);
+    }
+
+    mAccumulator = checkpoint.GetAccumulator();
+}
+
+/**
+ * Record the drawn state of the machine as the next frame of a bake
+ * @param bake Bake to add the frame to
+ * @return true if the frame was recorded
+ */
+bool Machine::RecordFrame(MachineBake &bake)
+{
+    mState.clear();
+    for (auto component : mComponents)
+    {
+        component->SaveState(mState);
+    }
 
+    if(!bake.BeginFrame((int)mBodies.size(), (int)mState.size()))
+    {
+        return false;
+    }
 
+    int frame = bake.GetFrameCount() - 1;
+    auto x = bake.GetX(frame);
+    auto y = bake.GetY(frame);
+    auto angle = bake.GetAngle(frame);
+    for(size_t i=0; i<mBodies.size(); i++)
+    {
+        auto &position = mBodies[i]->GetPosition();
+        x[i] = position.x;
+        y[i] = position.y;
+        angle[i] = mBodies[i]->GetAngle();
+    }
 
+    std::copy(mState.begin(), mState.end(), bake.GetState(frame));
+    return true;
+}
 
+/**
+ * Put the machine in the drawn state of a recorded frame.
+ *
+ * This moves the bodies and restores the component state without
+ * any simulation. Velocities and contacts are not recorded, so the
+ * machine cannot be simulated onward from here. It has to be reset
+ * or restored from a checkpoint first.
+ * @param bake Bake to get the frame from
+ * @param frame Frame number, less than bake.GetFrameCount()
+ */
+void Machine::ApplyBakedFrame(const MachineBake &bake, int frame)
+{
+    wxASSERT(frame >= 0 && frame < bake.GetFrameCount());
+    wxASSERT(bake.GetBodyCount() == (int)mBodies.size());
 
+    auto x = bake.GetX(frame);
+    auto y = bake.GetY(frame);
+    auto angle = bake.GetAngle(frame);
+    for(size_t i=0; i<mBodies.size(); i++)
+    {
+        mBodies[i]->SetTransform(b2Vec2(x[i], y[i]), angle[i]);
+    }
 
+    auto state = bake.GetState(frame);
+    mState.assign(state, state + bake.GetStateSize());
 
+    size_t index = 0;
+    for (auto component : mComponents)
+    {
+        component->LoadState(mState, index);
+    }
+}
@@ -9,10 +9,14 @@
 #define CANADIANEXPERIENCE_MACHINELIB_MACHINE_H
 
 #include "box2d.h"
+#include "MachineCheckpoint.h"
 
 class ContactListener;
 class Component;
 class MachineSystemActual;
+class MachineBake;
+class MachineTrace;
+class DisplayList;
 
 /** Class for a machine **/
 
@@ -32,6 +36,41 @@ private:
     /// The installed contact filter
     std::shared_ptr<ContactListener> mContactListener = nullptr;
 
+    /// Size of each fixed physics step in seconds
+    double mStepSize;
+
+    /// Most physics steps taken in a single update, 0 for no limit
+    int mMaxSubSteps = 0;
+
+    /// Elapsed time not yet simulated in seconds
+    double mAccumulator = 0;
+
+    /// The bodies in the world in world body list order
+    std::vector<b2Body*> mBodies;
+
+    /// Scratch space for component state
+    std::vector<double> mState;
+
+    /// Has the world been built with the physics for the current components?
+    bool mInstalled = false;
+
+    /// State of the world when it was built
+    PhysicsState mInitialPhysics;
+
+    /// Has the rotation plan been compiled for the current components?
+    bool mRotationCompiled = false;
+
+    /// Trace to record the state hash into after each update, if any
+    std::shared_ptr<MachineTrace> mTrace;
+
+    /// Display list Draw records into, kept to reuse its memory
+    std::shared_ptr<DisplayList> mDisplayList;
+
+    void Step(double step);
+
+    void CompileRotation();
+
+    void BuildWorld();
 
 
 public:
@@ -47,6 +86,8 @@ public:
     void operator=(const Machine &) = delete;
 
     void Draw(std::shared_ptr<wxGraphicsContext> graphics);
+
+    void Record(std::shared_ptr<DisplayList> list);
     void AddComponent(std::shared_ptr<Component> component);
 
     void Update(double elapsed);
@@ -55,6 +96,50 @@ public:
 
     void InstallPhysics();
 
+    /**
+     * Get the components of the machine
+     * @return Components in the order they were added
+     */
+    const std::vector<std::shared_ptr<Component>> &GetComponents() const { return mComponents; }
+
+    std::shared_ptr<Machine> Clone();
+
+    std::shared_ptr<MachineCheckpoint> CreateCheckpoint(int frame);
+
+    void RestoreCheckpoint(const MachineCheckpoint &checkpoint);
+
+    bool RecordFrame(MachineBake &bake);
+
+    void ApplyBakedFrame(const MachineBake &bake, int frame);
+
+    void SetStepSize(double step);
+
+    uint64_t HashState();
+
+    /**
+     * Set a trace to record the hash of the state into after every update
+     * @param trace Trace to record into, nullptr to stop tracing
+     */
+    void SetTrace(std::shared_ptr<MachineTrace> trace) { mTrace = trace; }
+
+    /**
+     * Get the size of each fixed physics step
+     * @return Step size in seconds
+     */
+    double GetStepSize() const { return mStepSize; }
+
+    /**
+     * Set the most physics steps a single update may take. Any
+     * time beyond that is dropped rather than simulated.
+     * @param steps Maximum number of steps, 0 for no limit
+     */
+    void SetMaxSubSteps(int steps) { mMaxSubSteps = steps; }
+
+    /**
+     * Get the most physics steps a single update may take
+     * @return Maximum number of steps, 0 for no limit
+     */
+    int GetMaxSubSteps() const { return mMaxSubSteps; }
 
 };
 
@@ -20,9 +20,10 @@ const std::wstring ImagesDirectory = L"/images";
 /**
  * Constructor
  * @param resourcesDir Path to the resources directory
+ * @param parameters Tunable values for the machine
  */
-Machine1Factory::Machine1Factory(std::wstring resourcesDir) :
-    mResourcesDir(resourcesDir)
+Machine1Factory::Machine1Factory(std::wstring resourcesDir, const MachineParameters &parameters) :
+    mResourcesDir(resourcesDir), mParameters(parameters)
 {
     mImagesDir = mResourcesDir + ImagesDirectory;
 }
@@ -97,7 +98,7 @@ std::shared_ptr<Machine> Machine1Factory::Create()
     hamsterAndConveyorFactory.AddBall(40);
     auto hamster1 = hamsterAndConveyorFactory.GetHamster();
     auto conveyor1 = hamsterAndConveyorFactory.GetConveyor();
-    hamster1->SetSpeed(-1);
+    hamster1->SetSpeed(-1 * mParameters.mConveyorSpeedScale);
 
     //
     // Second conveyor with a ball on it
@@ -111,6 +112,7 @@ std::shared_ptr<Machine> Machine1Factory::Create()
     hamsterAndConveyorFactory.Create(conveyor1->GetPosition() + wxPoint2DDouble(-105, -40), conveyor2position);
     hamsterAndConveyorFactory.AddBall(-40);
     auto hamster2 = hamsterAndConveyorFactory.GetHamster();
+    hamster2->SetSpeed(mParameters.mConveyorSpeedScale);
     auto conveyor2 = hamsterAndConveyorFactory.GetConveyor();
 
     //
@@ -121,7 +123,7 @@ std::shared_ptr<Machine> Machine1Factory::Create()
     hamsterAndConveyorFactory.Create(conveyor2position + wxPoint2DDouble(260, 20), conveyor3position);
     hamsterAndConveyorFactory.AddBall(-40);
     auto hamster3 = hamsterAndConveyorFactory.GetHamster();
-    hamster3->SetSpeed(1.5);
+    hamster3->SetSpeed(1.5 * mParameters.mConveyorSpeedScale);
     auto conveyor3 = hamsterAndConveyorFactory.GetConveyor();
 
     //
@@ -266,7 +268,7 @@ void Machine1Factory::DominoesOnBeam(std::shared_ptr<Machine> machine, wxPoint2D
     for(int d=0; d<10; d++)
     {
         // Where to put this domino
-        auto dominos = position + wxPoint2DDouble(-70 + d * 15, 27);
+        auto dominos = position + wxPoint2DDouble(-70 + d * mParameters.mDominoSpacing, 27);
 
         Domino(machine, dominos, 0, DominoColor::Green);
     }
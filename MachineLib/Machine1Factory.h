@@ -10,6 +10,7 @@
 
 #include <memory>
 #include <string>
+#include "MachineParameters.h"
 
 class Machine;
 class Body;
@@ -27,6 +28,9 @@ private:
     /// Path to the images directory
     std::wstring mImagesDir;
 
+    /// Tunable values for the machine
+    MachineParameters mParameters;
+
     /// The possible domino colors
     enum class DominoColor { Black, Red, Green, Blue };
 
@@ -45,7 +49,7 @@ private:
     std::shared_ptr<Body> Domino(std::shared_ptr<Machine> machine, wxPoint2DDouble position, double rotation, DominoColor color);
 
 public:
-    Machine1Factory(std::wstring resourcesDir);
+    Machine1Factory(std::wstring resourcesDir, const MachineParameters &parameters = MachineParameters());
 
     std::shared_ptr<Machine> Create();
 
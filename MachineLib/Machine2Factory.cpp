@@ -25,9 +25,10 @@ const std::wstring ImagesDirectory = L"/images";
 /**
 * Constructor
 * @param resourcesDir Path to the resources directory
+* @param parameters Tunable values for the machine
 */
-Machine2Factory::Machine2Factory(std::wstring resourcesDir) :
-    mResourcesDir(resourcesDir)
+Machine2Factory::Machine2Factory(std::wstring resourcesDir, const MachineParameters &parameters) :
+    mResourcesDir(resourcesDir), mParameters(parameters)
 {
     mImagesDir = mResourcesDir + ImagesDirectory;
 }
@@ -109,6 +110,7 @@ std::shared_ptr<Machine> Machine2Factory::Create()
 
     auto basket = std::make_shared<Basket>(mImagesDir);
     basket->SetPosition(wxPoint(145, 0));
+    basket->SetBasketShot(mParameters.mBasketShot);
     machine->AddComponent(basket);
 
     auto goal = std::make_shared<Goal>(mImagesDir);
@@ -118,12 +120,14 @@ std::shared_ptr<Machine> Machine2Factory::Create()
 
     auto hamster = std::make_shared<Hamster>(mImagesDir);
     hamster->SetPosition(wxPoint(-250,0));
+    hamster->SetSpeed(mParameters.mConveyorSpeedScale);
     machine->AddComponent(hamster);
     hamster->SetInitiallyRunning(true);
     auto hamsterShaft = hamster->GetShaftPosition();
 
     auto basket2 = std::make_shared<Basket>(mImagesDir);
     basket2->SetPosition(wxPoint(-250, 50));
+    basket2->SetBasketShot(mParameters.mBasketShot);
     machine->AddComponent(basket2);
 
     auto basket3 = std::make_shared<Basket>(mImagesDir);
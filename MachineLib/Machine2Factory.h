@@ -8,6 +8,8 @@
 #ifndef CANADIANEXPERIENCE_MACHINELIB_MACHINE2FACTORY_H
 #define CANADIANEXPERIENCE_MACHINELIB_MACHINE2FACTORY_H
 
+#include "MachineParameters.h"
+
 class Machine;
 
 /** Factory class for creating machine 2 */
@@ -21,9 +23,12 @@ private:
     /// Path to the images directory
     std::wstring mImagesDir;
 
+    /// Tunable values for the machine
+    MachineParameters mParameters;
+
 public:
 
-    Machine2Factory(std::wstring resourcesDir);
+    Machine2Factory(std::wstring resourcesDir, const MachineParameters &parameters = MachineParameters());
 
     std::shared_ptr<Machine>Create();
 
@@ -0,0 +1,62 @@
+/**
+ * @file MachineBake.cpp
+ * @author Frederick Fan
+ */
+
+#include "pch.h"
+#include "MachineBake.h"
+
+/**
+ * Discard all recorded frames
+ */
+void MachineBake::Clear()
+{
+    mBodyCount = 0;
+    mStateSize = 0;
+    mFrameCount = 0;
+    mX.clear();
+    mY.clear();
+    mAngle.clear();
+    mState.clear();
+}
+
+/**
+ * Add space for the next frame to the end of the recording.
+ *
+ * The first frame recorded sets the number of bodies and state
+ * values. A machine always has the same number of both, so a
+ * frame that does not match is refused.
+ * @param bodyCount Number of bodies in the frame
+ * @param stateSize Number of component state values in the frame
+ * @return true if space for the frame was added
+ */
+bool MachineBake::BeginFrame(int bodyCount, int stateSize)
+{
+    if(mFrameCount == 0)
+    {
+        mBodyCount = bodyCount;
+        mStateSize = stateSize;
+    }
+    else if(bodyCount != mBodyCount || stateSize != mStateSize)
+    {
+        return false;
+    }
+
+    mFrameCount++;
+    mX.resize((size_t)mFrameCount * mBodyCount);
+    mY.resize((size_t)mFrameCount * mBodyCount);
+    mAngle.resize((size_t)mFrameCount * mBodyCount);
+    mState.resize((size_t)mFrameCount * mStateSize);
+    return true;
+}
+
+/**
+ * Get the approximate amount of memory the recording uses
+ * @return Size in bytes
+ */
+size_t MachineBake::GetMemorySize() const
+{
+    return sizeof(MachineBake) +
+        (mX.capacity() + mY.capacity() + mAngle.capacity()) * sizeof(float) +
+        mState.capacity() * sizeof(double);
+}
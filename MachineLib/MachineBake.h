@@ -0,0 +1,137 @@
+/**
+ * @file MachineBake.h
+ * @author Frederick Fan
+ *
+ * A recording of the drawn state of a machine for a range of frames
+ */
+
+#ifndef CANADIANEXPERIENCE_MACHINELIB_MACHINEBAKE_H
+#define CANADIANEXPERIENCE_MACHINELIB_MACHINEBAKE_H
+
+#include <vector>
+
+/**
+ * A recording of the drawn state of a machine for a range of frames.
+ *
+ * Frames are recorded contiguously starting at frame 0. Each frame
+ * holds the position and angle of every body in the world and the
+ * saved state of every component. The values are kept as a structure
+ * of arrays, one array per quantity, indexed by
+ * frame * count + item, so a frame is a few contiguous copies.
+ */
+class MachineBake
+{
+private:
+    /// Number of bodies in each frame
+    int mBodyCount = 0;
+
+    /// Number of component state values in each frame
+    int mStateSize = 0;
+
+    /// Number of frames recorded
+    int mFrameCount = 0;
+
+    /// Body X positions in meters
+    std::vector<float> mX;
+
+    /// Body Y positions in meters
+    std::vector<float> mY;
+
+    /// Body angles in radians
+    std::vector<float> mAngle;
+
+    /// Component state values
+    std::vector<double> mState;
+
+public:
+    /// Constructor
+    MachineBake() {}
+
+    /// Copy constructor (disabled)
+    MachineBake(const MachineBake &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const MachineBake &) = delete;
+
+    void Clear();
+
+    bool BeginFrame(int bodyCount, int stateSize);
+
+    size_t GetMemorySize() const;
+
+    /**
+     * Get the number of frames recorded
+     * @return Number of frames, frames 0 to count-1 are available
+     */
+    int GetFrameCount() const { return mFrameCount; }
+
+    /**
+     * Get the number of bodies in each frame
+     * @return Number of bodies
+     */
+    int GetBodyCount() const { return mBodyCount; }
+
+    /**
+     * Get the number of component state values in each frame
+     * @return Number of values
+     */
+    int GetStateSize() const { return mStateSize; }
+
+    /**
+     * Get the body X positions for a frame
+     * @param frame Frame number
+     * @return Pointer to GetBodyCount() values
+     */
+    float *GetX(int frame) { return mX.data() + (size_t)frame * mBodyCount; }
+
+    /**
+     * Get the body Y positions for a frame
+     * @param frame Frame number
+     * @return Pointer to GetBodyCount() values
+     */
+    float *GetY(int frame) { return mY.data() + (size_t)frame * mBodyCount; }
+
+    /**
+     * Get the body angles for a frame
+     * @param frame Frame number
+     * @return Pointer to GetBodyCount() values
+     */
+    float *GetAngle(int frame) { return mAngle.data() + (size_t)frame * mBodyCount; }
+
+    /**
+     * Get the component state for a frame
+     * @param frame Frame number
+     * @return Pointer to GetStateSize() values
+     */
+    double *GetState(int frame) { return mState.data() + (size_t)frame * mStateSize; }
+
+    /**
+     * Get the body X positions for a frame
+     * @param frame Frame number
+     * @return Pointer to GetBodyCount() values
+     */
+    const float *GetX(int frame) const { return mX.data() + (size_t)frame * mBodyCount; }
+
+    /**
+     * Get the body Y positions for a frame
+     * @param frame Frame number
+     * @return Pointer to GetBodyCount() values
+     */
+    const float *GetY(int frame) const { return mY.data() + (size_t)frame * mBodyCount; }
+
+    /**
+     * Get the body angles for a frame
+     * @param frame Frame number
+     * @return Pointer to GetBodyCount() values
+     */
+    const float *GetAngle(int frame) const { return mAngle.data() + (size_t)frame * mBodyCount; }
+
+    /**
+     * Get the component state for a frame
+     * @param frame Frame number
+     * @return Pointer to GetStateSize() values
+     */
+    const double *GetState(int frame) const { return mState.data() + (size_t)frame * mStateSize; }
+};
+
+#endif //CANADIANEXPERIENCE_MACHINELIB_MACHINEBAKE_H
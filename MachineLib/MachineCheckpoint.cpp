@@ -0,0 +1,19 @@
+/**
+ * @file MachineCheckpoint.cpp
+ * @author Frederick Fan
+ */
+
+#include "pch.h"
+#include "MachineCheckpoint.h"
+
+/**
+ * Get the approximate amount of memory this checkpoint uses
+ * @return Size in bytes
+ */
+size_t MachineCheckpoint::GetMemorySize() const
+{
+    return sizeof(MachineCheckpoint) - sizeof(PhysicsState) +
+        mBodies.capacity() * sizeof(BodyState) +
+        mComponentState.capacity() * sizeof(double) +
+        mPhysics.GetMemorySize();
+}
@@ -0,0 +1,131 @@
+/**
+ * @file MachineCheckpoint.h
+ * @author Frederick Fan
+ *
+ * A snapshot of the complete state of a machine at some frame
+ */
+
+#ifndef CANADIANEXPERIENCE_MACHINELIB_MACHINECHECKPOINT_H
+#define CANADIANEXPERIENCE_MACHINELIB_MACHINECHECKPOINT_H
+
+#include <vector>
+#include "box2d.h"
+#include "PhysicsState.h"
+
+/**
+ * A snapshot of the complete state of a machine at some frame.
+ *
+ * Bodies are stored in the order of the b2World body list. A machine
+ * keeps its bodies in the same order on every reset, so the index of
+ * a body is enough to find it again when the checkpoint is restored.
+ * Components save whatever state of their own they need into a flat
+ * array of values, in the order they were added to the machine.
+ *
+ * The body states are what the checkpoint shows of the bodies. The
+ * physics state holds everything Box2D needs to step on from here,
+ * including the solver state it keeps to itself, so a machine restored
+ * from a checkpoint continues exactly like the run that took it.
+ */
+class MachineCheckpoint
+{
+public:
+    /// The saved state of a single physics body
+    struct BodyState
+    {
+        /// Position of the body in meters
+        b2Vec2 mPosition;
+
+        /// Angle of the body in radians
+        float mAngle = 0;
+
+        /// Linear velocity in meters per second
+        b2Vec2 mLinearVelocity;
+
+        /// Angular velocity in radians per second
+        float mAngularVelocity = 0;
+
+        /// Is the body awake?
+        bool mAwake = true;
+    };
+
+private:
+    /// The frame this checkpoint was taken at
+    int mFrame = 0;
+
+    /// The state of every body in the world
+    std::vector<BodyState> mBodies;
+
+    /// The state of the components, concatenated
+    std::vector<double> mComponentState;
+
+    /// The complete state of the b2World
+    PhysicsState mPhysics;
+
+    /// Time accumulated toward the next physics step
+    double mAccumulator = 0;
+
+public:
+    /**
+     * Constructor
+     * @param frame The frame this checkpoint is taken at
+     */
+    explicit MachineCheckpoint(int frame) : mFrame(frame) {}
+
+    /**
+     * Get the frame this checkpoint was taken at
+     * @return Frame number
+     */
+    int GetFrame() const { return mFrame; }
+
+    /**
+     * Get the saved body states
+     * @return Vector of body states in world body list order
+     */
+    std::vector<BodyState> &GetBodies() { return mBodies; }
+
+    /**
+     * Get the saved body states
+     * @return Vector of body states in world body list order
+     */
+    const std::vector<BodyState> &GetBodies() const { return mBodies; }
+
+    /**
+     * Get the saved component state
+     * @return Flat array of component state values
+     */
+    std::vector<double> &GetComponentState() { return mComponentState; }
+
+    /**
+     * Get the saved component state
+     * @return Flat array of component state values
+     */
+    const std::vector<double> &GetComponentState() const { return mComponentState; }
+
+    /**
+     * Get the saved state of the b2World
+     * @return Physics state
+     */
+    PhysicsState &GetPhysics() { return mPhysics; }
+
+    /**
+     * Get the saved state of the b2World
+     * @return Physics state
+     */
+    const PhysicsState &GetPhysics() const { return mPhysics; }
+
+    /**
+     * Set the time accumulated toward the next physics step
+     * @param accumulator Time in seconds
+     */
+    void SetAccumulator(double accumulator) { mAccumulator = accumulator; }
+
+    /**
+     * Get the time accumulated toward the next physics step
+     * @return Time in seconds
+     */
+    double GetAccumulator() const { return mAccumulator; }
+
+    size_t GetMemorySize() const;
+};
+
+#endif //CANADIANEXPERIENCE_MACHINELIB_MACHINECHECKPOINT_H
@@ -0,0 +1,187 @@
+/**
+ * @file MachineFrameCache.cpp
+ * @author Frederick Fan
+ */
+
+#include "pch.h"
+#include "MachineFrameCache.h"
+#include "Machine.h"
+#include "MachineCheckpoint.h"
+
+/// Number of frames between checkpoints of the machine state
+const int CheckpointInterval = 30;
+
+/// Most memory the checkpoints are allowed to use in bytes.
+/// When this is exceeded the interval between checkpoints is doubled.
+const size_t CheckpointBudget = 8 * 1024 * 1024;
+
+/// Most memory the baked frames are allowed to use in bytes.
+/// Frames past this are simulated rather than recorded.
+const size_t BakeBudget = 64 * 1024 * 1024;
+
+/**
+ * Constructor
+ */
+MachineFrameCache::MachineFrameCache() : mCheckpointInterval(CheckpointInterval)
+{
+}
+
+/**
+ * Discard all checkpoints and baked frames
+ */
+void MachineFrameCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    mBake.Clear();
+    mCheckpoints.clear();
+    mCheckpointMemory = 0;
+    mCheckpointInterval = CheckpointInterval;
+}
+
+/**
+ * Get the number of frames that have been baked
+ * @return Number of frames, frames 0 to count-1 are baked
+ */
+int MachineFrameCache::GetFrameCount() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mBake.GetFrameCount();
+}
+
+/**
+ * Has the bake used up its memory budget?
+ * @return true if no more frames will be recorded
+ */
+bool MachineFrameCache::IsFull() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mBake.GetMemorySize() >= BakeBudget;
+}
+
+/**
+ * Get the number of checkpoints currently saved
+ * @return Number of checkpoints
+ */
+size_t MachineFrameCache::GetCheckpointCount() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mCheckpoints.size();
+}
+
+/**
+ * Get the number of frames between checkpoints
+ * @return Checkpoint interval in frames
+ */
+int MachineFrameCache::GetCheckpointInterval() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mCheckpointInterval;
+}
+
+/**
+ * Put a machine in the state of a baked frame
+ * @param machine Machine to set
+ * @param frame Frame number
+ * @return true if the frame was baked and applied
+ */
+bool MachineFrameCache::ApplyFrame(Machine &machine, int frame)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    if(frame < 0 || frame >= mBake.GetFrameCount())
+    {
+        return false;
+    }
+
+    machine.ApplyBakedFrame(mBake, frame);
+    return true;
+}
+
+/**
+ * Record the state of a machine if it is the next frame
+ * the bake is missing and we are under the budget.
+ * @param machine Machine to record
+ * @param frame Frame number the machine is at
+ * @return true if the frame was recorded
+ */
+bool MachineFrameCache::RecordFrame(Machine &machine, int frame)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    if(frame != mBake.GetFrameCount() || mBake.GetMemorySize() >= BakeBudget)
+    {
+        return false;
+    }
+
+    return machine.RecordFrame(mBake);
+}
+
+/**
+ * Save a checkpoint of a machine if the frame is on the checkpoint
+ * interval and we don't have a checkpoint for it yet.
+ *
+ * The machine is only read, so a run that saves checkpoints simulates
+ * exactly like one that doesn't. If this puts the checkpoints over the
+ * memory budget, the interval between the checkpoints we keep is
+ * doubled and the checkpoints that are no longer on the interval are
+ * discarded.
+ * @param machine Machine to save
+ * @param frame Frame number the machine is at
+ */
+void MachineFrameCache::AddCheckpoint(Machine &machine, int frame)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if(frame % mCheckpointInterval != 0 || mCheckpoints.find(frame) != mCheckpoints.end())
+        {
+            return;
+        }
+    }
+
+    // The machine belongs to the caller, so this doesn't need the lock
+    auto checkpoint = machine.CreateCheckpoint(frame);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    if(frame % mCheckpointInterval != 0 || mCheckpoints.find(frame) != mCheckpoints.end())
+    {
+        return;
+    }
+
+    mCheckpointMemory += checkpoint->GetMemorySize();
+    mCheckpoints[frame] = checkpoint;
+
+    while(mCheckpointMemory > CheckpointBudget && mCheckpoints.size() > 1)
+    {
+        mCheckpointInterval *= 2;
+        for(auto i = mCheckpoints.begin(); i != mCheckpoints.end(); )
+        {
+            if(i->first % mCheckpointInterval != 0)
+            {
+                mCheckpointMemory -= i->second->GetMemorySize();
+                i = mCheckpoints.erase(i);
+            }
+            else
+            {
+                ++i;
+            }
+        }
+    }
+}
+
+/**
+ * Find the latest checkpoint at or before a frame
+ * @param frame Frame number
+ * @return Checkpoint or nullptr if there is none
+ */
+std::shared_ptr<MachineCheckpoint> MachineFrameCache::FindCheckpoint(int frame) const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    auto checkpoint = mCheckpoints.upper_bound(frame);
+    if(checkpoint == mCheckpoints.begin())
+    {
+        return nullptr;
+    }
+
+    --checkpoint;
+    return checkpoint->second;
+}
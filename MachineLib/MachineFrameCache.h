@@ -0,0 +1,74 @@
+/**
+ * @file MachineFrameCache.h
+ * @author Frederick Fan
+ *
+ * The checkpoints and baked frames saved for a machine
+ */
+
+#ifndef CANADIANEXPERIENCE_MACHINELIB_MACHINEFRAMECACHE_H
+#define CANADIANEXPERIENCE_MACHINELIB_MACHINEFRAMECACHE_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include "MachineBake.h"
+
+class Machine;
+class MachineCheckpoint;
+
+/**
+ * The checkpoints and baked frames saved for a machine.
+ *
+ * The cache is shared between the machine system on the UI thread
+ * and the presimulator running ahead of it on a background thread,
+ * so all access is through these functions, which lock the cache.
+ * Each thread simulates its own Machine object and the cache only
+ * ever copies state in or out of the machine it is given.
+ */
+class MachineFrameCache
+{
+private:
+    /// Protects everything below
+    mutable std::mutex mMutex;
+
+    /// Frames of the machine recorded so they can be shown without simulation
+    MachineBake mBake;
+
+    /// Checkpoints of the machine state, keyed by frame number
+    std::map<int, std::shared_ptr<MachineCheckpoint>> mCheckpoints;
+
+    /// Number of frames between checkpoints
+    int mCheckpointInterval;
+
+    /// Memory currently used by the checkpoints in bytes
+    size_t mCheckpointMemory = 0;
+
+public:
+    MachineFrameCache();
+
+    /// Copy constructor (disabled)
+    MachineFrameCache(const MachineFrameCache &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const MachineFrameCache &) = delete;
+
+    void Clear();
+
+    int GetFrameCount() const;
+
+    bool IsFull() const;
+
+    size_t GetCheckpointCount() const;
+
+    int GetCheckpointInterval() const;
+
+    bool ApplyFrame(Machine &machine, int frame);
+
+    bool RecordFrame(Machine &machine, int frame);
+
+    void AddCheckpoint(Machine &machine, int frame);
+
+    std::shared_ptr<MachineCheckpoint> FindCheckpoint(int frame) const;
+};
+
+#endif //CANADIANEXPERIENCE_MACHINELIB_MACHINEFRAMECACHE_H
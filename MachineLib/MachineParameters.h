@@ -0,0 +1,30 @@
+/**
+ * @file MachineParameters.h
+ * @author Frederick Fan
+ *
+ * Tunable values used by the machine factories
+ */
+
+#ifndef CANADIANEXPERIENCE_MACHINELIB_MACHINEPARAMETERS_H
+#define CANADIANEXPERIENCE_MACHINELIB_MACHINEPARAMETERS_H
+
+/**
+ * Tunable values used by the machine factories.
+ *
+ * The defaults build the machines exactly as they appear in the
+ * animation. Other values are used to try out variants of a layout.
+ */
+struct MachineParameters
+{
+    /// Distance between the dominoes standing on the beam in machine 1 in centimeters
+    double mDominoSpacing = 15;
+
+    /// Velocity the baskets in machine 2 shoot the ball out at in meters per second.
+    /// The basket under the goal has its own shot and is not affected.
+    wxPoint2DDouble mBasketShot = wxPoint2DDouble(1, 7);
+
+    /// Scale applied to the speed of the hamsters that drive conveyors
+    double mConveyorSpeedScale = 1;
+};
+
+#endif //CANADIANEXPERIENCE_MACHINELIB_MACHINEPARAMETERS_H
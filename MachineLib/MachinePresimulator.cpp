@@ -0,0 +1,130 @@
+/**
+ * @file MachinePresimulator.cpp
+ * @author Frederick Fan
+ */
+
+#include "pch.h"
+#include "MachinePresimulator.h"
+#include "Machine.h"
+#include "MachineFrameCache.h"
+#include "MachineCheckpoint.h"
+
+/**
+ * Constructor. Starts the simulation thread.
+ * @param machine Machine to simulate. It must not be used by anyone else.
+ * @param cache Cache to record the frames into
+ * @param frameRate Frame rate in frames per second
+ */
+MachinePresimulator::MachinePresimulator(std::shared_ptr<Machine> machine,
+                                         std::shared_ptr<MachineFrameCache> cache, double frameRate) :
+    mMachine(std::move(machine)), mCache(std::move(cache)), mFrameRate(frameRate)
+{
+    mThread = std::thread(&MachinePresimulator::Run, this);
+}
+
+/**
+ * Destructor. Stops the simulation thread.
+ */
+MachinePresimulator::~MachinePresimulator()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mCondition.notify_all();
+
+    if(mThread.joinable())
+    {
+        mThread.join();
+    }
+}
+
+/**
+ * Set the last frame we want the cache to hold
+ * @param frame Frame number
+ */
+void MachinePresimulator::SetTarget(int frame)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if(frame == mTarget)
+        {
+            return;
+        }
+        mTarget = frame;
+
+        // The thread decides again if it has anything to do
+        mIdle = false;
+    }
+    mCondition.notify_all();
+}
+
+/**
+ * Wait until the cache holds every frame up to the target,
+ * or until nothing more can be recorded because it is full.
+ */
+void MachinePresimulator::Wait()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    mIdleCondition.wait(lock, [this]() { return mIdle || mFinished; });
+}
+
+/**
+ * The simulation thread
+ */
+void MachinePresimulator::Run()
+{
+    mMachine->Reset();
+    mFrame = 0;
+    mCache->AddCheckpoint(*mMachine, mFrame);
+    mCache->RecordFrame(*mMachine, mFrame);
+
+    while(true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            while(!mStop && mCache->GetFrameCount() > mTarget)
+            {
+                mIdle = true;
+                mIdleCondition.notify_all();
+                mCondition.wait(lock);
+            }
+
+            mIdle = false;
+            if(mStop)
+            {
+                return;
+            }
+        }
+
+        // If the machine system recorded frames past where we are before
+        // we were started, skip ahead using a checkpoint rather than
+        // simulating them again. Restoring a checkpoint continues the
+        // same simulation exactly, see Machine::RestoreCheckpoint.
+        int count = mCache->GetFrameCount();
+        if(mFrame < count - 1)
+        {
+            auto checkpoint = mCache->FindCheckpoint(count - 1);
+            if(checkpoint != nullptr && checkpoint->GetFrame() > mFrame)
+            {
+                mMachine->RestoreCheckpoint(*checkpoint);
+                mFrame = checkpoint->GetFrame();
+            }
+        }
+
+        mMachine->Update(1.0 / mFrameRate);
+        mFrame++;
+
+        mCache->AddCheckpoint(*mMachine, mFrame);
+        if(!mCache->RecordFrame(*mMachine, mFrame) && mCache->IsFull())
+        {
+            // Nothing more can be recorded, so there is
+            // nothing for us to do until we are stopped
+            std::unique_lock<std::mutex> lock(mMutex);
+            mFinished = true;
+            mIdleCondition.notify_all();
+            mCondition.wait(lock, [this]() { return mStop; });
+            return;
+        }
+    }
+}
@@ -0,0 +1,86 @@
+/**
+ * @file MachinePresimulator.h
+ * @author Frederick Fan
+ *
+ * Simulates a machine ahead of the playhead on a background thread
+ */
+
+#ifndef CANADIANEXPERIENCE_MACHINELIB_MACHINEPRESIMULATOR_H
+#define CANADIANEXPERIENCE_MACHINELIB_MACHINEPRESIMULATOR_H
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+class Machine;
+class MachineFrameCache;
+
+/**
+ * Simulates a machine ahead of the playhead on a background thread.
+ *
+ * The presimulator owns its own copy of the machine and simulates it
+ * from the beginning, recording the frames into the shared frame cache
+ * until the cache holds every frame up to the target. The machine system
+ * then shows those frames without doing any simulation itself. While a
+ * presimulator is running it is the only thing that records frames, so
+ * the recording is one continuous simulation.
+ */
+class MachinePresimulator
+{
+private:
+    /// The machine this thread simulates. Only used by the thread.
+    std::shared_ptr<Machine> mMachine;
+
+    /// Cache to record the frames into
+    std::shared_ptr<MachineFrameCache> mCache;
+
+    /// Frame rate in frames per second
+    double mFrameRate;
+
+    /// Frame our machine is at
+    int mFrame = 0;
+
+    /// Protects mTarget, mStop, mIdle and mFinished
+    std::mutex mMutex;
+
+    /// Signalled when the target changes or we are stopped
+    std::condition_variable mCondition;
+
+    /// Signalled when the thread has caught up with the target
+    std::condition_variable mIdleCondition;
+
+    /// Last frame we want recorded
+    int mTarget = 0;
+
+    /// Set to stop the thread
+    bool mStop = false;
+
+    /// True while the cache holds every frame up to the target
+    bool mIdle = false;
+
+    /// True once the cache is full and nothing more will be recorded
+    bool mFinished = false;
+
+    /// The simulation thread
+    std::thread mThread;
+
+    void Run();
+
+public:
+    MachinePresimulator(std::shared_ptr<Machine> machine, std::shared_ptr<MachineFrameCache> cache, double frameRate);
+
+    virtual ~MachinePresimulator();
+
+    /// Copy constructor (disabled)
+    MachinePresimulator(const MachinePresimulator &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const MachinePresimulator &) = delete;
+
+    void SetTarget(int frame);
+
+    void Wait();
+};
+
+#endif //CANADIANEXPERIENCE_MACHINELIB_MACHINEPRESIMULATOR_H
@@ -0,0 +1,61 @@
+/**
+ * @file MachinePrototypes.cpp
+ * @author Frederick Fan
+ */
+
+#include "pch.h"
+#include "MachinePrototypes.h"
+#include "Machine.h"
+#include "Machine1Factory.h"
+#include "Machine2Factory.h"
+#include <map>
+#include <mutex>
+
+/// Protects the prototypes
+static std::mutex PrototypesMutex;
+
+/// The prototype machines keyed by machine number and resources directory
+static std::map<std::pair<int, std::wstring>, std::shared_ptr<Machine>> Prototypes;
+
+/**
+ * Create a machine
+ * @param machineNumber Machine number, 2 for machine 2 and anything else for machine 1
+ * @param resourcesDir Path to the resources directory
+ * @return New machine object that has not been reset yet
+ */
+std::shared_ptr<Machine> MachinePrototypes::Create(int machineNumber, const std::wstring &resourcesDir)
+{
+    if (machineNumber != 2)
+    {
+        machineNumber = 1;
+    }
+
+    std::lock_guard<std::mutex> lock(PrototypesMutex);
+
+    auto &prototype = Prototypes[std::make_pair(machineNumber, resourcesDir)];
+    if (prototype == nullptr)
+    {
+        if (machineNumber == 2)
+        {
+            Machine2Factory factory(resourcesDir);
+            prototype = factory.Create();
+        }
+        else
+        {
+            Machine1Factory factory(resourcesDir);
+            prototype = factory.Create();
+        }
+    }
+
+    return prototype->Clone();
+}
+
+/**
+ * Discard all of the prototypes. Machines already cloned from them
+ * are not affected, and the next Create builds a new prototype.
+ */
+void MachinePrototypes::Clear()
+{
+    std::lock_guard<std::mutex> lock(PrototypesMutex);
+    Prototypes.clear();
+}
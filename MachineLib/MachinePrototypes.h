@@ -0,0 +1,37 @@
+/**
+ * @file MachinePrototypes.h
+ * @author Frederick Fan
+ *
+ * Registry of machine prototypes that new machines are cloned from
+ */
+
+#ifndef CANADIANEXPERIENCE_MACHINELIB_MACHINEPROTOTYPES_H
+#define CANADIANEXPERIENCE_MACHINELIB_MACHINEPROTOTYPES_H
+
+#include <memory>
+#include <string>
+
+class Machine;
+
+/**
+ * Registry of machine prototypes that new machines are cloned from.
+ *
+ * Each machine is built by its factory only the first time it is
+ * asked for. That machine is kept as a prototype and never simulated,
+ * and every machine after that is a clone of it. The clone shares
+ * the images and geometry of the prototype, so it is much cheaper
+ * than running the factory again.
+ *
+ * The prototypes hold images and bitmaps, so Clear must be called
+ * before wxWidgets shuts down rather than leaving them to static
+ * destruction.
+ */
+class MachinePrototypes
+{
+public:
+    static std::shared_ptr<Machine> Create(int machineNumber, const std::wstring &resourcesDir);
+
+    static void Clear();
+};
+
+#endif //CANADIANEXPERIENCE_MACHINELIB_MACHINEPROTOTYPES_H
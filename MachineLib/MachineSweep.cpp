@@ -0,0 +1,120 @@
+/**
+ * @file MachineSweep.cpp
+ * @author Frederick Fan
+ */
+
+#include "pch.h"
+#include "MachineSweep.h"
+#include "Machine.h"
+#include "Machine1Factory.h"
+#include "Machine2Factory.h"
+#include "Goal.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+/**
+ * Constructor
+ * @param machineNumber Machine number, 2 for machine 2 and anything else for machine 1
+ * @param resourcesDir Path to the resources directory
+ */
+MachineSweep::MachineSweep(int machineNumber, std::wstring resourcesDir) :
+    mMachineNumber(machineNumber == 2 ? 2 : 1), mResourcesDir(std::move(resourcesDir))
+{
+}
+
+/**
+ * Simulate all of the variants
+ * @return One result for each variant in the order they were added
+ */
+std::vector<MachineSweep::Result> MachineSweep::Run()
+{
+    std::vector<Result> results(mVariants.size());
+    std::vector<std::shared_ptr<Machine>> machines;
+    machines.reserve(mVariants.size());
+
+    for(size_t i=0; i<mVariants.size(); i++)
+    {
+        results[i].mParameters = mVariants[i];
+
+        if(mMachineNumber == 2)
+        {
+            Machine2Factory factory(mResourcesDir, mVariants[i]);
+            machines.push_back(factory.Create());
+        }
+        else
+        {
+            Machine1Factory factory(mResourcesDir, mVariants[i]);
+            machines.push_back(factory.Create());
+        }
+    }
+
+    int frames = (int)(mDuration * mFrameRate + 0.5);
+
+    // Index of the next machine waiting to be simulated
+    std::atomic<size_t> next(0);
+
+    auto worker = [&]() {
+        for(size_t i = next++; i < machines.size(); i = next++)
+        {
+            auto &machine = machines[i];
+            auto &result = results[i];
+
+            std::vector<std::shared_ptr<Goal>> goals;
+            for(auto &component : machine->GetComponents())
+            {
+                auto goal = std::dynamic_pointer_cast<Goal>(component);
+                if(goal != nullptr)
+                {
+                    goals.push_back(goal);
+                }
+            }
+
+            machine->Reset();
+            for(int frame=0; frame<frames; frame++)
+            {
+                machine->Update(1.0 / mFrameRate);
+
+                int score = 0;
+                for(auto &goal : goals)
+                {
+                    score += goal->GetScore();
+                }
+
+                if(score > 0 && result.mGoalTime < 0)
+                {
+                    result.mGoalTime = (frame + 1) / mFrameRate;
+                }
+                result.mScore = score;
+            }
+        }
+    };
+
+    int threadCount = mThreadCount;
+    if(threadCount <= 0)
+    {
+        threadCount = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+    threadCount = std::min(threadCount, (int)std::max<size_t>(1, machines.size()));
+
+    std::vector<std::thread> threads;
+    for(int t=1; t<threadCount; t++)
+    {
+        threads.emplace_back(worker);
+    }
+
+    // The calling thread takes its share too
+    worker();
+
+    for(auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    // The machines share pens, brushes and images whose reference counts
+    // are not thread safe, so they are only released here, on our thread
+    machines.clear();
+
+    return results;
+}
@@ -0,0 +1,101 @@
+/**
+ * @file MachineSweep.h
+ * @author Frederick Fan
+ *
+ * Simulates many variants of a machine in parallel
+ */
+
+#ifndef CANADIANEXPERIENCE_MACHINELIB_MACHINESWEEP_H
+#define CANADIANEXPERIENCE_MACHINELIB_MACHINESWEEP_H
+
+#include <string>
+#include <vector>
+#include "MachineParameters.h"
+
+/**
+ * Simulates many variants of a machine in parallel.
+ *
+ * Each variant is a set of parameters for the machine factory. The
+ * machines are all built on the calling thread, since building them
+ * loads images, and then simulated headless on a pool of threads.
+ * Every machine has its own Box2D world, so the threads share nothing
+ * but the list of machines still waiting to run.
+ */
+class MachineSweep
+{
+public:
+    /// The outcome of simulating one variant
+    struct Result
+    {
+        /// Parameters the machine was built with
+        MachineParameters mParameters;
+
+        /// Total score on the goals at the end of the simulation
+        int mScore = 0;
+
+        /// Time the first goal was scored in seconds, or -1 if there was none
+        double mGoalTime = -1;
+    };
+
+private:
+    /// Machine number to build
+    int mMachineNumber;
+
+    /// Path to the resources directory
+    std::wstring mResourcesDir;
+
+    /// Frame rate the machines are updated at in frames per second
+    double mFrameRate = 30;
+
+    /// How long to simulate each machine in seconds
+    double mDuration = 30;
+
+    /// Number of threads to use, 0 for one per hardware thread
+    int mThreadCount = 0;
+
+    /// The variants to simulate
+    std::vector<MachineParameters> mVariants;
+
+public:
+    MachineSweep(int machineNumber, std::wstring resourcesDir);
+
+    /// Copy constructor (disabled)
+    MachineSweep(const MachineSweep &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const MachineSweep &) = delete;
+
+    /**
+     * Add a variant to simulate
+     * @param parameters Parameters to build the machine with
+     */
+    void AddVariant(const MachineParameters &parameters) { mVariants.push_back(parameters); }
+
+    /**
+     * Get the number of variants that will be simulated
+     * @return Number of variants
+     */
+    size_t GetVariantCount() const { return mVariants.size(); }
+
+    /**
+     * Set the frame rate the machines are updated at
+     * @param rate Frame rate in frames per second
+     */
+    void SetFrameRate(double rate) { mFrameRate = rate; }
+
+    /**
+     * Set how long to simulate each machine
+     * @param duration Duration in seconds
+     */
+    void SetDuration(double duration) { mDuration = duration; }
+
+    /**
+     * Set the number of threads to simulate on
+     * @param count Number of threads, 0 for one per hardware thread
+     */
+    void SetThreadCount(int count) { mThreadCount = count; }
+
+    std::vector<Result> Run();
+};
+
+#endif //CANADIANEXPERIENCE_MACHINELIB_MACHINESWEEP_H
@@ -9,9 +9,11 @@
 #include "MachineSystemActual.h"
 
 #include "Machine.h"
+#include "MachineCheckpoint.h"
+#include "MachineFrameCache.h"
+#include "MachinePresimulator.h"
 #include "MachineCFactory.h"
-#include "Machine1Factory.h"
-#include "Machine2Factory.h"
+#include "MachinePrototypes.h"
 
 ///The highest machine ID that you can set the system to
 const int MaxMachineId = 2;
@@ -22,8 +24,18 @@ const int MaxMachineId = 2;
  */
 MachineSystemActual::MachineSystemActual(std::wstring resourcesDir) : mResourcesDirectory(std::move(resourcesDir))
 {
+    mCache = std::make_shared<MachineFrameCache>();
     SetMachineNumber(1);
 }
+
+/**
+ * Destructor
+ */
+MachineSystemActual::~MachineSystemActual()
+{
+    StopPresimulator();
+}
+
 /**
 * Draw the machine at the currently specified location
 * @param graphics Graphics object to render to
@@ -66,42 +78,312 @@ void MachineSystemActual::SetMachineNumber(int machine)
     {
         mMachineNumber = machine;
     }
-    if (mMachineNumber == 2)
-    {
-        Machine2Factory machine2(mResourcesDirectory);
-        mMachine = machine2.Create();
 
-    }
-    else if (mMachineNumber == 1)
+    StopPresimulator();
+    mMachine = CreateMachine();
+    Rewind();
+}
+
+/**
+ * Create a new machine object for the current machine number
+ * @return New machine, with the step size settings applied
+ */
+std::shared_ptr<Machine> MachineSystemActual::CreateMachine()
+{
+    auto machine = MachinePrototypes::Create(mMachineNumber, mResourcesDirectory);
+
+    if(mStepSize > 0)
     {
-        Machine1Factory machineOne(mResourcesDirectory);
-        mMachine = machineOne.Create();
+        machine->SetStepSize(mStepSize);
+    }
+    machine->SetMaxSubSteps(mMaxSubSteps);
 
+    return machine;
+}
+
+/**
+ * Set the size of the fixed physics step.
+ *
+ * The machine is always simulated in steps of this size, independent
+ * of the frame rate. A larger step is cheaper for preview playback, a
+ * smaller step gives a more accurate simulation for final output.
+ * Changing the step size changes the simulation, so the machine is
+ * rewound and will be re-simulated to the current frame.
+ * @param step Step size in seconds
+ */
+void MachineSystemActual::SetStepSize(double step)
+{
+    StopPresimulator();
+    mStepSize = step;
+    mMachine->SetStepSize(step);
+    Rewind();
+}
+
+/**
+ * Set the most physics steps taken for a single frame. If
+ * a frame needs more steps than this, the rest of its time
+ * is dropped.
+ * @param steps Maximum number of steps, 0 for no limit
+ */
+void MachineSystemActual::SetMaxSubSteps(int steps)
+{
+    StopPresimulator();
+    mMaxSubSteps = steps;
+    mMachine->SetMaxSubSteps(steps);
+    Rewind();
+}
+
+/**
+  * Set the expected frame rate in frames per second
+  *
+  * Changing the frame rate changes the time each frame
+  * represents, so any saved checkpoints and baked frames
+  * are discarded and the machine is simulated again from
+  * the beginning the next time it is needed.
+  * @param rate Frame rate in frames per second
+  */
+void MachineSystemActual::SetFrameRate(double rate)
+{
+    if(rate != mFrameRate)
+    {
+        StopPresimulator();
+        mCache->Clear();
+        mFrameRate = rate;
+        mSimulating = false;
+        StartPresimulator();
     }
-    mMachine->Reset();
+}
 
+/**
+ * Set how far ahead of the current frame the machine
+ * is simulated on a background thread.
+ * @param frames Number of frames, 0 to turn background simulation off
+ */
+void MachineSystemActual::SetLookahead(int frames)
+{
+    StopPresimulator();
+    mLookahead = frames;
+    StartPresimulator();
 }
 
 /**
   * Set the current machine animation frame
+  *
+  * A frame that has been baked, either by us or by the background
+  * simulation, is applied directly from the recording with no
+  * simulation at all.
+  *
+  * Otherwise, rather than re-running the machine from the beginning
+  * on a backward seek, we restore the nearest checkpoint at or before
+  * the requested frame and only step the remaining frames. The same
+  * is done for a long forward seek past a saved checkpoint. Frames
+  * simulated right after the end of the recording are baked as we go.
   * @param frame Frame number
   */
 void MachineSystemActual::SetMachineFrame(int frame)
 {
-    if(frame < mFrame)
+    if(mPresimulator != nullptr)
+    {
+        mPresimulator->SetTarget(frame + mLookahead);
+    }
+
+    if(frame == mFrame)
+    {
+        return;
+    }
+
+    if(mCache->ApplyFrame(*mMachine, frame))
+    {
+        mFrame = frame;
+        mSimulating = false;
+        return;
+    }
+
+    Simulate(frame);
+}
+
+/**
+ * Simulate the machine to a frame, starting from the nearest
+ * checkpoint or the current state, whichever is closer.
+ * @param frame Frame number
+ */
+void MachineSystemActual::Simulate(int frame)
+{
+    // Find the latest checkpoint at or before the requested frame
+    auto checkpoint = mCache->FindCheckpoint(frame);
+    if(checkpoint != nullptr)
+    {
+        if(!mSimulating || frame < mFrame || checkpoint->GetFrame() > mFrame)
+        {
+            mMachine->RestoreCheckpoint(*checkpoint);
+            mFrame = checkpoint->GetFrame();
+            mSimulating = true;
+        }
+    }
+    else if(!mSimulating || frame < mFrame)
     {
         mFrame = 0;
         mMachine->Reset();
+        mCache->AddCheckpoint(*mMachine, mFrame);
+        if(mPresimulator == nullptr)
+        {
+            mCache->RecordFrame(*mMachine, mFrame);
+        }
+        mSimulating = true;
+    }
+
+    while(mFrame < frame)
+    {
+        mMachine->Update(1.0 / mFrameRate);
+        mFrame++;
+
+        mCache->AddCheckpoint(*mMachine, mFrame);
+
+        // A background simulation does all of the recording while it
+        // runs, so the recording is one continuous simulation
+        if(mPresimulator == nullptr)
+        {
+            mCache->RecordFrame(*mMachine, mFrame);
+        }
+    }
+}
+
+/**
+ * Create a checkpoint of the machine at the current frame.
+ *
+ * If the current frame was shown from a bake, the machine is
+ * simulated to it first, since a baked frame only holds what
+ * is needed to draw it.
+ * @return Checkpoint of the machine state
+ */
+std::shared_ptr<MachineCheckpoint> MachineSystemActual::CreateCheckpoint()
+{
+    if(!mSimulating)
+    {
+        Simulate(mFrame);
     }
 
+    return mMachine->CreateCheckpoint(mFrame);
+}
+
+/**
+ * Restore the machine to a checkpoint.
+ *
+ * The checkpoint may come from another machine system, as long
+ * as it has the same machine number and step size. The machine is
+ * then at the frame of the checkpoint and simulates on from there.
+ * @param checkpoint Checkpoint to restore
+ */
+void MachineSystemActual::RestoreCheckpoint(const MachineCheckpoint &checkpoint)
+{
+    mMachine->RestoreCheckpoint(checkpoint);
+    mFrame = checkpoint.GetFrame();
+    mSimulating = true;
+}
+
+/**
+ * Bake the machine for a number of frames.
+ *
+ * The machine is simulated once from the beginning and every
+ * frame is recorded, so any of those frames can be shown later
+ * without simulation. If the background simulation is running,
+ * it records them and we wait for it.
+ * @param frames Number of frames to bake, starting at frame 0
+ */
+void MachineSystemActual::Bake(int frames)
+{
+    if(frames > mCache->GetFrameCount())
+    {
+        if(mPresimulator != nullptr)
+        {
+            mPresimulator->SetTarget(frames - 1);
+            mPresimulator->Wait();
+        }
 
+        SetMachineFrame(frames - 1);
+    }
+}
 
-    for( ; mFrame < frame;  mFrame++)
+/**
+ * Wait until the background simulation has recorded every frame up
+ * to the lookahead, or can't record any more. Returns straight away
+ * if there is no background simulation.
+ */
+void MachineSystemActual::WaitForLookahead()
+{
+    if(mPresimulator != nullptr)
     {
-        mMachine->Update(1.0 / mFrameRate);
+        mPresimulator->Wait();
     }
+}
+
+/**
+ * Get the number of frames that have been baked
+ * @return Number of frames, frames 0 to count-1 are baked
+ */
+int MachineSystemActual::GetBakedFrames() const
+{
+    return mCache->GetFrameCount();
+}
+
+/**
+ * Get the number of checkpoints currently saved
+ * @return Number of checkpoints
+ */
+size_t MachineSystemActual::GetCheckpointCount() const
+{
+    return mCache->GetCheckpointCount();
+}
+
+/**
+ * Get the number of frames between checkpoints
+ * @return Checkpoint interval in frames
+ */
+int MachineSystemActual::GetCheckpointInterval() const
+{
+    return mCache->GetCheckpointInterval();
+}
+
+/**
+ * Reset the machine to frame 0 and discard all
+ * checkpoints and baked frames.
+ */
+void MachineSystemActual::Rewind()
+{
+    StopPresimulator();
 
-    // May need more than these, but you'll figure that out...
+    mMachine->Reset();
+    mFrame = 0;
+    mSimulating = true;
+    mCache->Clear();
+    mCache->AddCheckpoint(*mMachine, mFrame);
+    mCache->RecordFrame(*mMachine, mFrame);
 
+    StartPresimulator();
+}
 
+/**
+ * Start simulating ahead of the current frame in the background.
+ *
+ * The background thread gets a machine of its own, created here
+ * so that loading its images happens on this thread.
+ */
+void MachineSystemActual::StartPresimulator()
+{
+    if(mLookahead <= 0 || mPresimulator != nullptr)
+    {
+        return;
+    }
+
+    mPresimulator = std::make_shared<MachinePresimulator>(CreateMachine(), mCache, mFrameRate);
+    mPresimulator->SetTarget(mFrame + mLookahead);
+}
+
+/**
+ * Stop the background simulation, if it is running
+ */
+void MachineSystemActual::StopPresimulator()
+{
+    // The destructor waits for the thread to finish
+    mPresimulator = nullptr;
 }
@@ -11,6 +11,9 @@
 #include "IMachineSystem.h"
 
 class Machine;
+class MachineFrameCache;
+class MachinePresimulator;
+class MachineCheckpoint;
 
 /** Class for the machine system */
 class MachineSystemActual : public IMachineSystem
@@ -44,6 +47,32 @@ private:
     ///The resources directory
     std::wstring mResourcesDirectory;
 
+    /// Size of the fixed physics step in seconds, 0 for the machine default
+    double mStepSize = 0;
+
+    /// Most physics steps per frame, 0 for no limit
+    int mMaxSubSteps = 0;
+
+    /// Checkpoints and baked frames of the machine
+    std::shared_ptr<MachineFrameCache> mCache;
+
+    /// True if the machine holds the simulated state for mFrame. False
+    /// if it was last put in a baked frame, which can't be stepped from.
+    bool mSimulating = true;
+
+    /// Number of frames to simulate ahead of the current frame
+    /// in the background, 0 for no background simulation
+    int mLookahead = 0;
+
+    /// The background simulation, if running
+    std::shared_ptr<MachinePresimulator> mPresimulator;
+
+    std::shared_ptr<Machine> CreateMachine();
+    void Rewind();
+    void Simulate(int frame);
+    void StartPresimulator();
+    void StopPresimulator();
+
 public:
 
     /// Copy constructor (disabled)
@@ -54,6 +83,8 @@ public:
 
     MachineSystemActual(std::wstring resourcesDir);
 
+    virtual ~MachineSystemActual();
+
     /**
     * Set the position for the root of the machine
     * @param location The x,y location to place the machine
@@ -82,11 +113,7 @@ public:
      */
     int GetMachineNumber() override {return mMachineNumber;}
 
-    /**
-      * Set the expected frame rate in frames per second
-      * @param rate Frame rate in frames per second
-      */
-    void SetFrameRate(double rate) override {mFrameRate = rate;}
+    void SetFrameRate(double rate) override;
 
     /**
       * Get the current machine time.
@@ -102,5 +129,31 @@ public:
 
 
     void UpdateTime(double time);
+
+    std::shared_ptr<MachineCheckpoint> CreateCheckpoint();
+
+    void RestoreCheckpoint(const MachineCheckpoint &checkpoint);
+
+    void Bake(int frames);
+
+    int GetBakedFrames() const;
+
+    void SetStepSize(double step);
+
+    void SetMaxSubSteps(int steps);
+
+    void SetLookahead(int frames);
+
+    /**
+     * Get the number of frames simulated ahead in the background
+     * @return Number of frames, 0 if there is no background simulation
+     */
+    int GetLookahead() const { return mLookahead; }
+
+    void WaitForLookahead();
+
+    size_t GetCheckpointCount() const;
+
+    int GetCheckpointInterval() const;
 };
 #endif //CANADIANEXPERIENCE_MACHINELIB_MACHINESYSTEMACTUAL_H
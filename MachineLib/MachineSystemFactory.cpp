@@ -11,6 +11,10 @@
 #include "MachineSystemStandin.h"
 #include "MachineSystemActual.h"
 
+/// Number of frames the machine is simulated ahead
+/// of the current frame in the background
+const int DefaultLookahead = 90;
+
 /**
  * Constructor
  * @param resourcesDir Directory to load resources from
@@ -30,7 +34,9 @@ MachineSystemFactory::MachineSystemFactory(std::wstring resourcesDir) :
  */
 std::shared_ptr<IMachineSystem> MachineSystemFactory::CreateMachineSystem()
 {
-    return std::make_shared<MachineSystemActual>(mResourcesDir);
+    auto system = std::make_shared<MachineSystemActual>(mResourcesDir);
+    system->SetLookahead(DefaultLookahead);
+    return system;
 }
 
 
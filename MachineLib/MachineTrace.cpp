@@ -0,0 +1,127 @@
+/**
+ * @file MachineTrace.cpp
+ * @author Frederick Fan
+ */
+
+#include "pch.h"
+#include "MachineTrace.h"
+#include <wx/file.h>
+
+/// Identifies a trace file
+const char TraceMagic[4] = {'M', 'T', 'R', 'C'};
+
+/// Version of the trace file format
+const uint32_t TraceVersion = 1;
+
+/**
+ * Save the trace to a file.
+ *
+ * The file is the magic number, the version and the frame count
+ * followed by one 64-bit hash per frame, all little endian.
+ * @param filename File to save to
+ * @return true if successful
+ */
+bool MachineTrace::Save(const std::wstring &filename) const
+{
+    std::vector<unsigned char> data(sizeof(TraceMagic));
+    std::copy(TraceMagic, TraceMagic + sizeof(TraceMagic), data.begin());
+
+    auto put = [&data](uint64_t value, int bytes) {
+        for(int b=0; b<bytes; b++)
+        {
+            data.push_back((unsigned char)(value >> (8 * b)));
+        }
+    };
+
+    put(TraceVersion, 4);
+    put(mHashes.size(), 4);
+    for(auto hash : mHashes)
+    {
+        put(hash, 8);
+    }
+
+    wxFile file;
+    if(!file.Create(filename, true))
+    {
+        return false;
+    }
+
+    return file.Write(data.data(), data.size()) == data.size();
+}
+
+/**
+ * Load a trace from a file saved with Save
+ * @param filename File to load from
+ * @return true if successful, the trace is empty otherwise
+ */
+bool MachineTrace::Load(const std::wstring &filename)
+{
+    mHashes.clear();
+
+    wxFile file;
+    if(!file.Open(filename))
+    {
+        return false;
+    }
+
+    auto length = file.Length();
+    if(length < 12)
+    {
+        return false;
+    }
+
+    std::vector<unsigned char> data((size_t)length);
+    if(file.Read(data.data(), data.size()) != (ssize_t)data.size())
+    {
+        return false;
+    }
+
+    auto get = [&data](size_t offset, int bytes) {
+        uint64_t value = 0;
+        for(int b=0; b<bytes; b++)
+        {
+            value |= (uint64_t)data[offset + b] << (8 * b);
+        }
+        return value;
+    };
+
+    uint64_t count = get(8, 4);
+    if(!std::equal(TraceMagic, TraceMagic + sizeof(TraceMagic), data.begin()) ||
+        get(4, 4) != TraceVersion || data.size() != 12 + count * 8)
+    {
+        return false;
+    }
+
+    mHashes.reserve(count);
+    for(size_t i=0; i<count; i++)
+    {
+        mHashes.push_back(get(12 + i * 8, 8));
+    }
+
+    return true;
+}
+
+/**
+ * Find the first frame where two traces differ
+ * @param a First trace
+ * @param b Second trace
+ * @return Index of the first differing frame, or -1 if the traces are
+ * identical. If one trace is a prefix of the other, this is the length
+ * of the shorter one.
+ */
+int MachineTrace::FindDifference(const MachineTrace &a, const MachineTrace &b)
+{
+    auto &ha = a.mHashes;
+    auto &hb = b.mHashes;
+
+    auto count = std::min(ha.size(), hb.size());
+    for(size_t i=0; i<count; i++)
+    {
+        if(ha[i] != hb[i])
+        {
+            return (int)i;
+        }
+    }
+
+    return ha.size() == hb.size() ? -1 : (int)count;
+}
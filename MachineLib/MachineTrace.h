@@ -0,0 +1,81 @@
+/**
+ * @file MachineTrace.h
+ * @author Frederick Fan
+ *
+ * A hash of the machine state after every update
+ */
+
+#ifndef CANADIANEXPERIENCE_MACHINELIB_MACHINETRACE_H
+#define CANADIANEXPERIENCE_MACHINELIB_MACHINETRACE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * A hash of the machine state after every update.
+ *
+ * When a trace is attached to a machine, every call to Machine::Update
+ * appends a hash of the exact bits of every body position, angle and
+ * velocity and of the component state. Two runs that simulate the same
+ * thing produce identical traces, so comparing traces finds the first
+ * frame where a change to caching, checkpoints, threading or compiler
+ * settings made the simulation diverge.
+ */
+class MachineTrace
+{
+private:
+    /// Hash of the machine state after each update
+    std::vector<uint64_t> mHashes;
+
+public:
+    /// Value to start a hash with
+    static const uint64_t HashStart = 14695981039346656037ull;
+
+    /**
+     * Add bytes to a hash using 64-bit FNV-1a
+     * @param hash Hash so far
+     * @param data Bytes to add
+     * @param size Number of bytes
+     * @return New hash
+     */
+    static uint64_t Hash(uint64_t hash, const void *data, size_t size)
+    {
+        auto bytes = (const unsigned char *)data;
+        for(size_t i=0; i<size; i++)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    /**
+     * Add the hash of the state after the next update
+     * @param hash Hash of the machine state
+     */
+    void Record(uint64_t hash) { mHashes.push_back(hash); }
+
+    /// Discard all recorded hashes
+    void Clear() { mHashes.clear(); }
+
+    /**
+     * Get the recorded hashes
+     * @return Hash after each update, the first is after the first update
+     */
+    const std::vector<uint64_t> &GetHashes() const { return mHashes; }
+
+    /**
+     * Get the number of recorded frames
+     * @return Number of frames
+     */
+    int GetFrameCount() const { return (int)mHashes.size(); }
+
+    bool Save(const std::wstring &filename) const;
+
+    bool Load(const std::wstring &filename);
+
+    static int FindDifference(const MachineTrace &a, const MachineTrace &b);
+};
+
+#endif //CANADIANEXPERIENCE_MACHINELIB_MACHINETRACE_H
@@ -18,16 +18,30 @@ cse335::PhysicsPolygon::PhysicsPolygon() : Polygon()
 {
 }
 
+/**
+ * Copy constructor.
+ *
+ * The copy has the same shape and physical properties,
+ * but is not installed in any physics system.
+ * @param other Physics polygon to copy
+ */
+cse335::PhysicsPolygon::PhysicsPolygon(const PhysicsPolygon &other) : Polygon(other),
+    mInitialRotation(other.mInitialRotation), mInitialPosition(other.mInitialPosition),
+    mType(other.mType), mDensity(other.mDensity), mFriction(other.mFriction),
+    mRestitution(other.mRestitution)
+{
+}
+
 /**
  * Draw the component
- * @param graphics Graphics device to render to
+ * @param list Display list to record the drawing into
  */
-void cse335::PhysicsPolygon::Draw(std::shared_ptr<wxGraphicsContext> graphics)
+void cse335::PhysicsPolygon::Draw(std::shared_ptr<DisplayList> list)
 {
     auto position = GetPosition();
     auto rotation = GetRotation();
 
-    DrawPolygon(graphics, position.m_x, position.m_y, rotation);
+    DrawPolygon(list, position.m_x, position.m_y, rotation);
 }
 
 /**
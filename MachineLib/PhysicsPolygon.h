@@ -11,6 +11,7 @@
  * Version history:
  * 1.00 Initial version for FS23 project 2
  * 1.01 Revised to work prior to physics installation
+ * 1.02 Copy constructor so machines can be cloned
  */
 
 #pragma once
@@ -63,13 +64,12 @@ private:
 public:
     PhysicsPolygon();
 
-    /// Copy constructor (disabled)
-    PhysicsPolygon(const PhysicsPolygon &) = delete;
+    PhysicsPolygon(const PhysicsPolygon &other);
 
     /// Assignment operator
     void operator=(const PhysicsPolygon &) = delete;
 
-    virtual void Draw(std::shared_ptr<wxGraphicsContext> graphics);
+    virtual void Draw(std::shared_ptr<DisplayList> list);
 
     /**
      * Set the component position in the machine
@@ -0,0 +1,382 @@
+/**
+ * @file PhysicsState.cpp
+ * @author Frederick Fan
+ */
+
+#include "pch.h"
+#include "PhysicsState.h"
+#include <algorithm>
+#include <map>
+
+namespace
+{
+/**
+ * Access to a private member of a Box2D class.
+ *
+ * Access is not checked for the arguments of an explicit template
+ * instantiation, so instantiating this with a pointer to a private
+ * member defines a Get function for the tag that returns the pointer.
+ * @tparam Tag Type naming the member, with the member pointer as Type
+ * @tparam Member Pointer to the member
+ */
+template <typename Tag, typename Tag::Type Member>
+struct PrivateMember
+{
+    /**
+     * Get the pointer to the member
+     * @return Member pointer
+     */
+    friend typename Tag::Type Get(Tag) { return Member; }
+};
+
+/// b2Body::m_xf
+struct BodyTransform { typedef b2Transform b2Body::*Type; friend Type Get(BodyTransform); };
+template struct PrivateMember<BodyTransform, &b2Body::m_xf>;
+
+/// b2Body::m_sweep
+struct BodySweep { typedef b2Sweep b2Body::*Type; friend Type Get(BodySweep); };
+template struct PrivateMember<BodySweep, &b2Body::m_sweep>;
+
+/// b2Body::m_linearVelocity
+struct BodyLinearVelocity { typedef b2Vec2 b2Body::*Type; friend Type Get(BodyLinearVelocity); };
+template struct PrivateMember<BodyLinearVelocity, &b2Body::m_linearVelocity>;
+
+/// b2Body::m_angularVelocity
+struct BodyAngularVelocity { typedef float b2Body::*Type; friend Type Get(BodyAngularVelocity); };
+template struct PrivateMember<BodyAngularVelocity, &b2Body::m_angularVelocity>;
+
+/// b2Body::m_force
+struct BodyForce { typedef b2Vec2 b2Body::*Type; friend Type Get(BodyForce); };
+template struct PrivateMember<BodyForce, &b2Body::m_force>;
+
+/// b2Body::m_torque
+struct BodyTorque { typedef float b2Body::*Type; friend Type Get(BodyTorque); };
+template struct PrivateMember<BodyTorque, &b2Body::m_torque>;
+
+/// b2Body::m_sleepTime
+struct BodySleepTime { typedef float b2Body::*Type; friend Type Get(BodySleepTime); };
+template struct PrivateMember<BodySleepTime, &b2Body::m_sleepTime>;
+
+/// b2Body::m_flags
+struct BodyFlags { typedef uint16 b2Body::*Type; friend Type Get(BodyFlags); };
+template struct PrivateMember<BodyFlags, &b2Body::m_flags>;
+
+/// b2Fixture::m_proxies
+struct FixtureProxies { typedef b2FixtureProxy *b2Fixture::*Type; friend Type Get(FixtureProxies); };
+template struct PrivateMember<FixtureProxies, &b2Fixture::m_proxies>;
+
+/// b2Fixture::m_proxyCount
+struct FixtureProxyCount { typedef int32 b2Fixture::*Type; friend Type Get(FixtureProxyCount); };
+template struct PrivateMember<FixtureProxyCount, &b2Fixture::m_proxyCount>;
+
+/// b2Contact::m_flags
+struct ContactFlags { typedef uint32 b2Contact::*Type; friend Type Get(ContactFlags); };
+template struct PrivateMember<ContactFlags, &b2Contact::m_flags>;
+
+/// b2Contact::m_toiCount
+struct ContactToiCount { typedef int32 b2Contact::*Type; friend Type Get(ContactToiCount); };
+template struct PrivateMember<ContactToiCount, &b2Contact::m_toiCount>;
+
+/// b2Contact::m_toi
+struct ContactToi { typedef float b2Contact::*Type; friend Type Get(ContactToi); };
+template struct PrivateMember<ContactToi, &b2Contact::m_toi>;
+
+/// b2BroadPhase::m_tree
+struct BroadPhaseTree { typedef b2DynamicTree b2BroadPhase::*Type; friend Type Get(BroadPhaseTree); };
+template struct PrivateMember<BroadPhaseTree, &b2BroadPhase::m_tree>;
+
+/// b2BroadPhase::m_moveBuffer
+struct BroadPhaseMoves { typedef int32 *b2BroadPhase::*Type; friend Type Get(BroadPhaseMoves); };
+template struct PrivateMember<BroadPhaseMoves, &b2BroadPhase::m_moveBuffer>;
+
+/// b2BroadPhase::m_moveCount
+struct BroadPhaseMoveCount { typedef int32 b2BroadPhase::*Type; friend Type Get(BroadPhaseMoveCount); };
+template struct PrivateMember<BroadPhaseMoveCount, &b2BroadPhase::m_moveCount>;
+
+/// b2DynamicTree::m_root
+struct TreeRoot { typedef int32 b2DynamicTree::*Type; friend Type Get(TreeRoot); };
+template struct PrivateMember<TreeRoot, &b2DynamicTree::m_root>;
+
+/// b2DynamicTree::m_nodes
+struct TreeNodes { typedef b2TreeNode *b2DynamicTree::*Type; friend Type Get(TreeNodes); };
+template struct PrivateMember<TreeNodes, &b2DynamicTree::m_nodes>;
+
+/// b2DynamicTree::m_nodeCount
+struct TreeNodeCount { typedef int32 b2DynamicTree::*Type; friend Type Get(TreeNodeCount); };
+template struct PrivateMember<TreeNodeCount, &b2DynamicTree::m_nodeCount>;
+
+/// b2DynamicTree::m_nodeCapacity
+struct TreeNodeCapacity { typedef int32 b2DynamicTree::*Type; friend Type Get(TreeNodeCapacity); };
+template struct PrivateMember<TreeNodeCapacity, &b2DynamicTree::m_nodeCapacity>;
+
+/// b2DynamicTree::m_freeList
+struct TreeFreeList { typedef int32 b2DynamicTree::*Type; friend Type Get(TreeFreeList); };
+template struct PrivateMember<TreeFreeList, &b2DynamicTree::m_freeList>;
+
+/// b2World::m_inv_dt0
+struct WorldInvDt0 { typedef float b2World::*Type; friend Type Get(WorldInvDt0); };
+template struct PrivateMember<WorldInvDt0, &b2World::m_inv_dt0>;
+
+/// b2World::m_newContacts
+struct WorldNewContacts { typedef bool b2World::*Type; friend Type Get(WorldNewContacts); };
+template struct PrivateMember<WorldNewContacts, &b2World::m_newContacts>;
+
+/// b2World::m_stepComplete
+struct WorldStepComplete { typedef bool b2World::*Type; friend Type Get(WorldStepComplete); };
+template struct PrivateMember<WorldStepComplete, &b2World::m_stepComplete>;
+
+/**
+ * Get the contact manager of a world. The world only gives out a const
+ * reference, but the manager is a plain member of the world.
+ * @param world World to get the manager of
+ * @return Contact manager
+ */
+b2ContactManager &GetContactManager(b2World *world)
+{
+    return const_cast<b2ContactManager &>(world->GetContactManager());
+}
+
+/**
+ * Get the broad-phase proxy of one side of a contact
+ * @param fixture Fixture on that side
+ * @param child Child index on that side
+ * @return Proxy of that child of the fixture
+ */
+b2FixtureProxy *GetProxy(b2Fixture *fixture, int32 child)
+{
+    return &(fixture->*Get(FixtureProxies()))[child];
+}
+}
+
+/**
+ * Save the state of a world
+ * @param world World to save, which must not be in the middle of a step
+ */
+void PhysicsState::Save(b2World *world)
+{
+    wxASSERT(!world->IsLocked());
+
+    mBodies.clear();
+    mContacts.clear();
+    mProxyIds.clear();
+    mProxyBounds.clear();
+
+    // Every proxy and its index, in body and then fixture order
+    std::map<const void *, int> proxies;
+    mBodies.reserve(world->GetBodyCount());
+    for(auto body = world->GetBodyList(); body != nullptr; body = body->GetNext())
+    {
+        Body state;
+        state.mTransform = body->*Get(BodyTransform());
+        state.mSweep = body->*Get(BodySweep());
+        state.mLinearVelocity = body->*Get(BodyLinearVelocity());
+        state.mAngularVelocity = body->*Get(BodyAngularVelocity());
+        state.mForce = body->*Get(BodyForce());
+        state.mTorque = body->*Get(BodyTorque());
+        state.mGravityScale = body->GetGravityScale();
+        state.mSleepTime = body->*Get(BodySleepTime());
+        state.mFlags = body->*Get(BodyFlags());
+        mBodies.push_back(state);
+
+        for(auto fixture = body->GetFixtureList(); fixture != nullptr; fixture = fixture->GetNext())
+        {
+            for(int32 child = 0; child < fixture->*Get(FixtureProxyCount()); child++)
+            {
+                auto proxy = GetProxy(fixture, child);
+                proxies[proxy] = (int)mProxyIds.size();
+                mProxyIds.push_back(proxy->proxyId);
+                mProxyBounds.push_back(proxy->aabb);
+            }
+        }
+    }
+
+    // The world contact list is newest first
+    mContacts.reserve(world->GetContactCount());
+    for(auto contact = world->GetContactList(); contact != nullptr; contact = contact->GetNext())
+    {
+        Contact state;
+        state.mProxyA = proxies[GetProxy(contact->GetFixtureA(), contact->GetChildIndexA())];
+        state.mProxyB = proxies[GetProxy(contact->GetFixtureB(), contact->GetChildIndexB())];
+        state.mFlags = contact->*Get(ContactFlags());
+        state.mManifold = *contact->GetManifold();
+        state.mToiCount = contact->*Get(ContactToiCount());
+        state.mToi = contact->*Get(ContactToi());
+        state.mTangentSpeed = contact->GetTangentSpeed();
+        mContacts.push_back(state);
+    }
+    std::reverse(mContacts.begin(), mContacts.end());
+
+    auto &broadPhase = GetContactManager(world).m_broadPhase;
+    auto &tree = broadPhase.*Get(BroadPhaseTree());
+    auto nodes = tree.*Get(TreeNodes());
+    int capacity = tree.*Get(TreeNodeCapacity());
+    mNodes.assign(nodes, nodes + capacity);
+    mNodeProxies.assign(capacity, -1);
+    for(int i=0; i<capacity; i++)
+    {
+        // Only leaves point at a proxy, free nodes may still hold a stale pointer
+        if(mNodes[i].height == 0)
+        {
+            mNodeProxies[i] = proxies[mNodes[i].userData];
+        }
+        mNodes[i].userData = nullptr;
+    }
+
+    mRoot = tree.*Get(TreeRoot());
+    mFreeList = tree.*Get(TreeFreeList());
+    mNodeCount = tree.*Get(TreeNodeCount());
+
+    auto moves = broadPhase.*Get(BroadPhaseMoves());
+    mMoves.assign(moves, moves + broadPhase.*Get(BroadPhaseMoveCount()));
+
+    mInvDt0 = world->*Get(WorldInvDt0());
+    mNewContacts = world->*Get(WorldNewContacts());
+    mStepComplete = world->*Get(WorldStepComplete());
+}
+
+/**
+ * Put a world back in the saved state.
+ *
+ * The world must be the one the state was saved from or one built
+ * the same way. Its bodies and fixtures are kept. Its contacts are
+ * kept too if they are the saved ones, otherwise they are destroyed
+ * and the saved ones created in the order they were first created.
+ * No contact listener is called for any of this.
+ * @param world World to restore, which must not be in the middle of a step
+ */
+void PhysicsState::Restore(b2World *world) const
+{
+    wxASSERT(!world->IsLocked());
+    wxASSERT(world->GetBodyCount() == (int32)mBodies.size());
+
+    std::vector<b2FixtureProxy *> proxies;
+    proxies.reserve(mProxyIds.size());
+    size_t index = 0;
+    for(auto body = world->GetBodyList(); body != nullptr && index < mBodies.size(); body = body->GetNext())
+    {
+        auto &state = mBodies[index++];
+        body->*Get(BodyTransform()) = state.mTransform;
+        body->*Get(BodySweep()) = state.mSweep;
+        body->*Get(BodyLinearVelocity()) = state.mLinearVelocity;
+        body->*Get(BodyAngularVelocity()) = state.mAngularVelocity;
+        body->*Get(BodyForce()) = state.mForce;
+        body->*Get(BodyTorque()) = state.mTorque;
+        body->SetGravityScale(state.mGravityScale);
+        body->*Get(BodySleepTime()) = state.mSleepTime;
+        body->*Get(BodyFlags()) = state.mFlags;
+
+        for(auto fixture = body->GetFixtureList(); fixture != nullptr; fixture = fixture->GetNext())
+        {
+            for(int32 child = 0; child < fixture->*Get(FixtureProxyCount()); child++)
+            {
+                proxies.push_back(GetProxy(fixture, child));
+            }
+        }
+    }
+
+    wxASSERT(proxies.size() == mProxyIds.size());
+    if(proxies.size() != mProxyIds.size())
+    {
+        return;
+    }
+
+    for(size_t i=0; i<proxies.size(); i++)
+    {
+        proxies[i]->proxyId = mProxyIds[i];
+        proxies[i]->aabb = mProxyBounds[i];
+    }
+
+    // If the world still has exactly the saved contacts, as it does when
+    // it has only stepped a little since the save, they are kept as they are
+    auto &manager = GetContactManager(world);
+    bool same = manager.m_contactCount == (int32)mContacts.size();
+    auto contact = manager.m_contactList;
+    for(auto state = mContacts.rbegin(); same && state != mContacts.rend(); ++state)
+    {
+        same = GetProxy(contact->GetFixtureA(), contact->GetChildIndexA()) == proxies[state->mProxyA] &&
+            GetProxy(contact->GetFixtureB(), contact->GetChildIndexB()) == proxies[state->mProxyB];
+        contact = contact->GetNext();
+    }
+
+    if(!same)
+    {
+        // Destroying a touching contact reports that it ended, but
+        // it hasn't, the world is only being put back where it was
+        auto listener = manager.m_contactListener;
+        manager.m_contactListener = nullptr;
+        while(manager.m_contactList != nullptr)
+        {
+            manager.Destroy(manager.m_contactList);
+        }
+
+        // Creating them oldest first gives the world and every body
+        // the same contact list order as when the state was saved
+        for(auto &state : mContacts)
+        {
+            manager.AddPair(proxies[state.mProxyA], proxies[state.mProxyB]);
+        }
+        manager.m_contactListener = listener;
+        wxASSERT(manager.m_contactCount == (int32)mContacts.size());
+    }
+
+    contact = manager.m_contactList;
+    for(auto state = mContacts.rbegin(); contact != nullptr && state != mContacts.rend(); ++state)
+    {
+        contact->*Get(ContactFlags()) = state->mFlags;
+        *contact->GetManifold() = state->mManifold;
+        contact->*Get(ContactToiCount()) = state->mToiCount;
+        contact->*Get(ContactToi()) = state->mToi;
+        contact->SetTangentSpeed(state->mTangentSpeed);
+        contact = contact->GetNext();
+    }
+
+    auto &broadPhase = manager.m_broadPhase;
+    auto &tree = broadPhase.*Get(BroadPhaseTree());
+    auto &nodes = tree.*Get(TreeNodes());
+    auto &capacity = tree.*Get(TreeNodeCapacity());
+    if(capacity != (int32)mNodes.size())
+    {
+        b2Free(nodes);
+        nodes = (b2TreeNode *)b2Alloc((int32)(mNodes.size() * sizeof(b2TreeNode)));
+        capacity = (int32)mNodes.size();
+    }
+
+    std::copy(mNodes.begin(), mNodes.end(), nodes);
+    for(size_t i=0; i<mNodes.size(); i++)
+    {
+        if(mNodeProxies[i] >= 0)
+        {
+            nodes[i].userData = proxies[mNodeProxies[i]];
+        }
+    }
+
+    tree.*Get(TreeRoot()) = mRoot;
+    tree.*Get(TreeFreeList()) = mFreeList;
+    tree.*Get(TreeNodeCount()) = mNodeCount;
+
+    broadPhase.*Get(BroadPhaseMoveCount()) = 0;
+    for(auto proxyId : mMoves)
+    {
+        broadPhase.TouchProxy(proxyId);
+    }
+
+    world->*Get(WorldInvDt0()) = mInvDt0;
+    world->*Get(WorldNewContacts()) = mNewContacts;
+    world->*Get(WorldStepComplete()) = mStepComplete;
+}
+
+/**
+ * Get the approximate amount of memory this state uses
+ * @return Size in bytes
+ */
+size_t PhysicsState::GetMemorySize() const
+{
+    return sizeof(PhysicsState) +
+        mBodies.capacity() * sizeof(Body) +
+        mContacts.capacity() * sizeof(Contact) +
+        mProxyIds.capacity() * sizeof(int32) +
+        mProxyBounds.capacity() * sizeof(b2AABB) +
+        mNodes.capacity() * sizeof(b2TreeNode) +
+        mNodeProxies.capacity() * sizeof(int) +
+        mMoves.capacity() * sizeof(int32);
+}
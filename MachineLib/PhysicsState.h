@@ -0,0 +1,142 @@
+/**
+ * @file PhysicsState.h
+ * @author Frederick Fan
+ *
+ * The complete state of a b2World, including what Box2D keeps to itself
+ */
+
+#ifndef CANADIANEXPERIENCE_MACHINELIB_PHYSICSSTATE_H
+#define CANADIANEXPERIENCE_MACHINELIB_PHYSICSSTATE_H
+
+#include <vector>
+#include "box2d.h"
+
+/**
+ * The complete state of a b2World, including what Box2D keeps to itself.
+ *
+ * The next step of a world depends on more than the positions and
+ * velocities Box2D lets us set: the sweep used for continuous collision,
+ * how long each body has been at rest, the contacts with the impulses
+ * the solver warm starts from, and the broad-phase tree that decides the
+ * order new contacts are found in. This saves all of that and puts it
+ * back into the same bodies and fixtures, so a restored world steps on
+ * bit for bit as the world it was saved from did.
+ *
+ * Bodies, fixtures and broad-phase proxies are identified by where they
+ * are in the world, so the state can be restored into any world built
+ * the same way, with the same bodies and fixtures created in the same
+ * order. Joints are not saved, machines don't use them.
+ */
+class PhysicsState
+{
+private:
+    /// The state of a single body
+    struct Body
+    {
+        /// Body origin transform
+        b2Transform mTransform;
+
+        /// Swept motion used for continuous collision
+        b2Sweep mSweep;
+
+        /// Linear velocity in meters per second
+        b2Vec2 mLinearVelocity;
+
+        /// Angular velocity in radians per second
+        float mAngularVelocity = 0;
+
+        /// Force applied since the last step
+        b2Vec2 mForce;
+
+        /// Torque applied since the last step
+        float mTorque = 0;
+
+        /// Scale applied to gravity for this body
+        float mGravityScale = 1;
+
+        /// Time the body has been at rest in seconds
+        float mSleepTime = 0;
+
+        /// Body flags, including whether it is awake
+        uint16 mFlags = 0;
+    };
+
+    /// The state of a single contact
+    struct Contact
+    {
+        /// Index of the broad-phase proxy of fixture A
+        int mProxyA = 0;
+
+        /// Index of the broad-phase proxy of fixture B
+        int mProxyB = 0;
+
+        /// Contact flags, including whether it is touching
+        uint32 mFlags = 0;
+
+        /// Contact points with their impulses and feature ids
+        b2Manifold mManifold;
+
+        /// Number of times of impact found in the last step
+        int32 mToiCount = 0;
+
+        /// Time of impact cached within a step
+        float mToi = 1;
+
+        /// Tangent speed set by a conveyor
+        float mTangentSpeed = 0;
+    };
+
+    /// The state of every body in world body list order
+    std::vector<Body> mBodies;
+
+    /// Every contact, oldest first
+    std::vector<Contact> mContacts;
+
+    /// Proxy id of each fixture proxy, in body and then fixture order
+    std::vector<int32> mProxyIds;
+
+    /// Bounding box of each fixture proxy
+    std::vector<b2AABB> mProxyBounds;
+
+    /// The broad-phase tree nodes, up to the tree capacity
+    std::vector<b2TreeNode> mNodes;
+
+    /// Index of the proxy in each leaf node, -1 for other nodes
+    std::vector<int> mNodeProxies;
+
+    /// Root node of the broad-phase tree
+    int32 mRoot = b2_nullNode;
+
+    /// First free node of the broad-phase tree
+    int32 mFreeList = b2_nullNode;
+
+    /// Number of nodes in use in the broad-phase tree
+    int32 mNodeCount = 0;
+
+    /// Proxies that have moved and are waiting to be paired
+    std::vector<int32> mMoves;
+
+    /// Inverse of the last step size
+    float mInvDt0 = 0;
+
+    /// Were fixtures added since the last step?
+    bool mNewContacts = false;
+
+    /// Did the last step complete?
+    bool mStepComplete = true;
+
+public:
+    void Save(b2World *world);
+
+    void Restore(b2World *world) const;
+
+    /**
+     * Get the number of contacts saved
+     * @return Number of contacts, touching or not
+     */
+    size_t GetContactCount() const { return mContacts.size(); }
+
+    size_t GetMemorySize() const;
+};
+
+#endif //CANADIANEXPERIENCE_MACHINELIB_PHYSICSSTATE_H
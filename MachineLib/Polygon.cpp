@@ -10,6 +10,8 @@
 #include <wx/hyperlink.h>
 
 #include "Polygon.h"
+#include "include/ImageCache.h"
+#include "DisplayList.h"
 
 using namespace cse335;
 
@@ -20,6 +22,25 @@ Polygon::Polygon() : mBrush(*wxBLACK)
 {
 }
 
+/**
+ * Copy constructor.
+ *
+ * The copy shares the image and anything already created
+ * for drawing, so copying a polygon is cheap. The recorded
+ * display list is not shared, since either polygon may change
+ * afterwards.
+ * @param other Polygon to copy
+ */
+Polygon::Polygon(const Polygon &other) :
+    mPoints(other.mPoints), mIsCircle(other.mIsCircle),
+    mBrush(other.mBrush), mMode(other.mMode), mImage(other.mImage),
+    mDrawImage(other.mDrawImage), mImageClipRegion(other.mImageClipRegion),
+    mImageClipRegionTopLeft(other.mImageClipRegionTopLeft), mImageClipRegionSize(other.mImageClipRegionSize),
+    mHasDrawn(other.mHasDrawn), mOpacity(other.mOpacity), mBitmapDirty(other.mBitmapDirty),
+    mInvertedY(other.mInvertedY)
+{
+}
+
 /**
  * Destructor
  */
@@ -44,6 +65,7 @@ void Polygon::AddPoint(double x, double y)
     }
 
     mPoints.push_back(wxPoint2DDouble(x, y));
+    mDisplayListDirty = true;
 }
 
 
@@ -70,7 +92,7 @@ void Polygon::Rectangle(double x, double y, double width, double height)
             return;
         }
 
-        width = mImage->GetWidth();
+        width = mImage->GetImage().GetWidth();
     }
 
     if(height <= 0)
@@ -82,7 +104,7 @@ void Polygon::Rectangle(double x, double y, double width, double height)
             return;
         }
 
-        height = (int)(width * mImage->GetHeight() / mImage->GetWidth());
+        height = (int)(width * mImage->GetImage().GetHeight() / mImage->GetImage().GetWidth());
     }
 
     if(mInvertedY)
@@ -151,7 +173,7 @@ void Polygon::CenteredSquare(double size)
             return;
         }
 
-        size = mImage->GetWidth();
+        size = mImage->GetImage().GetWidth();
     }
 
     if(mInvertedY)
@@ -191,6 +213,7 @@ void Polygon::SetColor(wxColour color)
 {
     mBrush.SetColour(color);
     mMode = Mode::Color;
+    mDisplayListDirty = true;
 }
 
 /**
@@ -202,8 +225,9 @@ void Polygon::SetImage(std::wstring filename)
     // Prevent error popup from wxWidgets
     wxLogNull logNo;
 
-    mImage = std::make_unique<wxImage>();
-    if(mImage->LoadFile(filename, wxBITMAP_TYPE_ANY))
+    mImage = ImageCache::Load(filename);
+    mDisplayListDirty = true;
+    if(mImage != nullptr)
     {
         mMode = Mode::Image;
     }
@@ -212,20 +236,51 @@ void Polygon::SetImage(std::wstring filename)
         std::wstringstream str;
         str << L"Unable to load '" << filename << "'" << std::endl;
         wxMessageBox(str.str(), L"Polygon Image File Load Failure!");
-        mImage = nullptr;
     }
 }
 
 
 
 /**
- * Draw the polygon
+ * Draw the polygon directly onto a graphics context.
+ *
+ * The polygon is recorded once at the origin and the recording is
+ * replayed under the location and rotation, so the display list and
+ * its path are only rebuilt when the polygon changes.
  * @param graphics Graphics object to draw on
  * @param x X location to draw in pixels
  * @param y Y location to draw in pixels
  * @param rotation Rotation in turns (0-1)
  */
 void Polygon::DrawPolygon(std::shared_ptr<wxGraphicsContext> graphics, double x, double y, double rotation)
+{
+    if(mDisplayList == nullptr)
+    {
+        mDisplayList = std::make_shared<DisplayList>();
+    }
+
+    if(mDisplayListDirty)
+    {
+        mDisplayList->Clear();
+        DrawPolygon(mDisplayList, 0, 0, 0);
+        mDisplayListDirty = false;
+    }
+
+    graphics->PushState();
+    graphics->Translate(x, y);
+    graphics->Rotate(rotation * M_PI * 2);
+    mDisplayList->Replay(graphics);
+    graphics->PopState();
+}
+
+/**
+ * Draw the polygon
+ * @param list Display list to record the drawing into
+ * @param x X location to draw in pixels
+ * @param y Y location to draw in pixels
+ * @param rotation Rotation in turns (0-1)
+ */
+void Polygon::DrawPolygon(std::shared_ptr<DisplayList> list, double x, double y, double rotation)
 {
     if(mPoints.size() < 3)
     {
@@ -242,17 +297,17 @@ void Polygon::DrawPolygon(std::shared_ptr<wxGraphicsContext> graphics, double x,
     if(mOpacity < 1)
     {
         // Layer opacity does not work on Windows systems.
-        graphics->BeginLayer(mOpacity);
+        list->BeginLayer(mOpacity);
     }
 #endif
 
     switch (mMode) {
     case Mode::Color:
-        DrawColorPolygon(graphics, x, y, rotation);
+        DrawColorPolygon(list, x, y, rotation);
         break;
 
     case Mode::Image:
-        DrawImagePolygon(graphics, x, y, rotation);
+        DrawImagePolygon(list, x, y, rotation);
         break;
 
     default:
@@ -267,7 +322,7 @@ void Polygon::DrawPolygon(std::shared_ptr<wxGraphicsContext> graphics, double x,
 #ifndef WIN32
     if(mOpacity < 1)
     {
-        graphics->EndLayer();
+        list->EndLayer();
     }
 #endif
 }
@@ -276,35 +331,22 @@ void Polygon::DrawPolygon(std::shared_ptr<wxGraphicsContext> graphics, double x,
 
 /**
  * Draw the polygon as a solid color-filled polygon
- * @param graphics Graphics object to draw on
+ * @param list Display list to record the drawing into
  * @param x X location to draw in pixels
  * @param y Y location to draw in pixels
  * @param rotation Rotation in turns
  */
-void Polygon::DrawColorPolygon(std::shared_ptr<wxGraphicsContext> graphics, double x, double y, double rotation)
+void Polygon::DrawColorPolygon(std::shared_ptr<DisplayList> list, double x, double y, double rotation)
 {
-    if(mPath.IsNull())
-    {
-        // Create the graphics path
-        mPath = graphics->CreatePath();
-
-        mPath.MoveToPoint(mPoints[0].m_x, mPoints[0].m_y);
-        for(size_t i=1; i<mPoints.size(); i++)
-        {
-            mPath.AddLineToPoint(mPoints[i].m_x, mPoints[i].m_y);
-        }
-        mPath.CloseSubpath();
-    }
+    list->PushState();
 
-    graphics->PushState();
-
-    graphics->Translate(x, y);
-    graphics->Rotate(rotation * M_PI * 2);
+    list->Translate(x, y);
+    list->Rotate(rotation * M_PI * 2);
 
-    graphics->SetBrush(mBrush);
-    graphics->FillPath(mPath);
+    list->SetBrush(mBrush);
+    list->FillPath(mPoints);
 
-    graphics->PopState();
+    list->PopState();
 }
 
 /**
@@ -313,40 +355,40 @@ void Polygon::DrawColorPolygon(std::shared_ptr<wxGraphicsContext> graphics, doub
  * This is accomplished by drawing the bitmap image clipped
  * by the supplied polygon points.
  *
- * @param graphics Graphics object to draw on
+ * @param list Display list to record the drawing into
  * @param x X location to draw in pixels
  * @param y Y location to draw in pixels
  * @param rotation Rotation in turn
  */
-void Polygon::DrawImagePolygon(std::shared_ptr<wxGraphicsContext> graphics, double x, double y, double rotation)
+void Polygon::DrawImagePolygon(std::shared_ptr<DisplayList> list, double x, double y, double rotation)
 {
-    if(mBitmapDirty || mGraphicsBitmap.IsNull())
+    if(mBitmapDirty || mDrawImage == nullptr)
     {
 #ifdef WIN32
         // Implementation of opacity for Windows systems.
         // Windows does not support transparency layers.
         if(mOpacity < 1) {
-            // Ensure the image has an alpha map
-            if (!mImage->HasAlpha()) {
-                mImage->InitAlpha();
+            // Ensure the image has an alpha map. The image is
+            // shared, so this is done on our own copy of it.
+            wxImage img = mImage->GetImage().Copy();
+            if (!img.HasAlpha()) {
+                img.InitAlpha();
             }
 
-            wxImage img = mImage->Copy();
-
             unsigned char *alpha = img.GetAlpha();
             for(int i=0; i<img.GetWidth()*img.GetHeight(); i++)
             {
                 alpha[i] = int(alpha[i] * mOpacity);
             }
 
-            mGraphicsBitmap = graphics->CreateBitmapFromImage(img);
+            mDrawImage = std::make_shared<SharedImage>(img);
         }
         else
         {
-            mGraphicsBitmap = graphics->CreateBitmapFromImage(*mImage);
+            mDrawImage = mImage;
         }
 #else
-        mGraphicsBitmap = graphics->CreateBitmapFromImage(*mImage);
+        mDrawImage = mImage;
 #endif
 
         //
@@ -389,26 +431,26 @@ void Polygon::DrawImagePolygon(std::shared_ptr<wxGraphicsContext> graphics, doub
         mBitmapDirty = false;
     }
 
-    graphics->PushState();
+    list->PushState();
 
-    graphics->Translate(x, y);
-    graphics->Rotate(rotation * M_PI * 2);
+    list->Translate(x, y);
+    list->Rotate(rotation * M_PI * 2);
 
-    graphics->Translate(mImageClipRegionTopLeft.m_x, mImageClipRegionTopLeft.m_y);
-    graphics->Clip(mImageClipRegion);
+    list->Translate(mImageClipRegionTopLeft.m_x, mImageClipRegionTopLeft.m_y);
+    list->Clip(mImageClipRegion);
 
     if(mInvertedY)
     {
         // Flip the bitmap upside down
-        graphics->Scale(1, -1);
-        graphics->DrawBitmap(mGraphicsBitmap, 0, -mImageClipRegionSize.m_y, mImageClipRegionSize.m_x, mImageClipRegionSize.m_y);
+        list->Scale(1, -1);
+        list->DrawBitmap(mDrawImage, 0, -mImageClipRegionSize.m_y, mImageClipRegionSize.m_x, mImageClipRegionSize.m_y);
     }
     else
     {
-        graphics->DrawBitmap(mGraphicsBitmap, 0, 0, mImageClipRegionSize.m_x, mImageClipRegionSize.m_y);
+        list->DrawBitmap(mDrawImage, 0, 0, mImageClipRegionSize.m_x, mImageClipRegionSize.m_y);
     }
 
-    graphics->PopState();
+    list->PopState();
 }
 
 /**
@@ -440,7 +482,7 @@ int Polygon::GetImageWidth()
         return 0;
     }
 
-    return mImage->GetWidth();
+    return mImage->GetImage().GetWidth();
 }
 
 
@@ -456,7 +498,7 @@ int Polygon::GetImageHeight()
         return 0;
     }
 
-    return mImage->GetHeight();
+    return mImage->GetImage().GetHeight();
 }
 
 
@@ -504,6 +546,7 @@ void Polygon::SetOpacity(double opacity)
 
         // We have an opacity change
         mOpacity = opacity;
+        mDisplayListDirty = true;
 #ifdef WIN32
         mBitmapDirty = true;
 #endif
@@ -540,9 +583,9 @@ double Polygon::AverageLuminance(int x, int y, int wid, int hit)
                 continue;
             }
 
-            double red = mImage->GetRed(i, j);
-            double grn = mImage->GetGreen(i, j);
-            double blu = mImage->GetBlue(i, j);
+            double red = mImage->GetImage().GetRed(i, j);
+            double grn = mImage->GetImage().GetGreen(i, j);
+            double blu = mImage->GetImage().GetBlue(i, j);
             sum += red + grn + blu;
             cnt += 3;
         }
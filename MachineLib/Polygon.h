@@ -2,7 +2,7 @@
  * @file Polygon.h
  *
  * @author Charles Owen
- * @version 1.05
+ * @version 1.07
  *
  * Generic polygon class that is used to make shapes we
  * will use in our project.
@@ -14,6 +14,8 @@
  * 1.03 Put into cse335 namespace, opacity support
  * 1.04 Added Circle function
  * 1.05 Special version that works with inverted Y axis
+ * 1.06 Copy constructor so machines can be cloned
+ * 1.07 Draws by recording into a DisplayList
  */
 
 #pragma once
@@ -22,6 +24,9 @@
 #include <memory>
 #include <string>
 
+class SharedImage;
+class DisplayList;
+
 namespace cse335 {
 
 /**
@@ -33,11 +38,8 @@ namespace cse335 {
         /// Default number of steps when drawing a circle
         static const int DefaultCircleSteps = 32;
 
-        void DrawColorPolygon(std::shared_ptr<wxGraphicsContext> graphics, double x, double y, double r);
-        void DrawImagePolygon(std::shared_ptr<wxGraphicsContext> graphics, double x, double y, double r);
-
-        /// Graphics path to use to draw
-        wxGraphicsPath mPath;
+        void DrawColorPolygon(std::shared_ptr<DisplayList> list, double x, double y, double r);
+        void DrawImagePolygon(std::shared_ptr<DisplayList> list, double x, double y, double r);
 
         /// The points that make up the polygon
         std::vector<wxPoint2DDouble> mPoints;
@@ -56,11 +58,13 @@ namespace cse335 {
         /// The current mode
         Mode mMode = Mode::Unset;
 
-        /// The basic texture image we load
-        std::unique_ptr<wxImage> mImage;
+        /// The basic texture image we load, shared with
+        /// every other user of the same image file
+        std::shared_ptr<SharedImage> mImage;
 
-        /// The graphics bitmap we actually draw
-        wxGraphicsBitmap mGraphicsBitmap;
+        /// The image we actually draw. This is mImage unless
+        /// it had to be faded for the opacity.
+        std::shared_ptr<SharedImage> mDrawImage;
 
         /// The image clip region
         wxRegion mImageClipRegion;
@@ -80,6 +84,13 @@ namespace cse335 {
         /// Forces the bitmap to be reloaded
         bool mBitmapDirty = true;
 
+        /// The polygon recorded at the origin, replayed by
+        /// DrawPolygon when drawing onto a graphics context
+        std::shared_ptr<DisplayList> mDisplayList;
+
+        /// Forces mDisplayList to be recorded again
+        bool mDisplayListDirty = true;
+
 #ifdef POLYGON_DEFAULT_INVERTEDY
         /// Is the Y axis inverted (positive Y is up)?
         bool mInvertedY = true;
@@ -120,8 +131,7 @@ namespace cse335 {
 
         virtual ~Polygon();
 
-        /// Copy constructor (disabled)
-        Polygon(const Polygon &) = delete;
+        Polygon(const Polygon &other);
 
         /// Assignment operator
         void operator=(const Polygon &) = delete;
@@ -138,6 +148,8 @@ namespace cse335 {
 
         void SetImage(std::wstring filename);
 
+        void DrawPolygon(std::shared_ptr<DisplayList> list, double x, double y, double rotation);
+
         void DrawPolygon(std::shared_ptr<wxGraphicsContext> graphics, double x, double y, double rotation);
 
         virtual void SetOpacity(double opacity);
@@ -165,7 +177,7 @@ namespace cse335 {
          * An inverted Y axis means the positive Y direction is up
          * @param inverted True if inverted Y axis is desired
          */
-        void SetInvertedY(bool inverted) {mInvertedY = inverted;}
+        void SetInvertedY(bool inverted) {mInvertedY = inverted; mDisplayListDirty = true;}
 
         /**
          * Is this polygon a circle? We treat a circle special
@@ -7,6 +7,7 @@
 
 #include "pch.h"
 #include "Pulley.h"
+#include "DisplayList.h"
 
 ///Belt Color
 const wxColour BeltColor = wxColour(0,0,0);
@@ -27,29 +28,68 @@ Pulley::Pulley(double radius) : mRadius(radius)
 
 }
 
+/**
+ * Copy constructor. The copy is not connected to any
+ * other pulley until ConnectClone is called.
+ * @param other Pulley to copy
+ */
+Pulley::Pulley(const Pulley &other) : Component(other), mRotation(other.mRotation),
+    mPosition(other.mPosition), mPolygon(other.mPolygon), mRadius(other.mRadius), mSpeed(other.mSpeed)
+{
+    mSink.SetComponent(this);
+    mSource.SetComponent(this);
+}
+
+/**
+ * Create a copy of this pulley that is not part of any machine
+ * @return New pulley object
+ */
+std::shared_ptr<Component> Pulley::Clone()
+{
+    return std::make_shared<Pulley>(*this);
+}
+
+/**
+ * Connect the clone of this pulley to the clones of the
+ * components this one is connected to, including the belt
+ * to the pulley we drive.
+ * @param clone The clone of this pulley
+ * @param clones The clone of every component in the machine
+ */
+void Pulley::ConnectClone(Component *clone, const std::map<Component*, std::shared_ptr<Component>> &clones)
+{
+    Component::ConnectClone(clone, clones);
+
+    if (mConnectedPulley != nullptr)
+    {
+        auto connected = std::dynamic_pointer_cast<Pulley>(clones.at(mConnectedPulley.get()));
+        static_cast<Pulley*>(clone)->SetConnectedPulley(connected);
+    }
+}
+
 
 /**
  * Draw the pulley
- * @param graphics the context to draw on
+ * @param list the display list to record into
  */
-void Pulley::Draw(std::shared_ptr<wxGraphicsContext> graphics)
+void Pulley::Draw(std::shared_ptr<DisplayList> list)
 {
     if (mConnectedPulley != nullptr)
     {
-        graphics->SetPen(wxPen(BeltColor, BeltWidth));
+        list->SetPen(wxPen(BeltColor, BeltWidth));
         wxPoint2DDouble a = (mConnectedPulley->GetPosition()-GetPosition());
         a =  a/a.GetVectorLength()*mRadius;
         wxPoint2DDouble beta = wxPoint2DDouble(-a.m_y, a.m_x);
-        graphics->StrokeLine(GetPosition().m_x+beta.m_x,
+        list->StrokeLine(GetPosition().m_x+beta.m_x,
                              GetPosition().m_y + beta.m_y,
                              mConnectedPulley->GetPosition().m_x +beta.m_x,
                              mConnectedPulley->GetPosition().m_y + beta.m_y);
-        graphics->StrokeLine(GetPosition().m_x-beta.m_x,
+        list->StrokeLine(GetPosition().m_x-beta.m_x,
                              GetPosition().m_y - beta.m_y,
                              mConnectedPulley->GetPosition().m_x -beta.m_x,
                              mConnectedPulley->GetPosition().m_y - beta.m_y);
     }
-    mPolygon.DrawPolygon(graphics, mPosition.m_x, mPosition.m_y, mRotation);
+    mPolygon.DrawPolygon(list, mPosition.m_x, mPosition.m_y, mRotation);
 
 }
 
@@ -112,3 +152,26 @@ void Pulley::ResetComponent()
     mSpeed = 0;
 
 }
+
+/**
+ * Save the state of the pulley
+ * @param state Array to append the rotation and speed to
+ */
+void Pulley::SaveState(std::vector<double> &state)
+{
+    Component::SaveState(state);
+    state.push_back(mRotation);
+    state.push_back(mSpeed);
+}
+
+/**
+ * Restore the state of the pulley saved by SaveState
+ * @param state Array of saved state values
+ * @param index Index of the next value to read
+ */
+void Pulley::LoadState(const std::vector<double> &state, size_t &index)
+{
+    Component::LoadState(state, index);
+    mRotation = state[index++];
+    mSpeed = state[index++];
+}
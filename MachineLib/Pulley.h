@@ -46,8 +46,7 @@ public:
     ///default constructor
     Pulley(double radius);
 
-    /// Copy constructor (disabled)
-    Pulley(const Pulley &) = delete;
+    Pulley(const Pulley &other);
 
     ///virtual destructor
     virtual ~Pulley() {}
@@ -55,7 +54,11 @@ public:
     /// Assignment operator (disabled)
     void operator=(const Pulley &) = delete;
 
-    void Draw(std::shared_ptr<wxGraphicsContext> graphics) override;
+    std::shared_ptr<Component> Clone() override;
+
+    void ConnectClone(Component *clone, const std::map<Component*, std::shared_ptr<Component>> &clones) override;
+
+    void Draw(std::shared_ptr<DisplayList> list) override;
 
     void SetPosition(wxPoint2DDouble point);
 
@@ -72,13 +75,13 @@ public:
    * Get a pointer to the sink object
    * @return Pointer to RotationSource object
    */
-    RotationSink *GetSink() { return &mSink; }
+    RotationSink *GetSink() override { return &mSink; }
 
     /**
     * Get a pointer to the source object
     * @return Pointer to RotationSource object
     */
-    RotationSource *GetSource() { return &mSource; }
+    RotationSource *GetSource() override { return &mSource; }
 
     void Rotate(double rotation, double speed) override;
 
@@ -98,6 +101,10 @@ public:
 
 
     void ResetComponent() override;
+
+    void SaveState(std::vector<double> &state) override;
+
+    void LoadState(const std::vector<double> &state, size_t &index) override;
 };
 
 #endif //CANADIANEXPERIENCE_MACHINELIB_PULLEY_H
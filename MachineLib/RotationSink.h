@@ -54,6 +54,12 @@ public:
      */
      void SetComponent(Component * component) {mComponent = component;}
 
+     /**
+      * Get the component for the sink
+      * @return the component
+      */
+     Component * GetComponent() {return mComponent;}
+
      void Rotate(double rotation, double speed);
 
      /**
@@ -11,11 +11,34 @@
 
 /**
  * Rotate the sink
+ *
+ * Once the machine has compiled its rotation plan, a root source
+ * drives everything downstream of it by sweeping its plan array,
+ * and a driven source only records its rotation for the sweep to
+ * read. Without a plan, the rotation is passed on sink by sink.
  * @param rotation the rotation
  * @param speed the speed to rotate
  */
 void RotationSource::Rotate(double rotation, double speed)
 {
+    mRotation = rotation;
+    mSpeed = speed;
+
+    if (mDriven)
+    {
+        return;
+    }
+
+    if (mCompiled)
+    {
+        for (const auto &drive : mPlan)
+        {
+            auto driver = drive.mDriver;
+            drive.mTarget->Rotate(driver->mRotation * drive.mRatio, driver->mSpeed * drive.mRatio);
+        }
+        return;
+    }
+
     for (auto sink : mSinks)
     {
         sink->Rotate(rotation, speed);
@@ -23,6 +46,28 @@ void RotationSource::Rotate(double rotation, double speed)
 
 }
 
+/**
+ * Install a compiled rotation plan
+ * @param plan Plan for a root source, empty for a driven source
+ * @param driven true if this source is driven by another source
+ */
+void RotationSource::SetPlan(std::vector<Drive> plan, bool driven)
+{
+    mPlan = std::move(plan);
+    mDriven = driven;
+    mCompiled = true;
+}
+
+/**
+ * Remove any compiled plan, so rotation is passed on sink by sink
+ */
+void RotationSource::ClearPlan()
+{
+    mPlan.clear();
+    mDriven = false;
+    mCompiled = false;
+}
+
 /**
  * Add a sink to this source
  * @param sink the sink to add
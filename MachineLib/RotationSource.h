@@ -14,6 +14,23 @@ class Component;
 /** Class for rotation sources **/
 class RotationSource
 {
+public:
+    /**
+     * One step of a compiled rotation plan. The target
+     * sink is rotated by the driver source times the ratio.
+     */
+    struct Drive
+    {
+        /// Source driving the target
+        RotationSource *mDriver;
+
+        /// Ratio of the target rotation to the driver rotation
+        double mRatio;
+
+        /// Sink being driven
+        RotationSink *mTarget;
+    };
+
 private:
     /// The sinks of this source
     std::vector<RotationSink *> mSinks;
@@ -21,6 +38,22 @@ private:
     ///The parent component of the source
     Component * mComponent = nullptr;
 
+    /// The last rotation this source was given
+    double mRotation = 0;
+
+    /// The last speed this source was given
+    double mSpeed = 0;
+
+    /// Compiled plan for everything this source drives,
+    /// in topological order. Only set for a root source.
+    std::vector<Drive> mPlan;
+
+    /// Has a plan been compiled that includes this source?
+    bool mCompiled = false;
+
+    /// Is this source driven by another source in a compiled plan?
+    bool mDriven = false;
+
 public:
 
     ///Default constructor
@@ -48,6 +81,28 @@ public:
      * @return the component
      */
     Component * GetComponent() {return mComponent;}
+
+    /**
+     * Get the sinks this source drives
+     * @return Collection of sinks
+     */
+    const std::vector<RotationSink *> &GetSinks() const {return mSinks;}
+
+    /**
+     * Get the last rotation this source was given
+     * @return Rotation in turns
+     */
+    double GetRotation() const {return mRotation;}
+
+    /**
+     * Get the last speed this source was given
+     * @return Speed in turns per second
+     */
+    double GetSpeed() const {return mSpeed;}
+
+    void SetPlan(std::vector<Drive> plan, bool driven);
+
+    void ClearPlan();
 };
 
 #endif //CANADIANEXPERIENCE_MACHINELIB_ROTATIONSOURCE_H
@@ -0,0 +1,817 @@
+/**
+ * @file SoftwareRenderer.cpp
+ * @author Frederick Fan
+ */
+
+#include "pch.h"
+#include "SoftwareRenderer.h"
+#include "include/ImageCache.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+/// Use the SSE2 span kernels
+#define SOFTWARERENDERER_SSE2
+#endif
+
+/// Number of rows in a glyph of the built-in font
+const int GlyphRows = 7;
+
+/// Number of columns in a glyph of the built-in font
+const int GlyphColumns = 5;
+
+/// Number of rows of the font cell a glyph sits in, including spacing
+const int CellRows = 8;
+
+/// Number of columns of the font cell, including spacing
+const int CellColumns = 6;
+
+/// A glyph of the built-in font
+struct Glyph
+{
+    /// Character the glyph draws
+    char mCharacter;
+
+    /// Rows of the glyph from the top, the high bit of the five is the left column
+    unsigned char mRows[GlyphRows];
+};
+
+/// The built-in font. Lower case letters use the upper case glyphs.
+static const Glyph Font[] = {
+    {'0', {0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E}},
+    {'1', {0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E}},
+    {'2', {0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F}},
+    {'3', {0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E}},
+    {'4', {0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02}},
+    {'5', {0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E}},
+    {'6', {0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E}},
+    {'7', {0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08}},
+    {'8', {0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E}},
+    {'9', {0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C}},
+    {'A', {0x0E, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11}},
+    {'B', {0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E}},
+    {'C', {0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E}},
+    {'D', {0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C}},
+    {'E', {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F}},
+    {'F', {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10}},
+    {'G', {0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F}},
+    {'H', {0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11}},
+    {'I', {0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E}},
+    {'J', {0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C}},
+    {'K', {0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11}},
+    {'L', {0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F}},
+    {'M', {0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11}},
+    {'N', {0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11}},
+    {'O', {0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}},
+    {'P', {0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10}},
+    {'Q', {0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D}},
+    {'R', {0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11}},
+    {'S', {0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E}},
+    {'T', {0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04}},
+    {'U', {0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}},
+    {'V', {0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04}},
+    {'W', {0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A}},
+    {'X', {0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11}},
+    {'Y', {0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04}},
+    {'Z', {0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F}},
+    {'.', {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C}},
+    {',', {0x00, 0x00, 0x00, 0x00, 0x0C, 0x04, 0x08}},
+    {':', {0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00}},
+    {'-', {0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00}},
+    {'!', {0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04}},
+    {'?', {0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04}},
+    {'(', {0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02}},
+    {')', {0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08}},
+    {'/', {0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00}},
+    {'%', {0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03}},
+};
+
+/**
+ * Find the glyph for a character
+ * @param c Character
+ * @return Glyph or nullptr if the font does not have one
+ */
+static const Glyph *FindGlyph(wxUniChar c)
+{
+    auto value = (unsigned)c.GetValue();
+    if(value >= 'a' && value <= 'z')
+    {
+        value -= 'a' - 'A';
+    }
+
+    for(auto &glyph : Font)
+    {
+        if((unsigned)glyph.mCharacter == value)
+        {
+            return &glyph;
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * Divide by 255 with rounding, exact for products of two bytes
+ * @param x Value to divide
+ * @return x / 255
+ */
+static inline uint32_t Div255(uint32_t x)
+{
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+/**
+ * Draw a premultiplied pixel over another
+ * @param dst Destination pixel
+ * @param src Source pixel
+ * @return Blended pixel
+ */
+static inline uint32_t Blend(uint32_t dst, uint32_t src)
+{
+    uint32_t inverse = 255 - (src >> 24);
+    if(inverse == 0)
+    {
+        return src;
+    }
+
+    uint32_t result = 0;
+    for(int shift=0; shift<32; shift+=8)
+    {
+        uint32_t d = (dst >> shift) & 0xff;
+        uint32_t s = (src >> shift) & 0xff;
+        result |= std::min<uint32_t>(255, s + Div255(d * inverse)) << shift;
+    }
+    return result;
+}
+
+/**
+ * Draw a run of pixels of one premultiplied color
+ * @param dst First pixel of the run
+ * @param count Number of pixels
+ * @param color Color to draw over the pixels
+ */
+static void FillSpan(uint32_t *dst, int count, uint32_t color)
+{
+    uint32_t alpha = color >> 24;
+    if(alpha == 0)
+    {
+        return;
+    }
+
+    int i = 0;
+#ifdef SOFTWARERENDERER_SSE2
+    __m128i src = _mm_set1_epi32((int)color);
+    if(alpha == 255)
+    {
+        for( ; i + 4 <= count; i += 4)
+        {
+            _mm_storeu_si128((__m128i *)(dst + i), src);
+        }
+    }
+    else
+    {
+        __m128i zero = _mm_setzero_si128();
+        __m128i inverse = _mm_set1_epi16((short)(255 - alpha));
+        __m128i round = _mm_set1_epi16(128);
+        for( ; i + 4 <= count; i += 4)
+        {
+            __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+            __m128i lo = _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), inverse);
+            __m128i hi = _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), inverse);
+            lo = _mm_add_epi16(lo, round);
+            hi = _mm_add_epi16(hi, round);
+            lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+            hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+            d = _mm_adds_epu8(_mm_packus_epi16(lo, hi), src);
+            _mm_storeu_si128((__m128i *)(dst + i), d);
+        }
+    }
+#endif
+
+    for( ; i < count; i++)
+    {
+        dst[i] = alpha == 255 ? color : Blend(dst[i], color);
+    }
+}
+
+/**
+ * Sample a texture with bilinear filtering
+ * @param pixels Texture pixels
+ * @param width Texture width
+ * @param height Texture height
+ * @param u X in texels, 0 is the center of the left texel
+ * @param v Y in texels, 0 is the center of the top texel
+ * @return Premultiplied color
+ */
+static inline uint32_t Bilinear(const uint32_t *pixels, int width, int height, double u, double v)
+{
+    u = std::max(0.0, std::min(u, (double)(width - 1)));
+    v = std::max(0.0, std::min(v, (double)(height - 1)));
+
+    int x0 = (int)u;
+    int y0 = (int)v;
+    int x1 = std::min(x0 + 1, width - 1);
+    int y1 = std::min(y0 + 1, height - 1);
+
+    // Weights in 8.8 fixed point
+    int fx = (int)((u - x0) * 256);
+    int fy = (int)((v - y0) * 256);
+
+    uint32_t t00 = pixels[(size_t)y0 * width + x0];
+    uint32_t t10 = pixels[(size_t)y0 * width + x1];
+    uint32_t t01 = pixels[(size_t)y1 * width + x0];
+    uint32_t t11 = pixels[(size_t)y1 * width + x1];
+
+#ifdef SOFTWARERENDERER_SSE2
+    __m128i zero = _mm_setzero_si128();
+
+    // Both rows at once, left texels in one register and right in the other
+    __m128i left = _mm_unpacklo_epi8(_mm_set_epi32(0, 0, (int)t01, (int)t00), zero);
+    __m128i right = _mm_unpacklo_epi8(_mm_set_epi32(0, 0, (int)t11, (int)t10), zero);
+    __m128i rows = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(left, _mm_set1_epi16((short)(256 - fx))),
+                                                _mm_mullo_epi16(right, _mm_set1_epi16((short)fx))), 8);
+
+    // Then between the rows
+    __m128i bottom = _mm_srli_si128(rows, 8);
+    __m128i color = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(rows, _mm_set1_epi16((short)(256 - fy))),
+                                                 _mm_mullo_epi16(bottom, _mm_set1_epi16((short)fy))), 8);
+    return (uint32_t)_mm_cvtsi128_si32(_mm_packus_epi16(color, zero));
+#else
+    uint32_t result = 0;
+    for(int shift=0; shift<32; shift+=8)
+    {
+        uint32_t top = (((t00 >> shift) & 0xff) * (256 - fx) + ((t10 >> shift) & 0xff) * fx) >> 8;
+        uint32_t bottom = (((t01 >> shift) & 0xff) * (256 - fx) + ((t11 >> shift) & 0xff) * fx) >> 8;
+        result |= ((top * (256 - fy) + bottom * fy) >> 8) << shift;
+    }
+    return result;
+#endif
+}
+
+/**
+ * Constructor
+ * @param width Width of the framebuffer in pixels
+ * @param height Height of the framebuffer in pixels
+ */
+SoftwareRenderer::SoftwareRenderer(int width, int height) :
+    mWidth(std::max(width, 1)), mHeight(std::max(height, 1))
+{
+    mPixels.resize((size_t)mWidth * mHeight);
+}
+
+/**
+ * Convert a color to a premultiplied pixel
+ * @param color Color
+ * @return Pixel
+ */
+uint32_t SoftwareRenderer::Premultiply(const wxColour &color)
+{
+    uint32_t alpha = color.Alpha();
+    return Div255(color.Red() * alpha) | (Div255(color.Green() * alpha) << 8) |
+        (Div255(color.Blue() * alpha) << 16) | (alpha << 24);
+}
+
+/**
+ * Fill the whole framebuffer with a color
+ * @param color Color
+ */
+void SoftwareRenderer::Clear(const wxColour &color)
+{
+    std::fill(mPixels.begin(), mPixels.end(), Premultiply(color));
+}
+
+/**
+ * Get the buffer commands currently draw into
+ * @return Top layer or the framebuffer
+ */
+uint32_t *SoftwareRenderer::Target()
+{
+    return mLayers.empty() ? mPixels.data() : mLayers.back().data();
+}
+
+/**
+ * Get the texture for an image, converting it the first time
+ * @param image Image
+ * @return Texture
+ */
+const SoftwareRenderer::Texture &SoftwareRenderer::GetTexture(const std::shared_ptr<SharedImage> &image)
+{
+    auto &texture = mTextures[image.get()];
+    if(texture.mImage != nullptr)
+    {
+        return texture;
+    }
+
+    auto &source = image->GetImage();
+    texture.mImage = image;
+    texture.mWidth = source.GetWidth();
+    texture.mHeight = source.GetHeight();
+    texture.mPixels.resize((size_t)texture.mWidth * texture.mHeight);
+
+    const unsigned char *rgb = source.GetData();
+    const unsigned char *alpha = source.HasAlpha() ? source.GetAlpha() : nullptr;
+    bool mask = source.HasMask();
+    for(size_t i=0; i<texture.mPixels.size(); i++)
+    {
+        wxColour color(rgb[i * 3], rgb[i * 3 + 1], rgb[i * 3 + 2], alpha != nullptr ? alpha[i] : 255);
+        if(mask && color.Red() == source.GetMaskRed() && color.Green() == source.GetMaskGreen() &&
+            color.Blue() == source.GetMaskBlue())
+        {
+            color = wxColour(0, 0, 0, 0);
+        }
+        texture.mPixels[i] = Premultiply(color);
+    }
+
+    return texture;
+}
+
+/**
+ * Make the shape of a transformed rectangle
+ * @param matrix Transformation to pixels
+ * @param x Left of the rectangle
+ * @param y Top of the rectangle
+ * @param width Width of the rectangle
+ * @param height Height of the rectangle
+ * @return Shape
+ */
+SoftwareRenderer::Shape SoftwareRenderer::Quad(const DisplayList::Matrix &matrix, double x, double y,
+                                               double width, double height)
+{
+    double corners[4][2] = {{x, y}, {x + width, y}, {x + width, y + height}, {x, y + height}};
+
+    std::vector<Point> points;
+    for(auto &corner : corners)
+    {
+        points.push_back({matrix.a * corner[0] + matrix.c * corner[1] + matrix.tx,
+                          matrix.b * corner[0] + matrix.d * corner[1] + matrix.ty});
+    }
+    return {points};
+}
+
+/**
+ * Find the runs of pixels on a row that are inside a shape,
+ * using the even-odd rule and sampling at the pixel centers.
+ * @param shape Shape
+ * @param y Y of the pixel centers of the row
+ * @param spans Receives the runs in left to right order
+ */
+void SoftwareRenderer::Spans(const Shape &shape, double y, std::vector<Span> &spans)
+{
+    mCrossings.clear();
+    for(auto &polygon : shape)
+    {
+        for(size_t i=0; i<polygon.size(); i++)
+        {
+            auto &p0 = polygon[i];
+            auto &p1 = polygon[(i + 1) % polygon.size()];
+            if((p0.y <= y) != (p1.y <= y))
+            {
+                mCrossings.push_back(p0.x + (y - p0.y) * (p1.x - p0.x) / (p1.y - p0.y));
+            }
+        }
+    }
+
+    std::sort(mCrossings.begin(), mCrossings.end());
+
+    spans.clear();
+    for(size_t i=0; i+1<mCrossings.size(); i+=2)
+    {
+        int start = std::max(0, (int)std::ceil(mCrossings[i] - 0.5));
+        int end = std::min(mWidth, (int)std::ceil(mCrossings[i + 1] - 0.5));
+        if(start >= end)
+        {
+            continue;
+        }
+
+        if(!spans.empty() && spans.back().mEnd >= start)
+        {
+            spans.back().mEnd = std::max(spans.back().mEnd, end);
+        }
+        else
+        {
+            spans.push_back({start, end});
+        }
+    }
+}
+
+/**
+ * Find the runs of pixels on a row that are inside a shape and its clips
+ * @param list Display list the clip belongs to
+ * @param shape Shape
+ * @param clip Index of the innermost clip, -1 for none
+ * @param row Row of pixels
+ * @param spans Receives the runs in left to right order
+ * @return true if there are any runs
+ */
+bool SoftwareRenderer::RowSpans(const DisplayList &list, const Shape &shape, int clip, int row,
+                                std::vector<Span> &spans)
+{
+    double y = row + 0.5;
+    Spans(shape, y, spans);
+
+    std::vector<Span> clipSpans;
+    std::vector<Span> inside;
+    for( ; clip >= 0 && !spans.empty(); clip = list.GetClip(clip).mParent)
+    {
+        Spans(mClipShapes[clip], y, clipSpans);
+
+        // Intersect the two sorted lists of runs
+        inside.clear();
+        size_t i = 0, j = 0;
+        while(i < spans.size() && j < clipSpans.size())
+        {
+            int start = std::max(spans[i].mStart, clipSpans[j].mStart);
+            int end = std::min(spans[i].mEnd, clipSpans[j].mEnd);
+            if(start < end)
+            {
+                inside.push_back({start, end});
+            }
+
+            if(spans[i].mEnd < clipSpans[j].mEnd)
+            {
+                i++;
+            }
+            else
+            {
+                j++;
+            }
+        }
+        spans.swap(inside);
+    }
+
+    return !spans.empty();
+}
+
+/**
+ * Find the rows a shape covers inside the framebuffer and its clips
+ * @param list Display list the clip belongs to
+ * @param shape Shape
+ * @param clip Index of the innermost clip, -1 for none
+ * @param first Receives the first row
+ * @param last Receives the row after the last one
+ * @return true if there are any rows
+ */
+bool SoftwareRenderer::ShapeRows(const DisplayList &list, const Shape &shape, int clip, int &first, int &last)
+{
+    auto bounds = [](const Shape &shape, double &top, double &bottom) {
+        for(auto &polygon : shape)
+        {
+            for(auto &point : polygon)
+            {
+                top = std::min(top, point.y);
+                bottom = std::max(bottom, point.y);
+            }
+        }
+    };
+
+    double top = mHeight, bottom = 0;
+    bounds(shape, top, bottom);
+    for( ; clip >= 0; clip = list.GetClip(clip).mParent)
+    {
+        double clipTop = mHeight, clipBottom = 0;
+        bounds(mClipShapes[clip], clipTop, clipBottom);
+        top = std::max(top, clipTop);
+        bottom = std::min(bottom, clipBottom);
+    }
+
+    first = std::max(0, (int)std::floor(top));
+    last = std::min(mHeight, (int)std::ceil(bottom) + 1);
+    return first < last;
+}
+
+/**
+ * Fill a shape with a color
+ * @param list Display list the clip belongs to
+ * @param shape Shape in pixels
+ * @param clip Index of the innermost clip, -1 for none
+ * @param color Premultiplied color
+ */
+void SoftwareRenderer::Fill(const DisplayList &list, const Shape &shape, int clip, uint32_t color)
+{
+    int first, last;
+    if((color >> 24) == 0 || !ShapeRows(list, shape, clip, first, last))
+    {
+        return;
+    }
+
+    auto target = Target();
+    std::vector<Span> spans;
+    for(int row=first; row<last; row++)
+    {
+        if(RowSpans(list, shape, clip, row, spans))
+        {
+            for(auto &span : spans)
+            {
+                FillSpan(target + (size_t)row * mWidth + span.mStart, span.mEnd - span.mStart, color);
+            }
+        }
+    }
+}
+
+/**
+ * Draw a line
+ * @param list Display list the clip belongs to
+ * @param matrix Transformation to pixels
+ * @param clip Index of the innermost clip, -1 for none
+ * @param x1 X of the start of the line
+ * @param y1 Y of the start of the line
+ * @param x2 X of the end of the line
+ * @param y2 Y of the end of the line
+ * @param pen Pen to draw with
+ */
+void SoftwareRenderer::Line(const DisplayList &list, const DisplayList::Matrix &matrix, int clip,
+                            double x1, double y1, double x2, double y2, const wxPen &pen)
+{
+    if(pen.GetStyle() == wxPENSTYLE_TRANSPARENT)
+    {
+        return;
+    }
+
+    Point a = {matrix.a * x1 + matrix.c * y1 + matrix.tx, matrix.b * x1 + matrix.d * y1 + matrix.ty};
+    Point b = {matrix.a * x2 + matrix.c * y2 + matrix.tx, matrix.b * x2 + matrix.d * y2 + matrix.ty};
+
+    double length = std::hypot(b.x - a.x, b.y - a.y);
+    if(length == 0)
+    {
+        return;
+    }
+
+    // The pen width is in the coordinates the line was drawn in
+    double scale = std::sqrt(std::abs(matrix.a * matrix.d - matrix.b * matrix.c));
+    double half = std::max(1.0, std::max(pen.GetWidth(), 1) * scale) / 2;
+    double nx = -(b.y - a.y) / length * half;
+    double ny = (b.x - a.x) / length * half;
+
+    Shape shape = {{{a.x + nx, a.y + ny}, {b.x + nx, b.y + ny}, {b.x - nx, b.y - ny}, {a.x - nx, a.y - ny}}};
+    Fill(list, shape, clip, Premultiply(pen.GetColour()));
+}
+
+/**
+ * Draw a texture stretched to a rectangle
+ * @param list Display list the clip belongs to
+ * @param matrix Transformation to pixels
+ * @param clip Index of the innermost clip, -1 for none
+ * @param texture Texture to draw
+ * @param rect Left, top, width and height of the rectangle
+ */
+void SoftwareRenderer::Blit(const DisplayList &list, const DisplayList::Matrix &matrix, int clip,
+                            const Texture &texture, const double *rect)
+{
+    int first, last;
+    auto shape = Quad(matrix, rect[0], rect[1], rect[2], rect[3]);
+    if(texture.mPixels.empty() || rect[2] == 0 || rect[3] == 0 || !ShapeRows(list, shape, clip, first, last))
+    {
+        return;
+    }
+
+    // Map pixel centers back to texels
+    auto inverse = matrix.Inverse();
+    double su = texture.mWidth / rect[2];
+    double sv = texture.mHeight / rect[3];
+
+    auto target = Target();
+    std::vector<Span> spans;
+    for(int row=first; row<last; row++)
+    {
+        if(!RowSpans(list, shape, clip, row, spans))
+        {
+            continue;
+        }
+
+        double y = row + 0.5;
+        for(auto &span : spans)
+        {
+            auto dst = target + (size_t)row * mWidth;
+            for(int x=span.mStart; x<span.mEnd; x++)
+            {
+                double px = x + 0.5;
+                double lx = inverse.a * px + inverse.c * y + inverse.tx;
+                double ly = inverse.b * px + inverse.d * y + inverse.ty;
+                auto color = Bilinear(texture.mPixels.data(), texture.mWidth, texture.mHeight,
+                                      (lx - rect[0]) * su - 0.5, (ly - rect[1]) * sv - 0.5);
+                if((color >> 24) != 0)
+                {
+                    dst[x] = Blend(dst[x], color);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Draw text with the built-in font
+ * @param list Display list the clip belongs to
+ * @param matrix Transformation to pixels
+ * @param clip Index of the innermost clip, -1 for none
+ * @param text Text to draw
+ * @param x Left of the text
+ * @param y Top of the text
+ * @param font Font, only the size is used
+ * @param color Premultiplied color
+ */
+void SoftwareRenderer::Text(const DisplayList &list, const DisplayList::Matrix &matrix, int clip,
+                            const wxString &text, double x, double y, const wxFont &font, uint32_t color)
+{
+    double height = font.GetPixelSize().GetHeight();
+    if(height <= 0)
+    {
+        height = font.GetPointSize();
+    }
+    double cell = height / CellRows;
+
+    for(auto c : text)
+    {
+        auto glyph = FindGlyph(c);
+        for(int row=0; glyph != nullptr && row<GlyphRows; row++)
+        {
+            // Each run of lit columns is one rectangle
+            for(int column=0; column<GlyphColumns; )
+            {
+                auto lit = [glyph, row](int column) {
+                    return (glyph->mRows[row] >> (GlyphColumns - 1 - column)) & 1;
+                };
+
+                if(!lit(column))
+                {
+                    column++;
+                    continue;
+                }
+
+                int start = column;
+                while(column < GlyphColumns && lit(column))
+                {
+                    column++;
+                }
+
+                Fill(list, Quad(matrix, x + start * cell, y + row * cell, (column - start) * cell, cell),
+                     clip, color);
+            }
+        }
+
+        x += CellColumns * cell;
+    }
+}
+
+/**
+ * Draw a display list into the framebuffer
+ * @param list Display list to draw
+ */
+void SoftwareRenderer::Render(const DisplayList &list)
+{
+    mClipShapes.clear();
+    mLayers.clear();
+    mLayerOpacity.clear();
+
+    auto clipShape = [this, &list](int index) {
+        if(index >= (int)mClipShapes.size())
+        {
+            mClipShapes.resize(index + 1);
+        }
+
+        auto &shape = mClipShapes[index];
+        if(!shape.empty())
+        {
+            return;
+        }
+
+        auto &clip = list.GetClip(index);
+        auto matrix = mTransform * list.GetMatrix(clip.mMatrix);
+        if(clip.mIsRegion)
+        {
+            for(wxRegionIterator rect(clip.mRegion); rect; ++rect)
+            {
+                shape.push_back(Quad(matrix, rect.GetX(), rect.GetY(), rect.GetW(), rect.GetH())[0]);
+            }
+        }
+        else
+        {
+            shape = Quad(matrix, clip.mRect[0], clip.mRect[1], clip.mRect[2], clip.mRect[3]);
+        }
+    };
+
+    for(auto &command : list.GetCommands())
+    {
+        for(int clip = command.mClip; clip >= 0; clip = list.GetClip(clip).mParent)
+        {
+            clipShape(clip);
+        }
+
+        auto matrix = mTransform * list.GetMatrix(command.mMatrix);
+        auto values = command.mValues;
+
+        switch(command.mType)
+        {
+        case DisplayList::Type::FillPath:
+            if(command.mBrush >= 0 && list.GetBrush(command.mBrush).GetStyle() != wxBRUSHSTYLE_TRANSPARENT)
+            {
+                Shape shape(1);
+                for(int i=0; i<command.mCount; i++)
+                {
+                    auto &p = list.GetPoint(command.mFirst + i);
+                    shape[0].push_back({matrix.a * p.m_x + matrix.c * p.m_y + matrix.tx,
+                                        matrix.b * p.m_x + matrix.d * p.m_y + matrix.ty});
+                }
+                Fill(list, shape, command.mClip, Premultiply(list.GetBrush(command.mBrush).GetColour()));
+            }
+            break;
+
+        case DisplayList::Type::Rectangle:
+            if(command.mBrush >= 0 && list.GetBrush(command.mBrush).GetStyle() != wxBRUSHSTYLE_TRANSPARENT)
+            {
+                Fill(list, Quad(matrix, values[0], values[1], values[2], values[3]), command.mClip,
+                     Premultiply(list.GetBrush(command.mBrush).GetColour()));
+            }
+            if(command.mPen >= 0)
+            {
+                auto &pen = list.GetPen(command.mPen);
+                double right = values[0] + values[2];
+                double bottom = values[1] + values[3];
+                Line(list, matrix, command.mClip, values[0], values[1], right, values[1], pen);
+                Line(list, matrix, command.mClip, right, values[1], right, bottom, pen);
+                Line(list, matrix, command.mClip, right, bottom, values[0], bottom, pen);
+                Line(list, matrix, command.mClip, values[0], bottom, values[0], values[1], pen);
+            }
+            break;
+
+        case DisplayList::Type::Line:
+            if(command.mPen >= 0)
+            {
+                Line(list, matrix, command.mClip, values[0], values[1], values[2], values[3],
+                     list.GetPen(command.mPen));
+            }
+            break;
+
+        case DisplayList::Type::Bitmap:
+            Blit(list, matrix, command.mClip, GetTexture(list.GetTexture(command.mResource)), values);
+            break;
+
+        case DisplayList::Type::Text:
+            if(command.mFont >= 0)
+            {
+                auto &font = list.GetFont(command.mFont);
+                Text(list, matrix, command.mClip, list.GetText(command.mResource), values[0], values[1],
+                     font.first, Premultiply(font.second));
+            }
+            break;
+
+        case DisplayList::Type::BeginLayer:
+            mLayers.emplace_back(mPixels.size(), 0);
+            mLayerOpacity.push_back(std::max(0.0, std::min(values[0], 1.0)));
+            break;
+
+        case DisplayList::Type::EndLayer:
+            if(!mLayers.empty())
+            {
+                auto layer = std::move(mLayers.back());
+                auto opacity = (uint32_t)(mLayerOpacity.back() * 255 + 0.5);
+                mLayers.pop_back();
+                mLayerOpacity.pop_back();
+
+                auto target = Target();
+                for(size_t i=0; i<layer.size(); i++)
+                {
+                    uint32_t faded = 0;
+                    for(int shift=0; shift<32; shift+=8)
+                    {
+                        faded |= Div255(((layer[i] >> shift) & 0xff) * opacity) << shift;
+                    }
+                    target[i] = Blend(target[i], faded);
+                }
+            }
+            break;
+        }
+    }
+
+    // Layers that were never ended are dropped
+    mLayers.clear();
+    mLayerOpacity.clear();
+}
+
+/**
+ * Get the framebuffer as an image
+ * @return Image with an alpha channel
+ */
+wxImage SoftwareRenderer::GetImage() const
+{
+    wxImage image(mWidth, mHeight, false);
+    image.InitAlpha();
+
+    auto rgb = image.GetData();
+    auto alpha = image.GetAlpha();
+    for(size_t i=0; i<mPixels.size(); i++)
+    {
+        uint32_t pixel = mPixels[i];
+        uint32_t a = pixel >> 24;
+        alpha[i] = (unsigned char)a;
+        for(int c=0; c<3; c++)
+        {
+            uint32_t value = (pixel >> (8 * c)) & 0xff;
+            rgb[i * 3 + c] = (unsigned char)(a == 0 ? 0 : std::min<uint32_t>(255, (value * 255 + a / 2) / a));
+        }
+    }
+
+    return image;
+}
@@ -0,0 +1,173 @@
+/**
+ * @file SoftwareRenderer.h
+ * @author Frederick Fan
+ *
+ * Draws display lists into an RGBA framebuffer in memory
+ */
+
+#ifndef CANADIANEXPERIENCE_MACHINELIB_SOFTWARERENDERER_H
+#define CANADIANEXPERIENCE_MACHINELIB_SOFTWARERENDERER_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+#include "DisplayList.h"
+
+class SharedImage;
+
+/**
+ * Draws display lists into an RGBA framebuffer in memory.
+ *
+ * This needs no window, device context or GUI initialization, so it
+ * can render frames on build machines and in batch jobs. Pixels are
+ * kept premultiplied by alpha, one 32-bit value per pixel with the
+ * bytes in R, G, B, A order in memory.
+ *
+ * Filled paths, rectangles, lines, bitmaps and text are supported.
+ * Shapes are not antialiased. Text is drawn with a small built-in
+ * block font, since real fonts need the GUI.
+ */
+class SoftwareRenderer
+{
+private:
+    /// An image converted to premultiplied pixels for sampling
+    struct Texture
+    {
+        /// Image the texture was made from, held so it is not reused
+        std::shared_ptr<SharedImage> mImage;
+
+        /// Width in pixels
+        int mWidth = 0;
+
+        /// Height in pixels
+        int mHeight = 0;
+
+        /// Premultiplied pixels
+        std::vector<uint32_t> mPixels;
+    };
+
+    /// A point in pixel coordinates
+    struct Point
+    {
+        /// X in pixels
+        double x;
+
+        /// Y in pixels
+        double y;
+    };
+
+    /// One or more closed polygons in pixel coordinates
+    typedef std::vector<std::vector<Point>> Shape;
+
+    /// A run of pixels on a row, from mStart up to but not including mEnd
+    struct Span
+    {
+        /// First pixel
+        int mStart;
+
+        /// Pixel after the last one
+        int mEnd;
+    };
+
+    /// Width in pixels
+    int mWidth;
+
+    /// Height in pixels
+    int mHeight;
+
+    /// The framebuffer
+    std::vector<uint32_t> mPixels;
+
+    /// Layers started by BeginLayer commands, drawn into instead of the framebuffer
+    std::vector<std::vector<uint32_t>> mLayers;
+
+    /// Opacity of each layer
+    std::vector<double> mLayerOpacity;
+
+    /// Transformation from display list coordinates to pixels
+    DisplayList::Matrix mTransform;
+
+    /// Textures made from the images that have been drawn
+    std::map<const SharedImage*, Texture> mTextures;
+
+    /// Shape of each clip of the list being rendered, made as needed
+    std::vector<Shape> mClipShapes;
+
+    /// Scratch space for span computation
+    std::vector<double> mCrossings;
+
+    uint32_t *Target();
+
+    const Texture &GetTexture(const std::shared_ptr<SharedImage> &image);
+
+    void Spans(const Shape &shape, double y, std::vector<Span> &spans);
+
+    bool RowSpans(const DisplayList &list, const Shape &shape, int clip, int row, std::vector<Span> &spans);
+
+    bool ShapeRows(const DisplayList &list, const Shape &shape, int clip, int &first, int &last);
+
+    Shape Quad(const DisplayList::Matrix &matrix, double x, double y, double width, double height);
+
+    void Fill(const DisplayList &list, const Shape &shape, int clip, uint32_t color);
+
+    void Line(const DisplayList &list, const DisplayList::Matrix &matrix, int clip,
+              double x1, double y1, double x2, double y2, const wxPen &pen);
+
+    void Blit(const DisplayList &list, const DisplayList::Matrix &matrix, int clip,
+              const Texture &texture, const double *rect);
+
+    void Text(const DisplayList &list, const DisplayList::Matrix &matrix, int clip,
+              const wxString &text, double x, double y, const wxFont &font, uint32_t color);
+
+public:
+    SoftwareRenderer(int width, int height);
+
+    /// Copy constructor (disabled)
+    SoftwareRenderer(const SoftwareRenderer &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const SoftwareRenderer &) = delete;
+
+    /**
+     * Get the width of the framebuffer
+     * @return Width in pixels
+     */
+    int GetWidth() const { return mWidth; }
+
+    /**
+     * Get the height of the framebuffer
+     * @return Height in pixels
+     */
+    int GetHeight() const { return mHeight; }
+
+    /**
+     * Get the framebuffer
+     * @return Premultiplied pixels, row by row from the top
+     */
+    const std::vector<uint32_t> &GetPixels() const { return mPixels; }
+
+    /**
+     * Get a pixel of the framebuffer
+     * @param x X in pixels
+     * @param y Y in pixels
+     * @return Premultiplied pixel
+     */
+    uint32_t GetPixel(int x, int y) const { return mPixels[(size_t)y * mWidth + x]; }
+
+    /**
+     * Set the transformation from display list coordinates to pixels
+     * @param transform Transformation
+     */
+    void SetTransform(const DisplayList::Matrix &transform) { mTransform = transform; }
+
+    void Clear(const wxColour &color);
+
+    void Render(const DisplayList &list);
+
+    wxImage GetImage() const;
+
+    static uint32_t Premultiply(const wxColour &color);
+};
+
+#endif //CANADIANEXPERIENCE_MACHINELIB_SOFTWARERENDERER_H
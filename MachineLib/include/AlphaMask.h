@@ -0,0 +1,82 @@
+/**
+ * @file AlphaMask.h
+ * @author Frederick Fan
+ *
+ * One bit for each pixel of an image telling if it is opaque
+ */
+
+#ifndef CANADIANEXPERIENCE_MACHINELIB_ALPHAMASK_H
+#define CANADIANEXPERIENCE_MACHINELIB_ALPHAMASK_H
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * One bit for each pixel of an image telling if it is opaque.
+ *
+ * A pixel is opaque if wxImage::IsTransparent would say it is not
+ * transparent, so testing the mask gives the same answer while
+ * reading one bit instead of going through the image. The bits
+ * of each row are packed into 64 bit words.
+ */
+class AlphaMask
+{
+private:
+    /// Width in pixels
+    int mWidth = 0;
+
+    /// Height in pixels
+    int mHeight = 0;
+
+    /// Number of words in each row
+    int mStride = 0;
+
+    /// The bits, row by row
+    std::vector<uint64_t> mBits;
+
+    /// The smallest rectangle that contains every opaque pixel
+    wxRect mOpaqueBounds;
+
+public:
+    /// Constructor for an empty mask
+    AlphaMask() {}
+
+    explicit AlphaMask(const wxImage &image, unsigned char threshold = wxIMAGE_ALPHA_THRESHOLD);
+
+    /**
+     * Get the width of the mask
+     * @return Width in pixels
+     */
+    int GetWidth() const { return mWidth; }
+
+    /**
+     * Get the height of the mask
+     * @return Height in pixels
+     */
+    int GetHeight() const { return mHeight; }
+
+    /**
+     * Is a pixel opaque?
+     * @param x X coordinate of the pixel
+     * @param y Y coordinate of the pixel
+     * @return true if the pixel is opaque, false if it is
+     * transparent or outside the image
+     */
+    bool IsOpaque(int x, int y) const
+    {
+        if (x < 0 || y < 0 || x >= mWidth || y >= mHeight)
+        {
+            return false;
+        }
+
+        return (mBits[(size_t)y * mStride + (x >> 6)] >> (x & 63)) & 1;
+    }
+
+    /**
+     * Get the smallest rectangle that contains every opaque pixel
+     * @return Rectangle in pixels, empty if no pixel is opaque
+     */
+    wxRect GetOpaqueBounds() const { return mOpaqueBounds; }
+};
+
+#endif //CANADIANEXPERIENCE_MACHINELIB_ALPHAMASK_H
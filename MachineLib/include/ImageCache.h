@@ -0,0 +1,84 @@
+/**
+ * @file ImageCache.h
+ * @author Frederick Fan
+ *
+ * Process-wide cache of decoded images shared by everything
+ * that loads the same image file
+ */
+
+#ifndef CANADIANEXPERIENCE_MACHINELIB_IMAGECACHE_H
+#define CANADIANEXPERIENCE_MACHINELIB_IMAGECACHE_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "AlphaMask.h"
+
+/**
+ * A decoded image shared by everything that loads the same file.
+ *
+ * The graphics bitmap made from the image is shared too. A graphics
+ * bitmap belongs to the renderer that created it, so one is kept
+ * for each renderer the image has been drawn with.
+ */
+class SharedImage
+{
+private:
+    /// The decoded image
+    wxImage mImage;
+
+    /// Which pixels of the image are opaque, for hit testing
+    AlphaMask mMask;
+
+    /// Protects mBitmaps
+    std::mutex mMutex;
+
+    /// Graphics bitmaps made from the image for each renderer
+    std::map<wxGraphicsRenderer*, wxGraphicsBitmap> mBitmaps;
+
+public:
+    /**
+     * Constructor
+     * @param image The decoded image
+     */
+    explicit SharedImage(const wxImage &image) : mImage(image), mMask(image) {}
+
+    /// Copy constructor (disabled)
+    SharedImage(const SharedImage &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const SharedImage &) = delete;
+
+    /**
+     * Get the decoded image
+     * @return Image, which must not be changed
+     */
+    const wxImage &GetImage() const { return mImage; }
+
+    /**
+     * Get the mask of the opaque pixels of the image, made when it was loaded
+     * @return Alpha mask
+     */
+    const AlphaMask &GetMask() const { return mMask; }
+
+    wxGraphicsBitmap GetBitmap(std::shared_ptr<wxGraphicsContext> graphics);
+};
+
+/**
+ * Process-wide cache of decoded images.
+ *
+ * Images are keyed by path and reference counted. Loading a path
+ * that is already loaded returns the same image, and an image is
+ * released once nothing holds it anymore.
+ */
+class ImageCache
+{
+public:
+    static std::shared_ptr<SharedImage> Load(const std::wstring &filename);
+
+    static size_t GetCount();
+};
+
+#endif //CANADIANEXPERIENCE_MACHINELIB_IMAGECACHE_H
@@ -0,0 +1,221 @@
+/**
+ * @file main.cpp
+ * @author Frederick Fan
+ *
+ * Headless parameter sweep for the machines.
+ *
+ * Builds one machine for every combination of the parameter
+ * ranges, simulates them in parallel on all cores and prints
+ * the score and the time the first goal was scored as JSON.
+ *
+ * Ranges are given as min:max:step, or a single value.
+ *
+ * Usage: machine-sweep [--machine n] [--seconds s] [--rate fps] [--threads n]
+ *                      [--resources dir] [--spacing range] [--shot-x range]
+ *                      [--shot-y range] [--conveyor range]
+ */
+
+#include "pch.h"
+#include <wx/init.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <MachineSweep.h>
+
+/// Default number of seconds to simulate each machine
+const double DefaultSeconds = 30;
+
+/// Default frame rate in frames per second
+const double DefaultFrameRate = 30;
+
+/// Default resources directory, relative to the build directory
+/// the executable is run from
+const std::wstring DefaultResourcesDir = L"..";
+
+/// Most values a single range may expand to
+const int MaxRangeValues = 10000;
+
+/**
+ * Parse a range of the form min:max:step or a single value
+ * @param text Range to parse
+ * @param values Receives the values in the range
+ * @return true if the range is valid
+ */
+static bool ParseRange(const char *text, std::vector<double> &values)
+{
+    double min, max, step;
+    int count = sscanf(text, "%lf:%lf:%lf", &min, &max, &step);
+    if(count == 1)
+    {
+        values = {min};
+        return true;
+    }
+
+    if(count != 3 || step <= 0 || max < min || (max - min) / step >= MaxRangeValues)
+    {
+        return false;
+    }
+
+    values.clear();
+    for(int i=0; min + i * step <= max + step * 1e-6; i++)
+    {
+        values.push_back(min + i * step);
+    }
+    return true;
+}
+
+/**
+ * Print the usage message
+ */
+static void Usage()
+{
+    std::cerr << "Usage: machine-sweep [--machine n] [--seconds s] [--rate fps] [--threads n]" << std::endl;
+    std::cerr << "                     [--resources dir] [--spacing range] [--shot-x range]" << std::endl;
+    std::cerr << "                     [--shot-y range] [--conveyor range]" << std::endl;
+    std::cerr << "Ranges are min:max:step or a single value" << std::endl;
+}
+
+/**
+ * Main entry point for the sweep
+ * @param argc Number of arguments
+ * @param argv Arguments
+ * @return 0 if successful
+ */
+int main(int argc, char **argv)
+{
+    MachineParameters defaults;
+
+    int machineNumber = 1;
+    double seconds = DefaultSeconds;
+    double frameRate = DefaultFrameRate;
+    int threads = 0;
+    std::wstring resourcesDir = DefaultResourcesDir;
+    std::vector<double> spacings = {defaults.mDominoSpacing};
+    std::vector<double> shotXs = {defaults.mBasketShot.m_x};
+    std::vector<double> shotYs = {defaults.mBasketShot.m_y};
+    std::vector<double> conveyors = {defaults.mConveyorSpeedScale};
+
+    for(int i=1; i<argc; i++)
+    {
+        bool hasValue = i + 1 < argc;
+        bool ok = hasValue;
+        if(strcmp(argv[i], "--machine") == 0 && hasValue)
+        {
+            machineNumber = atoi(argv[++i]);
+        }
+        else if(strcmp(argv[i], "--seconds") == 0 && hasValue)
+        {
+            seconds = atof(argv[++i]);
+        }
+        else if(strcmp(argv[i], "--rate") == 0 && hasValue)
+        {
+            frameRate = atof(argv[++i]);
+        }
+        else if(strcmp(argv[i], "--threads") == 0 && hasValue)
+        {
+            threads = atoi(argv[++i]);
+        }
+        else if(strcmp(argv[i], "--resources") == 0 && hasValue)
+        {
+            resourcesDir = wxString(argv[++i]).ToStdWstring();
+        }
+        else if(strcmp(argv[i], "--spacing") == 0 && hasValue)
+        {
+            ok = ParseRange(argv[++i], spacings);
+        }
+        else if(strcmp(argv[i], "--shot-x") == 0 && hasValue)
+        {
+            ok = ParseRange(argv[++i], shotXs);
+        }
+        else if(strcmp(argv[i], "--shot-y") == 0 && hasValue)
+        {
+            ok = ParseRange(argv[++i], shotYs);
+        }
+        else if(strcmp(argv[i], "--conveyor") == 0 && hasValue)
+        {
+            ok = ParseRange(argv[++i], conveyors);
+        }
+        else
+        {
+            ok = false;
+        }
+
+        if(!ok)
+        {
+            Usage();
+            return 1;
+        }
+    }
+
+    if(seconds <= 0 || frameRate <= 0 || threads < 0)
+    {
+        Usage();
+        return 1;
+    }
+
+    // wxWidgets base library only, no GUI is ever created
+    wxInitializer initializer;
+    if(!initializer.IsOk())
+    {
+        std::cerr << "Unable to initialize wxWidgets" << std::endl;
+        return 1;
+    }
+
+    wxInitAllImageHandlers();
+
+    MachineSweep sweep(machineNumber, resourcesDir);
+    sweep.SetDuration(seconds);
+    sweep.SetFrameRate(frameRate);
+    sweep.SetThreadCount(threads);
+
+    for(auto spacing : spacings)
+    {
+        for(auto shotX : shotXs)
+        {
+            for(auto shotY : shotYs)
+            {
+                for(auto conveyor : conveyors)
+                {
+                    MachineParameters parameters;
+                    parameters.mDominoSpacing = spacing;
+                    parameters.mBasketShot = wxPoint2DDouble(shotX, shotY);
+                    parameters.mConveyorSpeedScale = conveyor;
+                    sweep.AddVariant(parameters);
+                }
+            }
+        }
+    }
+
+    using Clock = std::chrono::steady_clock;
+
+    auto start = Clock::now();
+    auto results = sweep.Run();
+    double total = std::chrono::duration<double>(Clock::now() - start).count();
+
+    printf("{\n");
+    printf("  \"machine\": %d,\n", machineNumber == 2 ? 2 : 1);
+    printf("  \"seconds\": %g,\n", seconds);
+    printf("  \"frameRate\": %g,\n", frameRate);
+    printf("  \"variants\": %d,\n", (int)results.size());
+    printf("  \"totalSeconds\": %.6f,\n", total);
+    printf("  \"results\": [");
+    for(size_t i=0; i<results.size(); i++)
+    {
+        auto &result = results[i];
+        printf(i == 0 ? "\n" : ",\n");
+        printf("    {\"spacing\": %g, \"shotX\": %g, \"shotY\": %g, \"conveyor\": %g, "
+               "\"score\": %d, \"goalTime\": %g}",
+               result.mParameters.mDominoSpacing,
+               result.mParameters.mBasketShot.m_x, result.mParameters.mBasketShot.m_y,
+               result.mParameters.mConveyorSpeedScale,
+               result.mScore, result.mGoalTime);
+    }
+    printf("\n  ]\n}\n");
+
+    return 0;
+}
@@ -8,6 +8,22 @@
 
 #include <MachineSystemFactory.h>
 #include <IMachineSystem.h>
+#include <MachineSystemActual.h>
+#include <Machine.h>
+#include <MachineCheckpoint.h>
+#include <MachineFrameCache.h>
+#include <Machine1Factory.h>
+#include <Machine2Factory.h>
+#include <MachinePrototypes.h>
+#include <Pulley.h>
+#include <RotationSource.h>
+#include <ImageCache.h>
+#include <AlphaMask.h>
+#include <MachineSweep.h>
+#include <MachineTrace.h>
+#include <DisplayList.h>
+#include <SoftwareRenderer.h>
+#include <algorithm>
 
 TEST(MachineTest, Constructor)
 {
@@ -61,4 +77,670 @@ TEST(MachineTest, MachineNumber)
     // Ensure we can go back to machine number 1
     machine->SetMachineNumber(1);
     ASSERT_EQ(1, machine->GetMachineNumber());
-}
\ No newline at end of file
+}
+
+TEST(MachineTest, Checkpoints)
+{
+    MachineSystemActual system(L".");
+    system.SetFrameRate(30);
+
+    // Running forward saves checkpoints along the way
+    system.SetMachineFrame(300);
+    ASSERT_GT(system.GetCheckpointCount(), 0u);
+
+    // A backward seek restores from a checkpoint and
+    // steps forward to the requested frame
+    system.SetMachineFrame(100);
+    ASSERT_NEAR(100.0 / 30.0, system.GetMachineTime(), 0.001);
+
+    system.SetMachineFrame(250);
+    ASSERT_NEAR(250.0 / 30.0, system.GetMachineTime(), 0.001);
+
+    // Changing the machine discards the checkpoints,
+    // leaving only the new one for frame 0
+    system.SetMachineNumber(2);
+    ASSERT_EQ(1u, system.GetCheckpointCount());
+}
+
+TEST(MachineTest, CheckpointRestore)
+{
+    Machine1Factory factory(L".");
+    auto machine = factory.Create();
+    machine->Reset();
+
+    for(int i=0; i<45; i++)
+    {
+        machine->Update(1.0 / 30.0);
+    }
+
+    auto checkpoint = machine->CreateCheckpoint(45);
+
+    // Run on, then restore back to the checkpoint
+    for(int i=0; i<45; i++)
+    {
+        machine->Update(1.0 / 30.0);
+    }
+
+    machine->RestoreCheckpoint(*checkpoint);
+    auto restored = machine->CreateCheckpoint(45);
+
+    ASSERT_EQ(checkpoint->GetBodies().size(), restored->GetBodies().size());
+    for(size_t i=0; i<checkpoint->GetBodies().size(); i++)
+    {
+        auto &a = checkpoint->GetBodies()[i];
+        auto &b = restored->GetBodies()[i];
+        ASSERT_FLOAT_EQ(a.mPosition.x, b.mPosition.x);
+        ASSERT_FLOAT_EQ(a.mPosition.y, b.mPosition.y);
+        ASSERT_FLOAT_EQ(a.mAngle, b.mAngle);
+        ASSERT_FLOAT_EQ(a.mLinearVelocity.x, b.mLinearVelocity.x);
+        ASSERT_FLOAT_EQ(a.mLinearVelocity.y, b.mLinearVelocity.y);
+    }
+
+    ASSERT_EQ(checkpoint->GetComponentState(), restored->GetComponentState());
+}
+
+TEST(MachineTest, CheckpointResume)
+{
+    // A plain run of the machine
+    Machine1Factory factory(L".");
+    auto machine = factory.Create();
+    machine->Reset();
+
+    std::vector<uint64_t> hashes = {machine->HashState()};
+    for(int frame=1; frame<=150; frame++)
+    {
+        machine->Update(1.0 / 30.0);
+        hashes.push_back(machine->HashState());
+    }
+
+    // Taking checkpoints along the way doesn't change the simulation
+    Machine1Factory factory2(L".");
+    auto cached = factory2.Create();
+    MachineFrameCache cache;
+    cached->Reset();
+    cache.AddCheckpoint(*cached, 0);
+    for(int frame=1; frame<=150; frame++)
+    {
+        cached->Update(1.0 / 30.0);
+        cache.AddCheckpoint(*cached, frame);
+        ASSERT_EQ(hashes[frame], cached->HashState()) << "frame " << frame;
+    }
+
+    // Machines restored from a checkpoint step on exactly as the plain run
+    // did, whether the machine is new or has already run past the frame
+    auto checkpoint = cache.FindCheckpoint(50);
+    ASSERT_NE(nullptr, checkpoint);
+    ASSERT_EQ(30, checkpoint->GetFrame());
+
+    Machine1Factory factory3(L".");
+    for(auto resumed : {factory3.Create(), machine, cached})
+    {
+        resumed->RestoreCheckpoint(*checkpoint);
+        ASSERT_EQ(hashes[30], resumed->HashState());
+
+        for(int frame=31; frame<=150; frame++)
+        {
+            resumed->Update(1.0 / 30.0);
+            ASSERT_EQ(hashes[frame], resumed->HashState()) << "frame " << frame;
+        }
+    }
+
+    // So does a machine restored from a checkpoint taken at any other frame
+    auto late = machine->CreateCheckpoint(150);
+    for(int frame=151; frame<=180; frame++)
+    {
+        machine->Update(1.0 / 30.0);
+        hashes.push_back(machine->HashState());
+    }
+
+    cached->RestoreCheckpoint(*checkpoint);
+    cached->RestoreCheckpoint(*late);
+    for(int frame=151; frame<=180; frame++)
+    {
+        cached->Update(1.0 / 30.0);
+        ASSERT_EQ(hashes[frame], cached->HashState()) << "frame " << frame;
+    }
+}
+
+TEST(MachineTest, FixedStep)
+{
+    // The same machine updated at two different frame
+    // rates takes the same physics steps
+    Machine1Factory factory(L".");
+    auto machine30 = factory.Create();
+    auto machine15 = factory.Create();
+    machine30->Reset();
+    machine15->Reset();
+
+    ASSERT_NEAR(1.0 / 30.0, machine30->GetStepSize(), 0.0001);
+
+    for(int i=0; i<60; i++)
+    {
+        machine30->Update(1.0 / 30.0);
+    }
+
+    for(int i=0; i<30; i++)
+    {
+        machine15->Update(1.0 / 15.0);
+    }
+
+    auto state30 = machine30->CreateCheckpoint(60);
+    auto state15 = machine15->CreateCheckpoint(30);
+    ASSERT_EQ(state30->GetBodies().size(), state15->GetBodies().size());
+    for(size_t i=0; i<state30->GetBodies().size(); i++)
+    {
+        ASSERT_FLOAT_EQ(state30->GetBodies()[i].mPosition.x, state15->GetBodies()[i].mPosition.x);
+        ASSERT_FLOAT_EQ(state30->GetBodies()[i].mPosition.y, state15->GetBodies()[i].mPosition.y);
+        ASSERT_FLOAT_EQ(state30->GetBodies()[i].mAngle, state15->GetBodies()[i].mAngle);
+    }
+
+    // A finer step takes several steps per frame
+    machine30->SetStepSize(1.0 / 120.0);
+    machine30->Reset();
+    machine30->Update(1.0 / 30.0);
+    ASSERT_NEAR(1.0 / 30.0, machine30->CreateCheckpoint(1)->GetComponentState()[0], 0.0001);
+}
+
+TEST(MachineTest, Bake)
+{
+    MachineSystemActual system(L".");
+    system.SetFrameRate(30);
+
+    // Frame 0 is recorded as soon as the machine is created
+    ASSERT_EQ(1, system.GetBakedFrames());
+
+    // Simulated frames are recorded as we go
+    system.SetMachineFrame(60);
+    ASSERT_EQ(61, system.GetBakedFrames());
+
+    system.Bake(120);
+    ASSERT_EQ(120, system.GetBakedFrames());
+
+    // Seeking within the baked frames and back out again
+    system.SetMachineFrame(10);
+    ASSERT_NEAR(10.0 / 30.0, system.GetMachineTime(), 0.001);
+    system.SetMachineFrame(150);
+    ASSERT_NEAR(150.0 / 30.0, system.GetMachineTime(), 0.001);
+    ASSERT_EQ(151, system.GetBakedFrames());
+
+    // Changing the frame rate discards the recording
+    system.SetFrameRate(15);
+    ASSERT_EQ(0, system.GetBakedFrames());
+
+    // and it is recorded again from frame 0 at the new rate
+    system.SetMachineFrame(30);
+    ASSERT_NEAR(30.0 / 15.0, system.GetMachineTime(), 0.001);
+    ASSERT_EQ(31, system.GetBakedFrames());
+
+    system.SetMachineFrame(0);
+    ASSERT_EQ(0, system.GetMachineTime());
+    ASSERT_EQ(31, system.GetBakedFrames());
+}
+
+TEST(MachineTest, Presimulate)
+{
+    MachineSystemActual system(L".");
+    system.SetFrameRate(30);
+    system.SetLookahead(60);
+    system.SetMachineFrame(10);
+
+    // Wait for the background thread to get ahead of us. It
+    // does all of the recording and stops at the lookahead.
+    system.WaitForLookahead();
+    ASSERT_EQ(71, system.GetBakedFrames());
+
+    // These frames are shown from the recording
+    system.SetMachineFrame(70);
+    ASSERT_NEAR(70.0 / 30.0, system.GetMachineTime(), 0.001);
+
+    // Turning it off stops the thread
+    system.SetLookahead(0);
+    ASSERT_EQ(0, system.GetLookahead());
+}
+
+TEST(MachineTest, RotationPlan)
+{
+    Machine machine(1);
+
+    auto pulley1 = std::make_shared<Pulley>(10);
+    auto pulley2 = std::make_shared<Pulley>(10);
+    auto pulley3 = std::make_shared<Pulley>(10);
+
+    // Add them out of order so the plan has to sort them
+    machine.AddComponent(pulley3);
+    machine.AddComponent(pulley2);
+    machine.AddComponent(pulley1);
+
+    pulley1->Drive(pulley2);
+    pulley2->Drive(pulley3);
+
+    machine.Reset();
+
+    // Pulley 2 picks up the speed, but a pulley only passes on
+    // its own rotation, which is still zero, so pulley 3 does not
+    pulley1->GetSource()->Rotate(1, 2);
+    ASSERT_DOUBLE_EQ(2, pulley2->GetSource()->GetSpeed());
+    ASSERT_DOUBLE_EQ(0, pulley2->GetSource()->GetRotation());
+    ASSERT_DOUBLE_EQ(0, pulley3->GetSource()->GetSpeed());
+
+    // Once pulley 2 has turned, pulley 3 is driven too
+    pulley2->UpdateTime(0.5);
+    pulley1->GetSource()->Rotate(2, 2);
+    ASSERT_DOUBLE_EQ(1, pulley2->GetSource()->GetRotation());
+    ASSERT_DOUBLE_EQ(2, pulley3->GetSource()->GetSpeed());
+}
+
+TEST(MachineTest, RotationPlanTwoRoots)
+{
+    Machine machine(1);
+
+    auto pulley1 = std::make_shared<Pulley>(10);
+    auto pulley2 = std::make_shared<Pulley>(10);
+    auto pulley3 = std::make_shared<Pulley>(10);
+    auto pulley4 = std::make_shared<Pulley>(10);
+
+    machine.AddComponent(pulley1);
+    machine.AddComponent(pulley2);
+    machine.AddComponent(pulley3);
+    machine.AddComponent(pulley4);
+
+    // Pulley 3 is driven by both pulley 1 and pulley 2
+    pulley1->Drive(pulley3);
+    pulley2->Drive(pulley3);
+    pulley3->Drive(pulley4);
+
+    machine.Reset();
+
+    // Either root drives all the way down the chain
+    pulley1->GetSource()->Rotate(1, 2);
+    ASSERT_DOUBLE_EQ(2, pulley3->GetSource()->GetSpeed());
+    pulley3->UpdateTime(0.5);
+    pulley1->GetSource()->Rotate(2, 2);
+    ASSERT_DOUBLE_EQ(2, pulley4->GetSource()->GetSpeed());
+
+    pulley2->GetSource()->Rotate(1, 3);
+    ASSERT_DOUBLE_EQ(3, pulley3->GetSource()->GetSpeed());
+    ASSERT_DOUBLE_EQ(3, pulley4->GetSource()->GetSpeed());
+}
+
+TEST(MachineTest, ImageCache)
+{
+    auto count = ImageCache::GetCount();
+
+    auto image1 = ImageCache::Load(L"./images/domino-red.png");
+    ASSERT_NE(nullptr, image1);
+    ASSERT_EQ(count + 1, ImageCache::GetCount());
+
+    // Loading the same file again shares the decoded image
+    auto image2 = ImageCache::Load(L"./images/domino-red.png");
+    ASSERT_EQ(image1, image2);
+    ASSERT_EQ(count + 1, ImageCache::GetCount());
+
+    ASSERT_EQ(nullptr, ImageCache::Load(L"./images/no-such-image.png"));
+
+    // Released once nothing holds it anymore
+    image1 = nullptr;
+    image2 = nullptr;
+    ASSERT_EQ(count, ImageCache::GetCount());
+}
+
+TEST(MachineTest, AlphaMask)
+{
+    // Wide enough that rows span more than one word of bits
+    wxImage image(70, 3);
+    image.InitAlpha();
+    for(int y=0; y<image.GetHeight(); y++)
+    {
+        for(int x=0; x<image.GetWidth(); x++)
+        {
+            image.SetAlpha(x, y, (unsigned char)((x * 7 + y * 3) % 256));
+        }
+    }
+    image.SetAlpha(0, 0, 0);
+    image.SetAlpha(69, 2, 0);
+
+    AlphaMask mask(image);
+    ASSERT_EQ(70, mask.GetWidth());
+    ASSERT_EQ(3, mask.GetHeight());
+    for(int y=0; y<image.GetHeight(); y++)
+    {
+        for(int x=0; x<image.GetWidth(); x++)
+        {
+            ASSERT_EQ(!image.IsTransparent(x, y), mask.IsOpaque(x, y));
+        }
+    }
+
+    ASSERT_FALSE(mask.IsOpaque(-1, 0));
+    ASSERT_FALSE(mask.IsOpaque(70, 0));
+    ASSERT_FALSE(mask.IsOpaque(0, 3));
+
+    // Only the middle pixels are opaque
+    std::fill(image.GetAlpha(), image.GetAlpha() + 70 * 3, 0);
+    image.SetAlpha(10, 1, 255);
+    image.SetAlpha(65, 2, 255);
+    ASSERT_EQ(wxRect(wxPoint(10, 1), wxPoint(65, 2)), AlphaMask(image).GetOpaqueBounds());
+
+    // Loaded images get their mask when they are loaded
+    auto loaded = ImageCache::Load(L"./images/domino-red.png");
+    ASSERT_NE(nullptr, loaded);
+    auto &domino = loaded->GetImage();
+    ASSERT_EQ(domino.GetWidth(), loaded->GetMask().GetWidth());
+    ASSERT_EQ(domino.GetHeight(), loaded->GetMask().GetHeight());
+    ASSERT_EQ(!domino.IsTransparent(domino.GetWidth() / 2, domino.GetHeight() / 2),
+              loaded->GetMask().IsOpaque(domino.GetWidth() / 2, domino.GetHeight() / 2));
+}
+
+TEST(MachineTest, Clone)
+{
+    // A machine cloned from a prototype behaves just like one from the factory
+    Machine2Factory factory(L".");
+    auto built = factory.Create();
+    auto cloned = MachinePrototypes::Create(2, L".");
+    ASSERT_NE(built, cloned);
+
+    built->Reset();
+    cloned->Reset();
+    for(int i=0; i<90; i++)
+    {
+        built->Update(1.0 / 30.0);
+        cloned->Update(1.0 / 30.0);
+    }
+
+    auto a = built->CreateCheckpoint(90);
+    auto b = cloned->CreateCheckpoint(90);
+
+    ASSERT_EQ(a->GetBodies().size(), b->GetBodies().size());
+    for(size_t i=0; i<a->GetBodies().size(); i++)
+    {
+        ASSERT_FLOAT_EQ(a->GetBodies()[i].mPosition.x, b->GetBodies()[i].mPosition.x);
+        ASSERT_FLOAT_EQ(a->GetBodies()[i].mPosition.y, b->GetBodies()[i].mPosition.y);
+        ASSERT_FLOAT_EQ(a->GetBodies()[i].mAngle, b->GetBodies()[i].mAngle);
+    }
+
+    ASSERT_EQ(a->GetComponentState(), b->GetComponentState());
+
+    // Each request gets a new machine
+    ASSERT_NE(cloned, MachinePrototypes::Create(2, L"."));
+
+    // Clearing the prototypes releases the images they hold
+    built = nullptr;
+    cloned = nullptr;
+    auto count = ImageCache::GetCount();
+    MachinePrototypes::Clear();
+    ASSERT_LT(ImageCache::GetCount(), count);
+    ASSERT_NE(nullptr, MachinePrototypes::Create(2, L"."));
+}
+
+TEST(MachineTest, ResetInPlace)
+{
+    Machine1Factory factory(L".");
+    auto machine = factory.Create();
+    machine->Reset();
+    auto initial = machine->CreateCheckpoint(0);
+
+    for(int i=0; i<90; i++)
+    {
+        machine->Update(1.0 / 30.0);
+    }
+
+    // Resetting again puts the bodies back rather than rebuilding the world
+    machine->Reset();
+    auto reset = machine->CreateCheckpoint(0);
+
+    ASSERT_EQ(initial->GetBodies().size(), reset->GetBodies().size());
+    for(size_t i=0; i<initial->GetBodies().size(); i++)
+    {
+        auto &a = initial->GetBodies()[i];
+        auto &b = reset->GetBodies()[i];
+        ASSERT_FLOAT_EQ(a.mPosition.x, b.mPosition.x);
+        ASSERT_FLOAT_EQ(a.mPosition.y, b.mPosition.y);
+        ASSERT_FLOAT_EQ(a.mAngle, b.mAngle);
+        ASSERT_FLOAT_EQ(a.mLinearVelocity.x, b.mLinearVelocity.x);
+        ASSERT_FLOAT_EQ(a.mLinearVelocity.y, b.mLinearVelocity.y);
+        ASSERT_FLOAT_EQ(a.mAngularVelocity, b.mAngularVelocity);
+        ASSERT_EQ(a.mAwake, b.mAwake);
+    }
+
+    // No contacts are found until the world steps again
+    ASSERT_EQ(0u, reset->GetPhysics().GetContactCount());
+
+    // From there it runs exactly like a new machine
+    Machine1Factory factory2(L".");
+    auto built = factory2.Create();
+    built->Reset();
+    for(int frame=1; frame<=90; frame++)
+    {
+        machine->Update(1.0 / 30.0);
+        built->Update(1.0 / 30.0);
+        ASSERT_EQ(built->HashState(), machine->HashState()) << "frame " << frame;
+    }
+}
+
+TEST(MachineTest, Sweep)
+{
+    MachineSweep sweep(2, L".");
+    sweep.SetDuration(5);
+    sweep.SetThreadCount(2);
+
+    MachineParameters parameters;
+    sweep.AddVariant(parameters);
+    parameters.mBasketShot = wxPoint2DDouble(1.5, 8);
+    sweep.AddVariant(parameters);
+    sweep.AddVariant(MachineParameters());
+    ASSERT_EQ(3u, sweep.GetVariantCount());
+
+    auto results = sweep.Run();
+    ASSERT_EQ(3u, results.size());
+
+    // Results come back in the order the variants were added
+    ASSERT_DOUBLE_EQ(1.5, results[1].mParameters.mBasketShot.m_x);
+
+    // The same machine gives the same result on whatever thread it ran
+    ASSERT_EQ(results[0].mScore, results[2].mScore);
+    ASSERT_DOUBLE_EQ(results[0].mGoalTime, results[2].mGoalTime);
+    ASSERT_EQ(results[0].mScore > 0, results[0].mGoalTime >= 0);
+}
+
+TEST(MachineTest, Trace)
+{
+    Machine1Factory factory(L".");
+    auto machine = factory.Create();
+    auto trace = std::make_shared<MachineTrace>();
+    machine->SetTrace(trace);
+    machine->Reset();
+
+    std::shared_ptr<MachineCheckpoint> checkpoint;
+    for(int i=0; i<60; i++)
+    {
+        machine->Update(1.0 / 30.0);
+        if(i == 29)
+        {
+            checkpoint = machine->CreateCheckpoint(30);
+        }
+    }
+    ASSERT_EQ(60, trace->GetFrameCount());
+
+    // A separately built machine follows exactly the same path
+    Machine1Factory factory2(L".");
+    auto machine2 = factory2.Create();
+    auto trace2 = std::make_shared<MachineTrace>();
+    machine2->SetTrace(trace2);
+    machine2->Reset();
+    for(int i=0; i<60; i++)
+    {
+        machine2->Update(1.0 / 30.0);
+    }
+    ASSERT_EQ(-1, MachineTrace::FindDifference(*trace, *trace2));
+
+    // So does a machine resumed from a checkpoint
+    auto resumed = std::make_shared<MachineTrace>();
+    for(int i=0; i<30; i++)
+    {
+        resumed->Record(trace->GetHashes()[i]);
+    }
+    machine2->SetTrace(resumed);
+    machine2->RestoreCheckpoint(*checkpoint);
+    for(int i=30; i<60; i++)
+    {
+        machine2->Update(1.0 / 30.0);
+    }
+    ASSERT_EQ(-1, MachineTrace::FindDifference(*trace, *resumed));
+
+    // A trace survives being saved and loaded
+    auto filename = wxFileName::CreateTempFileName(L"trace").ToStdWstring();
+    ASSERT_TRUE(trace->Save(filename));
+    MachineTrace loaded;
+    ASSERT_TRUE(loaded.Load(filename));
+    wxRemoveFile(filename);
+    ASSERT_EQ(-1, MachineTrace::FindDifference(*trace, loaded));
+
+    // Differences are found at the first frame that differs
+    MachineTrace changed;
+    for(int i=0; i<60; i++)
+    {
+        changed.Record(i == 42 ? 0 : trace->GetHashes()[i]);
+    }
+    ASSERT_EQ(42, MachineTrace::FindDifference(*trace, changed));
+
+    // A trace that stops early differs where it stops
+    changed.Clear();
+    changed.Record(trace->GetHashes()[0]);
+    ASSERT_EQ(1, MachineTrace::FindDifference(*trace, changed));
+}
+
+TEST(MachineTest, DisplayList)
+{
+    DisplayList::Matrix translate;
+    translate.tx = 10;
+    translate.ty = 20;
+    DisplayList::Matrix scale;
+    scale.a = 2;
+    scale.d = -2;
+
+    // Matrices combine the same way wxGraphicsContext transformations do
+    auto both = translate * scale;
+    ASSERT_DOUBLE_EQ(2, both.a);
+    ASSERT_DOUBLE_EQ(-2, both.d);
+    ASSERT_DOUBLE_EQ(10, both.tx);
+    ASSERT_DOUBLE_EQ(20, both.ty);
+    ASSERT_TRUE((both * both.Inverse()).IsIdentity());
+
+    DisplayList list;
+    list.PushState();
+    list.Translate(10, 20);
+    list.Scale(2, -2);
+    list.SetBrush(*wxRED_BRUSH);
+    list.DrawRectangle(0, 0, 5, 5);
+    list.PopState();
+    list.StrokeLine(0, 0, 1, 1);
+
+    // Each command carries the transformation it was recorded under
+    auto &commands = list.GetCommands();
+    ASSERT_EQ(2u, commands.size());
+    ASSERT_EQ(DisplayList::Type::Rectangle, commands[0].mType);
+    ASSERT_TRUE(list.GetMatrix(commands[0].mMatrix) == both);
+    ASSERT_TRUE(list.GetMatrix(commands[1].mMatrix).IsIdentity());
+
+    // Recording the same frame of a machine twice gives the same list
+    Machine1Factory factory(L".");
+    auto machine = factory.Create();
+    machine->Reset();
+    machine->Update(1.0);
+
+    auto first = std::make_shared<DisplayList>();
+    auto second = std::make_shared<DisplayList>();
+    machine->Record(first);
+    machine->Record(second);
+    ASSERT_FALSE(first->GetCommands().empty());
+    ASSERT_TRUE(first->IsSameAs(*second));
+
+    // and a later frame does not
+    machine->Update(1.0);
+    second->Clear();
+    machine->Record(second);
+    ASSERT_FALSE(first->IsSameAs(*second));
+
+    // Paths built by a replay are kept when the list is cleared and reused
+    // for the same points in the next recording, wherever they are placed
+    std::vector<wxPoint2DDouble> triangle = {{0, 0}, {10, 0}, {0, 10}};
+    wxImage image(50, 50);
+    auto graphics = std::shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create(image));
+    DisplayList paths;
+    paths.SetBrush(*wxRED_BRUSH);
+    paths.FillPath(triangle);
+    paths.Replay(graphics);
+    ASSERT_EQ(1, paths.GetPathsBuilt());
+
+    paths.Clear();
+    paths.Translate(20, 20);
+    paths.SetBrush(*wxRED_BRUSH);
+    paths.FillPath(triangle);
+    paths.Replay(graphics);
+    ASSERT_EQ(1, paths.GetPathsBuilt());
+
+    // Different points get a new path
+    triangle[2].m_y = 20;
+    paths.Clear();
+    paths.SetBrush(*wxRED_BRUSH);
+    paths.FillPath(triangle);
+    paths.Replay(graphics);
+    ASSERT_EQ(2, paths.GetPathsBuilt());
+}
+
+TEST(MachineTest, SoftwareRenderer)
+{
+    SoftwareRenderer renderer(40, 20);
+    renderer.Clear(*wxWHITE);
+    ASSERT_EQ(0xffffffffu, renderer.GetPixel(0, 0));
+
+    DisplayList list;
+    list.SetBrush(*wxRED_BRUSH);
+    list.DrawRectangle(5, 5, 10, 10);
+
+    // Half transparent blue, clipped to the right half
+    list.PushState();
+    list.Clip(20, 0, 20, 20);
+    list.SetBrush(wxBrush(wxColour(0, 0, 255, 128)));
+    list.DrawRectangle(10, 0, 30, 4);
+    list.PopState();
+
+    list.SetPen(wxPen(*wxGREEN, 1));
+    list.StrokeLine(0, 18.5, 40, 18.5);
+
+    renderer.Render(list);
+
+    ASSERT_EQ(SoftwareRenderer::Premultiply(*wxRED), renderer.GetPixel(10, 10));
+    ASSERT_EQ(0xffffffffu, renderer.GetPixel(16, 10));
+    ASSERT_EQ(0xffffffffu, renderer.GetPixel(15, 2));
+    ASSERT_EQ(0xffff7f7fu, renderer.GetPixel(25, 2));
+    ASSERT_EQ(SoftwareRenderer::Premultiply(*wxGREEN), renderer.GetPixel(30, 18));
+
+    // A whole machine renders without any GUI
+    Machine1Factory factory(L".");
+    auto machine = factory.Create();
+    machine->Reset();
+
+    auto recorded = std::make_shared<DisplayList>();
+    machine->Record(recorded);
+
+    SoftwareRenderer frame(640, 360);
+    DisplayList::Matrix transform;
+    transform.a = 0.75;
+    transform.d = -0.75;
+    transform.tx = 320;
+    transform.ty = 330;
+    frame.SetTransform(transform);
+    frame.Clear(*wxWHITE);
+    frame.Render(*recorded);
+
+    int drawn = 0;
+    for(auto pixel : frame.GetPixels())
+    {
+        drawn += pixel != 0xffffffffu;
+    }
+    ASSERT_GT(drawn, 1000);
+
+    auto image = frame.GetImage();
+    ASSERT_EQ(640, image.GetWidth());
+    ASSERT_EQ(360, image.GetHeight());
+}
@@ -151,4 +151,53 @@ TEST(ActorTest, Animation)
     picture->SetAnimationTime(2.0);    // 1/3 between the two keyframes
     ASSERT_EQ((int)(101 + 1.0 / 3.0 * (202 - 101)), actor->GetPosition().x);
     ASSERT_EQ((int)(655 + 1.0 / 3.0 * (1000 - 655)), actor->GetPosition().y);
-}
\ No newline at end of file
+}
+TEST(ActorTest, Place)
+{
+    Actor actor(L"Harold");
+    actor.SetPosition(wxPoint(100, 200));
+
+    auto torso = std::make_shared<PolyDrawable>(L"Torso");
+    auto arm = std::make_shared<PolyDrawable>(L"Arm");
+    auto hand = std::make_shared<PolyDrawable>(L"Hand");
+    torso->SetPosition(wxPoint(0, -50));
+    arm->SetPosition(wxPoint(10, 0));
+    hand->SetPosition(wxPoint(0, 20));
+
+    actor.SetRoot(torso);
+    actor.AddDrawable(torso);
+    torso->AddChild(arm);
+    actor.AddDrawable(arm);
+
+    actor.Place();
+    ASSERT_FALSE(torso->IsDirty());
+    ASSERT_EQ(110, arm->GetPlacedPosition().x);
+    ASSERT_EQ(150, arm->GetPlacedPosition().y);
+
+    // Drawables added after placing are placed too
+    arm->AddChild(hand);
+    actor.AddDrawable(hand);
+    actor.Place();
+    ASSERT_EQ(110, hand->GetPlacedPosition().x);
+    ASSERT_EQ(170, hand->GetPlacedPosition().y);
+
+    // Rotating the arm moves the hand with it
+    arm->SetRotation(M_PI / 2);
+    ASSERT_TRUE(arm->IsDirty());
+    actor.Place();
+    ASSERT_NEAR(M_PI / 2, hand->GetPlacedRotation(), 0.0001);
+    ASSERT_EQ(130, hand->GetPlacedPosition().x);
+    ASSERT_EQ(150, hand->GetPlacedPosition().y);
+
+    // Setting the same rotation is not a change
+    arm->SetRotation(M_PI / 2);
+    ASSERT_FALSE(arm->IsDirty());
+
+    // Moving the actor moves everything
+    actor.SetPosition(wxPoint(0, 0));
+    actor.Place();
+    ASSERT_EQ(0, torso->GetPlacedPosition().x);
+    ASSERT_EQ(-50, torso->GetPlacedPosition().y);
+    ASSERT_EQ(30, hand->GetPlacedPosition().x);
+    ASSERT_EQ(-50, hand->GetPlacedPosition().y);
+}
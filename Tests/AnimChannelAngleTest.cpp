@@ -7,10 +7,50 @@
 #include "gtest/gtest.h"
 
 #include <AnimChannelAngle.h>
+#include <Timeline.h>
 
 TEST(AnimChannelAngleTest, Name)
 {
     AnimChannelAngle channel;
     channel.SetName(L"abcdexx");
     ASSERT_EQ(std::wstring(L"abcdexx"), channel.GetName());
-}
\ No newline at end of file
+}
+
+TEST(AnimChannelAngleTest, Seek)
+{
+    // A frame rate of 1 makes times and frames the same
+    Timeline timeline;
+    timeline.SetFrameRate(1);
+    timeline.SetNumFrames(2000);
+
+    AnimChannelAngle channel;
+    timeline.AddChannel(&channel);
+
+    // The angle at every keyframe is its frame number,
+    // so the tweened angle is always the current frame
+    for (int frame = 0; frame <= 1000; frame += 10)
+    {
+        timeline.SetCurrentTime(frame);
+        channel.SetKeyframe(frame);
+    }
+
+    // Random seeks in both directions
+    for (int frame : {995, 5, 503, 504, 0, 1000, 12, 990, 500, 1500})
+    {
+        timeline.SetCurrentTime(frame);
+        ASSERT_NEAR(std::min(frame, 1000), channel.GetAngle(), 0.0001) << "frame " << frame;
+    }
+
+    // Sequential playback across keyframes, forward and back
+    for (int frame = 0; frame <= 1000; frame++)
+    {
+        timeline.SetCurrentTime(frame);
+        ASSERT_NEAR(frame, channel.GetAngle(), 0.0001);
+    }
+
+    for (int frame = 1000; frame >= 0; frame--)
+    {
+        timeline.SetCurrentTime(frame);
+        ASSERT_NEAR(frame, channel.GetAngle(), 0.0001);
+    }
+}
@@ -0,0 +1,159 @@
+/**
+ * @file AnimFileTest.cpp
+ * @author Frederick Fan
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+
+#include <AnimFile.h>
+#include <Timeline.h>
+#include <AnimChannelAngle.h>
+#include <AnimChannelPoint.h>
+
+/**
+ * A timeline with an angle and a point channel
+ */
+class AnimFileTestTimeline
+{
+public:
+    Timeline mTimeline;             ///< The timeline
+    AnimChannelAngle mAngle;        ///< Angle channel
+    AnimChannelPoint mPoint;        ///< Point channel
+    AnimChannelAngle mEmpty;        ///< Channel with no keyframes
+
+    /// Constructor
+    AnimFileTestTimeline()
+    {
+        mAngle.SetName(L"Harold angle");
+        mPoint.SetName(L"Harold position");
+        mEmpty.SetName(L"Sparty angle");
+        mTimeline.AddChannel(&mAngle);
+        mTimeline.AddChannel(&mPoint);
+        mTimeline.AddChannel(&mEmpty);
+    }
+};
+
+/**
+ * Save a timeline to XML text, so two timelines can be compared
+ * @param timeline Timeline to save
+ * @return Every attribute of every node, in order
+ */
+static std::wstring XmlText(Timeline &timeline)
+{
+    wxXmlNode root(wxXML_ELEMENT_NODE, L"anim");
+    timeline.Save(&root);
+
+    wxString text;
+    for (auto channel = root.GetChildren(); channel; channel = channel->GetNext())
+    {
+        text += L"channel " + channel->GetAttribute(L"name", L"") + L"\n";
+        for (auto keyframe = channel->GetChildren(); keyframe; keyframe = keyframe->GetNext())
+        {
+            text += keyframe->GetAttribute(L"frame", L"") + L" " + keyframe->GetAttribute(L"angle", L"") + L" " +
+                    keyframe->GetAttribute(L"x", L"") + L" " + keyframe->GetAttribute(L"y", L"") + L"\n";
+        }
+    }
+
+    return text.ToStdWstring();
+}
+
+TEST(AnimFileTest, RoundTrip)
+{
+    AnimFileTestTimeline saved;
+    saved.mTimeline.SetNumFrames(450);
+    saved.mTimeline.SetFrameRate(15);
+    saved.mAngle.AddKeyframe(-5, 0.1);
+    saved.mAngle.AddKeyframe(0, -1.0 / 3);
+    saved.mAngle.AddKeyframe(2000000000, 1e300);
+    saved.mPoint.AddKeyframe(3, wxPoint(-2000000000, 2000000000));
+    saved.mPoint.AddKeyframe(30, wxPoint(2000000000, -2000000000));
+
+    AnimFile::Attributes attributes;
+    attributes[L"MachineOneId"] = 2;
+    attributes[L"MachineOneAnimationStart"] = -7;
+
+    auto data = AnimFile::Write(saved.mTimeline, attributes);
+
+    AnimFileTestTimeline loaded;
+    AnimFile::Attributes loadedAttributes;
+    ASSERT_TRUE(AnimFile::Read(data.data(), data.size(), loaded.mTimeline, loadedAttributes));
+
+    ASSERT_EQ(450, loaded.mTimeline.GetNumFrames());
+    ASSERT_EQ(15, loaded.mTimeline.GetFrameRate());
+    ASSERT_TRUE(attributes == loadedAttributes);
+
+    // Nothing is lost
+    ASSERT_TRUE(saved.mAngle.GetKeyframeFrames() == loaded.mAngle.GetKeyframeFrames());
+    ASSERT_TRUE(saved.mAngle.GetKeyframeAngles() == loaded.mAngle.GetKeyframeAngles());
+    ASSERT_TRUE(saved.mPoint.GetKeyframeFrames() == loaded.mPoint.GetKeyframeFrames());
+    ASSERT_TRUE(saved.mPoint.GetKeyframePoints() == loaded.mPoint.GetKeyframePoints());
+    ASSERT_EQ(0, loaded.mEmpty.GetKeyframeCount());
+    ASSERT_TRUE(XmlText(saved.mTimeline) == XmlText(loaded.mTimeline));
+
+    // The channels are located after loading
+    loaded.mTimeline.SetCurrentTime(0);
+    ASSERT_NEAR(-1.0 / 3, loaded.mAngle.GetAngle(), 0.0001);
+    ASSERT_EQ(-2000000000, loaded.mPoint.GetPoint().x);
+}
+
+TEST(AnimFileTest, FromXml)
+{
+    // Load from XML, save as binary and back to XML
+    AnimFileTestTimeline saved;
+    for (int frame = 0; frame < 300; frame += 7)
+    {
+        saved.mTimeline.SetCurrentTime(frame / 30.0);
+        saved.mAngle.SetKeyframe(frame * 0.01);
+        saved.mPoint.SetKeyframe(wxPoint(frame, -frame * 2));
+    }
+
+    wxXmlNode root(wxXML_ELEMENT_NODE, L"anim");
+    saved.mTimeline.Save(&root);
+
+    AnimFileTestTimeline xml;
+    xml.mTimeline.Load(&root);
+
+    AnimFile::Attributes attributes;
+    auto data = AnimFile::Write(xml.mTimeline, attributes);
+
+    AnimFileTestTimeline loaded;
+    ASSERT_TRUE(AnimFile::Read(data.data(), data.size(), loaded.mTimeline, attributes));
+    ASSERT_TRUE(XmlText(xml.mTimeline) == XmlText(loaded.mTimeline));
+    ASSERT_EQ(43, loaded.mPoint.GetKeyframeCount());
+}
+
+TEST(AnimFileTest, Invalid)
+{
+    AnimFileTestTimeline saved;
+    saved.mAngle.AddKeyframe(0, 1);
+    saved.mAngle.AddKeyframe(10, 2);
+
+    AnimFile::Attributes attributes;
+    auto data = AnimFile::Write(saved.mTimeline, attributes);
+
+    AnimFileTestTimeline loaded;
+    loaded.mAngle.AddKeyframe(5, 3);
+
+    // Every shortened file is rejected and leaves the timeline alone
+    for (size_t size = 0; size < data.size(); size++)
+    {
+        ASSERT_FALSE(AnimFile::Read(data.data(), size, loaded.mTimeline, attributes));
+        ASSERT_EQ(1, loaded.mAngle.GetKeyframeCount());
+    }
+
+    // So is a file from a later version
+    auto later = data;
+    later[8]++;
+    ASSERT_FALSE(AnimFile::Read(later.data(), later.size(), loaded.mTimeline, attributes));
+
+    // Or one with no frame rate, which channels divide by
+    auto stopped = data;
+    ASSERT_EQ(30, stopped[16]);
+    stopped[16] = 0;
+    ASSERT_FALSE(AnimFile::Read(stopped.data(), stopped.size(), loaded.mTimeline, attributes));
+    ASSERT_EQ(1, loaded.mAngle.GetKeyframeCount());
+
+    ASSERT_TRUE(AnimFile::Read(data.data(), data.size(), loaded.mTimeline, attributes));
+    ASSERT_EQ(2, loaded.mAngle.GetKeyframeCount());
+}
@@ -0,0 +1,81 @@
+/**
+ * @file PictureExporterTest.cpp
+ * @author Frederick Fan
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+#include <wx/filename.h>
+#include <PictureExporter.h>
+#include <PictureFactory.h>
+#include <Picture.h>
+#include <Timeline.h>
+#include <fstream>
+
+TEST(PictureExporterTest, ThreadCount)
+{
+    PictureFactory factory;
+    auto picture = factory.Create(L".");
+    picture->GetTimeline()->SetNumFrames(90);
+
+    PictureExporter exporter(picture, L".");
+    exporter.SetSize(wxSize(150, 80));
+    exporter.SetFormat(PictureExporter::Format::Y4M);
+
+    // Export on one thread and on several
+    auto filename1 = wxFileName::CreateTempFileName(L"export1");
+    exporter.SetThreadCount(1);
+    ASSERT_TRUE(exporter.Export(filename1));
+
+    auto filename4 = wxFileName::CreateTempFileName(L"export4");
+    exporter.SetThreadCount(4);
+    ASSERT_TRUE(exporter.Export(filename4));
+
+    std::ifstream file1(filename1.fn_str(), std::ios::binary);
+    std::ifstream file4(filename4.fn_str(), std::ios::binary);
+    std::vector<char> data1((std::istreambuf_iterator<char>(file1)), std::istreambuf_iterator<char>());
+    std::vector<char> data4((std::istreambuf_iterator<char>(file4)), std::istreambuf_iterator<char>());
+    file1.close();
+    file4.close();
+    wxRemoveFile(filename1);
+    wxRemoveFile(filename4);
+
+    // Every frame is written and each one is the same
+    auto headerSize = PictureExporter::GetY4mHeader(wxSize(150, 80), picture->GetTimeline()->GetFrameRate()).size();
+    ASSERT_EQ(headerSize + 90 * PictureExporter::GetY4mFrameSize(wxSize(150, 80)), data1.size());
+    ASSERT_TRUE(data1 == data4);
+}
+
+TEST(PictureExporterTest, FrameFilename)
+{
+    wxFileName name(PictureExporter::GetFrameFilename(L"out.png", 17));
+    ASSERT_EQ(L"out00017.png", name.GetFullName());
+}
+
+TEST(PictureExporterTest, Y4m)
+{
+    ASSERT_EQ("YUV4MPEG2 W3 H2 F30:1 Ip A1:1 C420jpeg\n", PictureExporter::GetY4mHeader(wxSize(3, 2), 30));
+
+    // Odd sizes round the chroma planes up
+    ASSERT_EQ(6u + 3 * 2 + 2 * 2 * 1, PictureExporter::GetY4mFrameSize(wxSize(3, 2)));
+
+    wxImage image(3, 2);
+    image.SetRGB(wxRect(0, 0, 3, 2), 255, 255, 255);
+    image.SetRGB(2, 0, 0, 0, 0);
+    image.SetRGB(2, 1, 0, 0, 0);
+
+    std::vector<unsigned char> frame;
+    PictureExporter::ConvertY4m(image, frame);
+    ASSERT_EQ(PictureExporter::GetY4mFrameSize(wxSize(3, 2)), frame.size());
+    ASSERT_EQ("FRAME\n", std::string(frame.begin(), frame.begin() + 6));
+
+    // White and black luma
+    ASSERT_EQ(255, frame[6]);
+    ASSERT_EQ(0, frame[6 + 2]);
+
+    // Gray has no color
+    for(int i=6 + 6; i<(int)frame.size(); i++)
+    {
+        ASSERT_NEAR(128, frame[i], 1);
+    }
+}
@@ -7,6 +7,7 @@
 #include "gtest/gtest.h"
 #include <Picture.h>
 #include <Actor.h>
+#include <PolyDrawable.h>
 
 using namespace std;
 
@@ -80,4 +81,118 @@ TEST(PictureTest, GetTimeline)
 
     Timeline *timeline = picture.GetTimeline();
     ASSERT_NE(nullptr, timeline);
-}
\ No newline at end of file
+}
+/**
+ * Create a square polygon drawable
+ * @param name Drawable name
+ * @param position Position relative to the parent
+ * @param size Width and height of the square
+ * @return New drawable
+ */
+static std::shared_ptr<PolyDrawable> MakeSquare(const std::wstring &name, wxPoint position, int size)
+{
+    auto square = std::make_shared<PolyDrawable>(name);
+    square->SetPosition(position);
+    square->AddPoint(wxPoint(0, 0));
+    square->AddPoint(wxPoint(size, 0));
+    square->AddPoint(wxPoint(size, size));
+    square->AddPoint(wxPoint(0, size));
+    return square;
+}
+
+TEST(PictureTest, HitTest)
+{
+    wxBitmap bitmap(1000, 1000);
+    wxMemoryDC dc(bitmap);
+    auto graphics = std::shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create(dc));
+
+    Picture picture;
+
+    // Two overlapping squares in one actor, the child drawn on top
+    auto actor1 = make_shared<Actor>(L"One");
+    actor1->SetPosition(wxPoint(100, 100));
+    auto body1 = MakeSquare(L"Body", wxPoint(0, 0), 200);
+    auto arm1 = MakeSquare(L"Arm", wxPoint(150, 50), 200);
+    actor1->SetRoot(body1);
+    actor1->AddDrawable(body1);
+    body1->AddChild(arm1);
+    actor1->AddDrawable(arm1);
+    picture.AddActor(actor1);
+
+    // A rotated actor drawn over the first one
+    auto actor2 = make_shared<Actor>(L"Two");
+    actor2->SetPosition(wxPoint(250, 200));
+    auto body2 = MakeSquare(L"Body", wxPoint(0, 0), 150);
+    body2->SetRotation(0.5);
+    actor2->SetRoot(body2);
+    actor2->AddDrawable(body2);
+    picture.AddActor(actor2);
+
+    // An actor that can't be clicked, on top of everything
+    auto actor3 = make_shared<Actor>(L"Three");
+    actor3->SetPosition(wxPoint(120, 120));
+    actor3->SetClickable(false);
+    auto body3 = MakeSquare(L"Body", wxPoint(0, 0), 100);
+    actor3->SetRoot(body3);
+    actor3->AddDrawable(body3);
+    picture.AddActor(actor3);
+
+    // A square that covers too many grid cells to be put in them
+    auto actor4 = make_shared<Actor>(L"Four");
+    actor4->SetPosition(wxPoint(500, 0));
+    auto body4 = MakeSquare(L"Body", wxPoint(0, 0), 900);
+    actor4->SetRoot(body4);
+    actor4->AddDrawable(body4);
+    picture.AddActor(actor4);
+
+    // The picture hit tests the same as testing every actor in
+    // drawing order and keeping the last hit, as the view used to
+    auto compare = [&picture]() {
+        int hits = 0;
+        for (int y = 0; y < 1000; y += 9)
+        {
+            for (int x = 0; x < 1000; x += 9)
+            {
+                wxPoint pos(x, y);
+                shared_ptr<Actor> expectedActor;
+                shared_ptr<Drawable> expected;
+                for (auto actor : picture)
+                {
+                    auto drawable = actor->HitTest(pos);
+                    if (drawable != nullptr)
+                    {
+                        expectedActor = actor;
+                        expected = drawable;
+                    }
+                }
+
+                shared_ptr<Actor> hitActor;
+                auto hit = picture.HitTest(pos, hitActor);
+                ASSERT_TRUE(hit == expected);
+                if (hit != nullptr)
+                {
+                    ASSERT_TRUE(hitActor == expectedActor);
+                    hits++;
+                }
+            }
+        }
+
+        ASSERT_TRUE(hits > 0);
+    };
+
+    picture.Draw(graphics);
+    compare();
+
+    // Where the squares overlap, the one drawn last is hit
+    shared_ptr<Actor> hitActor;
+    ASSERT_TRUE(picture.HitTest(wxPoint(260, 160), hitActor) == arm1);
+    ASSERT_TRUE(picture.HitTest(wxPoint(130, 130), hitActor) == body1);
+    ASSERT_TRUE(hitActor == actor1);
+
+    // Move the actors, some staying in the same grid cells
+    actor1->SetPosition(wxPoint(110, 105));
+    actor2->SetPosition(wxPoint(600, 500));
+    actor4->SetPosition(wxPoint(0, 600));
+    picture.Draw(graphics);
+    compare();
+}
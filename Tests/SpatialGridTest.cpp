@@ -0,0 +1,125 @@
+/**
+ * @file SpatialGridTest.cpp
+ * @author Frederick Fan
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+
+#include <SpatialGrid.h>
+#include <algorithm>
+
+/**
+ * Find the rectangles that contain a point, sorted by ID
+ * @param grid Grid to query
+ * @param pos Point to find
+ * @return IDs of the rectangles
+ */
+static std::vector<int> Find(const SpatialGrid &grid, wxPoint pos)
+{
+    std::vector<int> ids;
+    grid.Query(pos, ids);
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+TEST(SpatialGridTest, Query)
+{
+    SpatialGrid grid(10);
+    ASSERT_EQ(0, grid.Add(wxRect(0, 0, 5, 5)));
+    ASSERT_EQ(1, grid.Add(wxRect(3, 3, 20, 20)));
+    ASSERT_EQ(2, grid.Add(wxRect(-15, -15, 10, 10)));
+    ASSERT_EQ(3, grid.Add(wxRect()));
+    ASSERT_EQ(4, grid.GetCount());
+
+    ASSERT_TRUE(Find(grid, wxPoint(0, 0)) == std::vector<int>({0}));
+    ASSERT_TRUE(Find(grid, wxPoint(4, 4)) == std::vector<int>({0, 1}));
+    ASSERT_TRUE(Find(grid, wxPoint(5, 5)) == std::vector<int>({1}));
+    ASSERT_TRUE(Find(grid, wxPoint(22, 22)) == std::vector<int>({1}));
+    ASSERT_TRUE(Find(grid, wxPoint(23, 23)).empty());
+    ASSERT_TRUE(Find(grid, wxPoint(-6, -6)) == std::vector<int>({2}));
+    ASSERT_TRUE(Find(grid, wxPoint(-5, -5)).empty());
+}
+
+TEST(SpatialGridTest, Move)
+{
+    SpatialGrid grid(10);
+    grid.Add(wxRect(0, 0, 5, 5));
+    grid.Add(wxRect(100, 100, 5, 5));
+
+    // Within the same cell
+    grid.Move(0, wxRect(2, 2, 5, 5));
+    ASSERT_TRUE(Find(grid, wxPoint(0, 0)).empty());
+    ASSERT_TRUE(Find(grid, wxPoint(6, 6)) == std::vector<int>({0}));
+
+    // To other cells
+    grid.Move(0, wxRect(95, 95, 10, 10));
+    ASSERT_TRUE(Find(grid, wxPoint(6, 6)).empty());
+    ASSERT_TRUE(Find(grid, wxPoint(101, 101)) == std::vector<int>({0, 1}));
+
+    // Larger than a query should look through the cells for
+    grid.Move(1, wxRect(-1000, -1000, 5000, 5000));
+    ASSERT_TRUE(Find(grid, wxPoint(-999, 3999)) == std::vector<int>({1}));
+    ASSERT_TRUE(Find(grid, wxPoint(100, 100)) == std::vector<int>({0, 1}));
+
+    // And back
+    grid.Move(1, wxRect(100, 100, 5, 5));
+    ASSERT_TRUE(Find(grid, wxPoint(-999, 3999)).empty());
+
+    // Empty
+    grid.Move(0, wxRect());
+    ASSERT_TRUE(Find(grid, wxPoint(101, 101)) == std::vector<int>({1}));
+}
+
+TEST(SpatialGridTest, MoveMany)
+{
+    // Small steps that keep some cells and leave others, growing,
+    // shrinking, and jumps into and out of the large list
+    SpatialGrid grid(10);
+    std::vector<wxRect> rects;
+    unsigned int seed = 1;
+    auto next = [&seed](int range) {
+        seed = seed * 1103515245 + 12345;
+        return (int)((seed >> 16) % range);
+    };
+
+    for (int i = 0; i < 20; i++)
+    {
+        rects.push_back(wxRect(next(200) - 100, next(200) - 100, next(40), next(40)));
+        grid.Add(rects.back());
+    }
+
+    for (int step = 0; step < 500; step++)
+    {
+        int id = next((int)rects.size());
+        auto &rect = rects[id];
+        if (next(10) == 0)
+        {
+            rect = wxRect(next(400) - 200, next(400) - 200, next(200) + 1, next(200) + 1);
+        }
+        else
+        {
+            rect = wxRect(rect.x + next(21) - 10, rect.y + next(21) - 10,
+                          std::max(0, rect.width + next(11) - 5), std::max(0, rect.height + next(11) - 5));
+        }
+        grid.Move(id, rect);
+
+        // The grid finds what looking at every rectangle finds
+        for (int y = -120; y < 120; y += 7)
+        {
+            for (int x = -120; x < 120; x += 7)
+            {
+                std::vector<int> expected;
+                for (int i = 0; i < (int)rects.size(); i++)
+                {
+                    if (rects[i].Contains(wxPoint(x, y)))
+                    {
+                        expected.push_back(i);
+                    }
+                }
+
+                ASSERT_TRUE(Find(grid, wxPoint(x, y)) == expected);
+            }
+        }
+    }
+}
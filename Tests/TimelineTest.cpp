@@ -8,6 +8,8 @@
 
 #include <Timeline.h>
 #include <AnimChannelAngle.h>
+#include <AnimChannelPoint.h>
+#include <wx/mstream.h>
 
 
 TEST(TimelineTest, NumFrames)
@@ -83,4 +85,155 @@ TEST(TimelineTest, Add)
 
     timeline.AddChannel(&channel);
     ASSERT_EQ(&timeline, channel.GetTimeline());
-}
\ No newline at end of file
+}
+
+TEST(TimelineTest, EvaluateChannels)
+{
+    Timeline timeline;
+    timeline.SetFrameRate(10);
+
+    // More angle channels than are tweened in one block
+    std::vector<std::unique_ptr<AnimChannelAngle>> angles;
+    for (int i = 0; i < 100; i++)
+    {
+        angles.push_back(std::make_unique<AnimChannelAngle>());
+        timeline.AddChannel(angles.back().get());
+    }
+
+    AnimChannelPoint point;
+    timeline.AddChannel(&point);
+
+    // Keyframes at frame 0 and frame 10, every other
+    // angle channel has no keyframes at all
+    timeline.SetCurrentTime(0);
+    for (int i = 0; i < 100; i += 2)
+    {
+        angles[i]->SetKeyframe(i);
+    }
+    point.SetKeyframe(wxPoint(0, 100));
+
+    timeline.SetCurrentTime(1);
+    for (int i = 0; i < 100; i += 2)
+    {
+        angles[i]->SetKeyframe(i + 1.0);
+    }
+    point.SetKeyframe(wxPoint(100, 0));
+
+    timeline.SetCurrentTime(0.5);
+    for (int i = 0; i < 100; i++)
+    {
+        ASSERT_NEAR(i % 2 == 0 ? i + 0.5 : 0, angles[i]->GetAngle(), 0.0001);
+    }
+    ASSERT_EQ(50, point.GetPoint().x);
+    ASSERT_EQ(50, point.GetPoint().y);
+
+    // After the last keyframe
+    timeline.SetCurrentTime(2);
+    ASSERT_NEAR(1, angles[0]->GetAngle(), 0.0001);
+    ASSERT_EQ(100, point.GetPoint().x);
+}
+
+TEST(TimelineTest, Load)
+{
+    Timeline timeline;
+
+    AnimChannelAngle angle;
+    angle.SetName(L"angle");
+    timeline.AddChannel(&angle);
+
+    AnimChannelPoint point;
+    point.SetName(L"point");
+    timeline.AddChannel(&point);
+
+    // Keyframes out of order, with frame 20 given twice
+    wxXmlNode root(wxXML_ELEMENT_NODE, L"anim");
+    root.AddAttribute(L"numframes", L"100");
+    root.AddAttribute(L"framerate", L"10");
+
+    auto channelNode = new wxXmlNode(wxXML_ELEMENT_NODE, L"channel");
+    channelNode->AddAttribute(L"name", L"angle");
+    root.AddChild(channelNode);
+    for (auto keyframe : {std::make_pair(20, L"9"), std::make_pair(0, L"1"),
+                          std::make_pair(20, L"3"), std::make_pair(10, L"2")})
+    {
+        auto keyframeNode = new wxXmlNode(wxXML_ELEMENT_NODE, L"keyframe");
+        keyframeNode->AddAttribute(L"frame", wxString::Format(wxT("%i"), keyframe.first));
+        keyframeNode->AddAttribute(L"angle", keyframe.second);
+        channelNode->AddChild(keyframeNode);
+    }
+
+    // A channel no one has is ignored
+    auto unknownNode = new wxXmlNode(wxXML_ELEMENT_NODE, L"channel");
+    unknownNode->AddAttribute(L"name", L"unknown");
+    root.AddChild(unknownNode);
+
+    timeline.Load(&root);
+
+    ASSERT_EQ(100, timeline.GetNumFrames());
+    ASSERT_EQ(3, angle.GetKeyframeCount());
+    ASSERT_EQ(0, point.GetKeyframeCount());
+
+    // Loading leaves the channels at the start of the timeline
+    ASSERT_NEAR(1, angle.GetAngle(), 0.0001);
+
+    // The later keyframe at frame 20 replaces the earlier one
+    timeline.SetCurrentTime(1.5);
+    ASSERT_NEAR(2.5, angle.GetAngle(), 0.0001);
+
+    timeline.SetCurrentTime(0.5);
+    ASSERT_NEAR(1.5, angle.GetAngle(), 0.0001);
+}
+
+TEST(TimelineTest, LoadStream)
+{
+    Timeline timeline;
+
+    AnimChannelAngle angle;
+    angle.SetName(L"Harold & Sparty");
+    timeline.AddChannel(&angle);
+
+    AnimChannelPoint point;
+    point.SetName(L"point");
+    timeline.AddChannel(&point);
+
+    const char *xml =
+            "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+            "<!-- An animation -->\n"
+            "<anim numframes=\"100\" framerate='10' MachineOneId=\"3\">\n"
+            "  <channel name=\"Harold &amp; Sparty\">\n"
+            "    <keyframe frame=\"0\" angle=\"1\"/>\n"
+            "    <keyframe frame=\"10\" angle=\"2\" />\n"
+            "  </channel>\n"
+            "  <channel name=\"unknown\"><keyframe frame=\"5\" angle=\"7\"/></channel>\n"
+            "  <channel name=\"point\"><keyframe frame=\"10\" x=\"5\" y=\"-5\"></keyframe></channel>\n"
+            "</anim>\n";
+
+    wxMemoryInputStream stream(xml, strlen(xml));
+    wxXmlNode root(wxXML_ELEMENT_NODE, L"anim");
+    ASSERT_TRUE(timeline.Load(stream, &root));
+
+    ASSERT_EQ(100, timeline.GetNumFrames());
+    ASSERT_EQ(10, timeline.GetFrameRate());
+    ASSERT_TRUE(root.GetAttribute(L"MachineOneId", L"") == L"3");
+    ASSERT_EQ(2, angle.GetKeyframeCount());
+    ASSERT_EQ(1, point.GetKeyframeCount());
+
+    timeline.SetCurrentTime(0.5);
+    ASSERT_NEAR(1.5, angle.GetAngle(), 0.0001);
+    ASSERT_EQ(5, point.GetPoint().x);
+
+    // A document that is cut off leaves the timeline as it was
+    const char *cut = "<anim numframes=\"50\"><channel name=\"point\"><keyframe frame=\"20\" x=\"7\" y=\"-7\"/>";
+    wxMemoryInputStream cutStream(cut, strlen(cut));
+    wxXmlNode cutRoot(wxXML_ELEMENT_NODE, L"anim");
+    ASSERT_FALSE(timeline.Load(cutStream, &cutRoot));
+    ASSERT_EQ(nullptr, cutRoot.GetAttributes());
+    ASSERT_EQ(100, timeline.GetNumFrames());
+    ASSERT_EQ(10, timeline.GetFrameRate());
+    ASSERT_EQ(2, angle.GetKeyframeCount());
+    ASSERT_EQ(1, point.GetKeyframeCount());
+
+    timeline.SetCurrentTime(0.5);
+    ASSERT_NEAR(1.5, angle.GetAngle(), 0.0001);
+    ASSERT_EQ(5, point.GetPoint().x);
+}
@@ -0,0 +1,119 @@
+/**
+ * @file XmlStreamReaderTest.cpp
+ * @author Frederick Fan
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+
+#include <XmlStreamReader.h>
+#include <wx/mstream.h>
+#include <cstring>
+
+/**
+ * Read a document, recording the handler calls
+ * @param xml The document
+ * @param log Receives a line for the start and end of each element
+ * @return Result of XmlStreamReader::Read
+ */
+static bool ReadLog(const char *xml, std::wstring &log)
+{
+    wxMemoryInputStream stream(xml, strlen(xml));
+    XmlStreamReader reader(stream);
+
+    reader.SetStartHandler([&log](wxXmlNode *node, int depth) {
+        log += std::to_wstring(depth) + L" <" + node->GetName().ToStdWstring();
+        for (auto attribute = node->GetAttributes(); attribute; attribute = attribute->GetNext())
+        {
+            log += L" " + attribute->GetName().ToStdWstring() + L"=" + attribute->GetValue().ToStdWstring();
+        }
+        log += L">\n";
+    });
+
+    reader.SetEndHandler([&log](const wxString &name, int depth) {
+        log += std::to_wstring(depth) + L" </" + name.ToStdWstring() + L">\n";
+    });
+
+    return reader.Read();
+}
+
+TEST(XmlStreamReaderTest, Elements)
+{
+    std::wstring log;
+    ASSERT_TRUE(ReadLog("<?xml version=\"1.0\"?>\n"
+                        "<!-- saved animation -->\n"
+                        "<anim numframes=\"300\">\n"
+                        "  <channel name='a &amp; b'>\n"
+                        "    <keyframe frame=\"1\"/>\n"
+                        "    text <![CDATA[<not an element>]]>\n"
+                        "  </channel>\n"
+                        "  <channel name=\"&#233;\"></channel>\n"
+                        "</anim>\n", log));
+
+    ASSERT_EQ(L"0 <anim numframes=300>\n"
+              L"1 <channel name=a & b>\n"
+              L"2 <keyframe frame=1>\n"
+              L"2 </keyframe>\n"
+              L"1 </channel>\n"
+              L"1 <channel name=é>\n"
+              L"1 </channel>\n"
+              L"0 </anim>\n", log);
+}
+
+TEST(XmlStreamReaderTest, Doctype)
+{
+    // The internal subset has '>' characters in it, and declares
+    // an entity and a default attribute the document uses
+    std::wstring log;
+    ASSERT_TRUE(ReadLog("<?xml version=\"1.0\"?>\n"
+                        "<!DOCTYPE anim [\n"
+                        "  <!ELEMENT anim (channel*)>\n"
+                        "  <!ATTLIST anim framerate CDATA \"30\">\n"
+                        "  <!ENTITY who \"Harold\">\n"
+                        "]>\n"
+                        "<anim><channel name=\"&who;\"/></anim>\n", log));
+
+    ASSERT_EQ(L"0 <anim framerate=30>\n"
+              L"1 <channel name=Harold>\n"
+              L"1 </channel>\n"
+              L"0 </anim>\n", log);
+}
+
+TEST(XmlStreamReaderTest, Encoding)
+{
+    // "\xe9" is an e with an acute accent in ISO-8859-1, but not valid UTF-8
+    std::wstring log;
+    ASSERT_TRUE(ReadLog("<?xml version=\"1.0\" encoding=\"ISO-8859-1\"?>\n"
+                        "<anim><channel name=\"Ren\xe9\"/></anim>", log));
+
+    ASSERT_EQ(L"0 <anim>\n"
+              L"1 <channel name=René>\n"
+              L"1 </channel>\n"
+              L"0 </anim>\n", log);
+
+    // Without a declaration, it must be UTF-8
+    ASSERT_FALSE(ReadLog("<anim><channel name=\"Ren\xe9\"/></anim>", log));
+}
+
+TEST(XmlStreamReaderTest, Invalid)
+{
+    std::wstring log;
+
+    // Mismatched end tag
+    ASSERT_FALSE(ReadLog("<anim><channel></anim></channel>", log));
+
+    // Unclosed element
+    ASSERT_FALSE(ReadLog("<anim><channel>", log));
+
+    // Two root elements
+    ASSERT_FALSE(ReadLog("<anim/><anim/>", log));
+
+    // Unquoted attribute
+    ASSERT_FALSE(ReadLog("<anim numframes=300/>", log));
+
+    // Undeclared entity
+    ASSERT_FALSE(ReadLog("<anim name=\"&who;\"/>", log));
+
+    // No root element at all
+    ASSERT_FALSE(ReadLog("", log));
+}